@@ -0,0 +1,39 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace ParteeEngine {
+
+    // A named measurement program. Each bench/*.cpp registers its own with a static
+    // BenchmarkRegistration; bench/main.cpp runs them.
+    struct Benchmark {
+        const char* name;
+        void (*run)();
+    };
+
+    std::vector<Benchmark>& getBenchmarks();
+
+    struct BenchmarkRegistration {
+        BenchmarkRegistration(const char* name, void (*run)()) { getBenchmarks().push_back({name, run}); }
+    };
+
+    // Heap allocations made by the process so far; operator new is counted in main.cpp.
+    size_t getAllocationCount();
+
+    // Fastest of runs calls of fn, in milliseconds.
+    template <typename Fn>
+    double measureMs(int runs, Fn&& fn) {
+        double best = 0.0;
+        for (int i = 0; i < runs; ++i) {
+            auto begin = std::chrono::steady_clock::now();
+            fn();
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+            best = i == 0 ? ms : std::min(best, ms);
+        }
+        return best;
+    }
+
+}
@@ -0,0 +1,81 @@
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "Bench.hpp"
+#include "jobs/ThreadPool.hpp"
+#include "physics/Broadphase.hpp"
+
+// Broadphase update time over a sweep of collider counts and scene densities, for both
+// broadphases. Colliders are unit-ish boxes nudged a little every step, as moving bodies are.
+
+namespace ParteeEngine {
+
+    namespace {
+
+        enum class Scene { Uniform, Clustered };
+
+        // count boxes with about density boxes per cubic unit, spread evenly or in 32 tight clusters.
+        std::vector<Aabb> makeScene(Scene scene, size_t count, float density, std::mt19937& rng) {
+            float extent = std::cbrt(count / density);
+            std::uniform_real_distribution<float> size(0.25f, 0.75f);
+            std::uniform_real_distribution<float> uniform(0.0f, extent);
+            std::normal_distribution<float> spread(0.0f, extent * 0.05f);
+
+            std::vector<Vector3> clusters(32);
+            for (Vector3& cluster : clusters) cluster = Vector3(uniform(rng), uniform(rng), uniform(rng));
+
+            std::vector<Aabb> bounds(count);
+            for (size_t i = 0; i < count; ++i) {
+                Vector3 center = scene == Scene::Uniform
+                    ? Vector3(uniform(rng), uniform(rng), uniform(rng))
+                    : clusters[i % clusters.size()] + Vector3(spread(rng), spread(rng), spread(rng));
+                Vector3 half(size(rng), size(rng), size(rng));
+                bounds[i] = Aabb(center - half, center + half);
+            }
+            return bounds;
+        }
+
+        void run() {
+            ThreadPool jobs;
+            std::printf("%u threads, milliseconds per step (average of 10 after a warm-up step)\n",
+                        static_cast<unsigned>(jobs.getConcurrency()));
+            std::printf("%-10s %8s %8s %10s %12s %14s\n", "scene", "count", "density", "pairs", "SpatialHash", "SweepAndPrune");
+
+            std::mt19937 rng(7);
+            std::uniform_real_distribution<float> nudge(-0.02f, 0.02f);
+            for (Scene scene : {Scene::Uniform, Scene::Clustered}) {
+                for (size_t count : {10000u, 30000u, 100000u}) {
+                    for (float density : {0.01f, 0.1f, 0.3f}) {
+                        std::vector<Aabb> bounds = makeScene(scene, count, density, rng);
+
+                        double ms[2];
+                        size_t pairs = 0;
+                        for (BroadphaseType type : {BroadphaseType::SpatialHash, BroadphaseType::SweepAndPrune}) {
+                            std::unique_ptr<Broadphase> broadphase = createBroadphase(type);
+                            std::vector<Aabb> moving = bounds;
+                            broadphase->update(moving.data(), moving.size(), &jobs);
+
+                            double total = 0.0;
+                            for (int step = 0; step < 10; ++step) {
+                                for (Aabb& box : moving) {
+                                    Vector3 delta(nudge(rng), nudge(rng), nudge(rng));
+                                    box = Aabb(box.min + delta, box.max + delta);
+                                }
+                                total += measureMs(1, [&] { broadphase->update(moving.data(), moving.size(), &jobs); });
+                            }
+                            ms[type == BroadphaseType::SpatialHash ? 0 : 1] = total / 10.0;
+                            pairs = broadphase->getPairs().size();
+                        }
+                        std::printf("%-10s %8zu %8.2f %10zu %12.2f %14.2f\n", scene == Scene::Uniform ? "uniform" : "clustered",
+                                    count, density, pairs, ms[0], ms[1]);
+                    }
+                }
+            }
+        }
+
+        BenchmarkRegistration registration("broadphase", run);
+
+    }
+
+}
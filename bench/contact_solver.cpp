@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "Bench.hpp"
+#include "Entity.hpp"
+#include "ecs/TransformHierarchy.hpp"
+#include "ecs/View.hpp"
+#include "jobs/ThreadPool.hpp"
+#include "physics/CollisionWorld.hpp"
+#include "physics/PhysicsWorld.hpp"
+#include "components/ColliderComponent.hpp"
+#include "components/PhysicsComponent.hpp"
+#include "components/TransformComponent.hpp"
+
+// A 20x20x4 block of 1600 boxes settling on the ground for five seconds at 60 Hz, with and
+// without sleeping. Reports how far the boxes ended up from their rest positions and the
+// physics and collision step times of the last second, once the block is at rest.
+
+namespace ParteeEngine {
+
+    namespace {
+
+        constexpr float Step = 1.0f / 60.0f;
+        constexpr int Ticks = 300;
+        constexpr int MeasuredTicks = 60;
+
+        struct Scene {
+            World world;
+            PhysicsWorld physics;
+            CollisionWorld collisions;
+            TransformHierarchy hierarchy;
+            ThreadPool jobs;
+            std::vector<Entity> boxes;
+            std::vector<Vector3> restPositions;
+
+            Scene() {
+                world.setResource(&physics);
+                physics.setGravity(Vector3(0.0f, -9.8f, 0.0f));
+                addBox(Vector3(0.0f, -0.5f, 0.0f), Vector3(100.0f, 0.5f, 100.0f));
+                for (int x = 0; x < 20; ++x) {
+                    for (int z = 0; z < 20; ++z) {
+                        for (int y = 0; y < 4; ++y) {
+                            Entity box = addBox(Vector3(x * 1.0f, 0.5f + y, z * 1.0f), Vector3(0.5f, 0.5f, 0.5f));
+                            box.addComponent<PhysicsComponent>();
+                            boxes.push_back(box);
+                            restPositions.push_back(box.getComponent<TransformComponent>()->getPosition());
+                        }
+                    }
+                }
+            }
+
+            Entity addBox(const Vector3& position, const Vector3& halfExtents) {
+                Entity entity(world, world.createEntity());
+                entity.addComponent<ColliderComponent>().setBox(halfExtents);
+                entity.getComponent<TransformComponent>()->setPosition(position);
+                return entity;
+            }
+
+            size_t getAwakeCount() {
+                size_t awake = 0;
+                for (Entity& box : boxes) awake += physics.isAwake(box.getComponent<PhysicsComponent>()->getBody());
+                return awake;
+            }
+
+            float getRestError() {
+                float error = 0.0f;
+                for (size_t i = 0; i < boxes.size(); ++i) {
+                    Vector3 offset = boxes[i].getComponent<TransformComponent>()->getPosition() - restPositions[i];
+                    error = std::max(error, std::sqrt(offset.dot(offset)));
+                }
+                return error;
+            }
+        };
+
+        void simulate(bool sleeping) {
+            Scene scene;
+            scene.physics.setSleepEnabled(sleeping);
+            double physicsMs = 0.0, collisionMs = 0.0;
+            for (int tick = 0; tick < Ticks; ++tick) {
+                makeView<TransformComponent>(scene.world).each([](TransformComponent& transform) { transform.storePreviousState(); });
+                double physics = measureMs(1, [&] { scene.physics.step(scene.world, scene.jobs, Step, scene.collisions); });
+                double collisions = measureMs(1, [&] { scene.collisions.step(scene.world, scene.jobs, scene.hierarchy); });
+                if (tick >= Ticks - MeasuredTicks) {
+                    physicsMs += physics / MeasuredTicks;
+                    collisionMs += collisions / MeasuredTicks;
+                }
+            }
+            std::printf("sleeping %-3s  awake %4zu/%zu  max rest error %.3f m  physics %6.2f ms  collisions %6.2f ms per tick\n",
+                        sleeping ? "on" : "off", scene.getAwakeCount(), scene.boxes.size(), scene.getRestError(), physicsMs, collisionMs);
+        }
+
+        void run() {
+            simulate(false);
+            simulate(true);
+        }
+
+        BenchmarkRegistration registration("contact_solver", run);
+
+    }
+
+}
@@ -0,0 +1,134 @@
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <random>
+#include <typeindex>
+#include <unordered_map>
+
+#include "Bench.hpp"
+#include "Entity.hpp"
+#include "components/ColliderComponent.hpp"
+#include "components/PhysicsComponent.hpp"
+#include "components/RenderComponent.hpp"
+#include "components/TransformComponent.hpp"
+#include "events/EventBus.hpp"
+
+// Component and event-subscriber lookups per second, before and after type family ids.
+// "Before" rebuilds the original storage in place: every entity held its components in an
+// std::unordered_map keyed by std::type_index(typeid(T)), and the EventBus kept its
+// subscribers the same way.
+
+namespace ParteeEngine {
+
+    namespace {
+
+        struct LegacyEntity {
+            std::unordered_map<std::type_index, std::unique_ptr<Component>> components;
+
+            template <typename T>
+            T* getComponent() {
+                auto it = components.find(std::type_index(typeid(T)));
+                return it != components.end() ? static_cast<T*>(it->second.get()) : nullptr;
+            }
+
+            template <typename T>
+            bool hasComponent() const {
+                return components.count(std::type_index(typeid(T))) > 0;
+            }
+        };
+
+        struct LegacyEventBus {
+            std::unordered_map<std::type_index, std::vector<std::function<void(const void*)>>> subscribers;
+
+            template <typename T>
+            void emit(const T& e) {
+                auto it = subscribers.find(std::type_index(typeid(T)));
+                if (it == subscribers.end()) return;
+                for (auto& fn : it->second) fn(&e);
+            }
+        };
+
+        struct Ping {
+            uint32_t value;
+        };
+
+        constexpr size_t EntityCount = 100000;
+        constexpr size_t LookupCount = 10000000;
+
+        void report(const char* what, double beforeMs, double afterMs, size_t count) {
+            double before = count / (beforeMs * 1e3);
+            double after = count / (afterMs * 1e3);
+            std::printf("%-28s %10.1f %10.1f %8.1fx\n", what, before, after, after / before);
+        }
+
+        void run() {
+            // Entities with a transform, render and collider component but no physics body
+            World world;
+            std::vector<EntityHandle> handles;
+            std::vector<LegacyEntity> legacy(EntityCount);
+            for (size_t i = 0; i < EntityCount; ++i) {
+                Entity entity(world, world.createEntity());
+                entity.addComponent<RenderComponent>();
+                entity.addComponent<ColliderComponent>();
+                handles.push_back(entity.getID());
+
+                legacy[i].components[typeid(TransformComponent)] = std::make_unique<TransformComponent>();
+                legacy[i].components[typeid(RenderComponent)] = std::make_unique<RenderComponent>();
+                legacy[i].components[typeid(ColliderComponent)] = std::make_unique<ColliderComponent>();
+            }
+
+            std::mt19937 rng(3);
+            std::uniform_int_distribution<uint32_t> pick(0, EntityCount - 1);
+            std::vector<uint32_t> order(LookupCount);
+            for (uint32_t& index : order) index = pick(rng);
+
+            std::printf("%zu lookups over %zu entities in random order, million lookups per second\n", LookupCount, EntityCount);
+            std::printf("%-28s %10s %10s %9s\n", "", "before", "after", "speedup");
+
+            volatile uintptr_t sink = 0;
+            double before = measureMs(3, [&] {
+                uintptr_t sum = 0;
+                for (uint32_t index : order) sum += reinterpret_cast<uintptr_t>(legacy[index].getComponent<TransformComponent>());
+                sink = sum;
+            });
+            double after = measureMs(3, [&] {
+                uintptr_t sum = 0;
+                for (uint32_t index : order) sum += reinterpret_cast<uintptr_t>(world.getComponent<TransformComponent>(handles[index]));
+                sink = sum;
+            });
+            report("getComponent (present)", before, after, LookupCount);
+
+            before = measureMs(3, [&] {
+                size_t count = 0;
+                for (uint32_t index : order) count += legacy[index].hasComponent<PhysicsComponent>();
+                sink = count;
+            });
+            after = measureMs(3, [&] {
+                size_t count = 0;
+                for (uint32_t index : order) count += world.hasComponent<PhysicsComponent>(handles[index]);
+                sink = count;
+            });
+            report("hasComponent (absent)", before, after, LookupCount);
+
+            // Immediate delivery to one subscriber: the lookup dominates
+            uint64_t received = 0;
+            LegacyEventBus legacyBus;
+            legacyBus.subscribers[typeid(Ping)].push_back([&](const void* e) { received += static_cast<const Ping*>(e)->value; });
+            EventBus bus;
+            bus.subscribe<Ping>([&](const Ping& e) { received += e.value; });
+
+            before = measureMs(3, [&] {
+                for (uint32_t i = 0; i < LookupCount; ++i) legacyBus.emit(Ping{i});
+            });
+            after = measureMs(3, [&] {
+                for (uint32_t i = 0; i < LookupCount; ++i) bus.emit(Ping{i});
+            });
+            sink = received;
+            report("EventBus::emit", before, after, LookupCount);
+        }
+
+        BenchmarkRegistration registration("ecs_lookup", run);
+
+    }
+
+}
@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <cstdio>
+
+#include "Bench.hpp"
+#include "events/EventBus.hpp"
+
+// A storm of 1M small events per frame. Deferred events are copied into their ring buffer
+// by emit() and handed to a batch subscriber by dispatch(); immediate events call their
+// subscriber from emit(), as every event type did before the ring buffers. Heap
+// allocations are counted per frame after the first, which grows the ring.
+
+namespace ParteeEngine {
+
+    namespace {
+
+        constexpr uint32_t EventCount = 1000000;
+        constexpr int Frames = 5;
+
+        struct DeferredHit {
+            uint32_t first;
+            uint32_t second;
+            float depth;
+        };
+
+        struct ImmediateHit {
+            uint32_t first;
+            uint32_t second;
+            float depth;
+        };
+
+        void run() {
+            EventBus bus;
+            double depthSum = 0.0;
+            bus.subscribeBatch<DeferredHit>([&](Span<const DeferredHit> hits) {
+                for (const DeferredHit& hit : hits) depthSum += hit.depth;
+            });
+            bus.subscribe<ImmediateHit>([&](const ImmediateHit& hit) { depthSum += hit.depth; });
+            bus.setDeferred<DeferredHit>(64);
+
+            double emitMs = 0.0, dispatchMs = 0.0, immediateMs = 0.0;
+            size_t allocations = 0;
+            for (int frame = 0; frame < Frames; ++frame) {
+                size_t allocationsBefore = getAllocationCount();
+                double emit = measureMs(1, [&] {
+                    for (uint32_t i = 0; i < EventCount; ++i) bus.emit(DeferredHit{i, i + 1, 0.5f});
+                });
+                double dispatch = measureMs(1, [&] { bus.dispatch(); });
+                if (frame > 0) allocations += getAllocationCount() - allocationsBefore;
+                double immediate = measureMs(1, [&] {
+                    for (uint32_t i = 0; i < EventCount; ++i) bus.emit(ImmediateHit{i, i + 1, 0.5f});
+                });
+                emitMs = frame == 0 ? emit : std::min(emitMs, emit);
+                dispatchMs = frame == 0 ? dispatch : std::min(dispatchMs, dispatch);
+                immediateMs = frame == 0 ? immediate : std::min(immediateMs, immediate);
+            }
+
+            std::printf("%u events per frame, %d frames\n", EventCount, Frames);
+            std::printf("immediate emit            %8.2f ms\n", immediateMs);
+            std::printf("deferred emit             %8.2f ms\n", emitMs);
+            std::printf("deferred batch dispatch   %8.2f ms\n", dispatchMs);
+            std::printf("allocations after frame 1 %8zu (checksum %.0f)\n", allocations, depthSum);
+        }
+
+        BenchmarkRegistration registration("event_queue", run);
+
+    }
+
+}
@@ -0,0 +1,81 @@
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "Bench.hpp"
+#include "Entity.hpp"
+#include "Frustum.hpp"
+#include "InstanceBuffer.hpp"
+#include "ecs/View.hpp"
+#include "jobs/ThreadPool.hpp"
+#include "platform/NullRenderContext.hpp"
+
+// InstanceBuffer::build over 200k randomly transformed squares and cubes, with and without
+// the camera frustum. Also checks that no instance with a vertex inside clip space was culled.
+
+namespace ParteeEngine {
+
+    namespace {
+
+        constexpr int InstanceCount = 200000;
+
+        // Instances with at least one mesh vertex inside clip space
+        size_t countVertexVisible(const InstanceBuffer& buffer, const Matrix4& viewProjection) {
+            size_t visible = 0;
+            for (const InstanceGroup& group : buffer.getGroups()) {
+                for (const InstanceData& instance : group.instances) {
+                    for (const RenderVertex& vertex : group.mesh->vertices) {
+                        Vector4 clip = viewProjection * Vector4(instance.model.transformPoint(vertex.position), 1.0f);
+                        if (clip.w > 0.0f && std::fabs(clip.x) <= clip.w && std::fabs(clip.y) <= clip.w && std::fabs(clip.z) <= clip.w) {
+                            ++visible;
+                            break;
+                        }
+                    }
+                }
+            }
+            return visible;
+        }
+
+        void run() {
+            World world;
+            TransformHierarchy hierarchy;
+            ThreadPool jobs;
+            InstanceBuffer buffer;
+
+            std::mt19937 rng(3);
+            std::uniform_real_distribution<float> position(-200.0f, 200.0f), angle(0.0f, 360.0f), size(0.2f, 4.0f);
+            for (int i = 0; i < InstanceCount; ++i) {
+                Entity entity(world, world.createEntity());
+                entity.addComponent<RenderComponent>().type = i % 2 ? RenderComponent::CUBE : RenderComponent::SQUARE;
+                auto* transform = entity.getComponent<TransformComponent>();
+                transform->setPosition(position(rng), position(rng) * 0.3f, position(rng));
+                transform->setRotation(angle(rng), angle(rng), angle(rng));
+                transform->setScale(size(rng), size(rng), size(rng));
+            }
+            makeView<TransformComponent>(world).each([](TransformComponent& transform) { transform.updateLocalMatrix(1.0f); });
+
+            NullRenderContext context;
+            context.initialize(800, 600);
+            context.setCamera(Vector3(10.0f, 5.0f, 30.0f), Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f));
+            context.setPerspective(60.0f, 4.0f / 3.0f, 0.1f, 150.0f);
+            RenderView view;
+            Frustum frustum = Frustum::fromCamera(context);
+            view.frustum = &frustum;
+
+            double unculledMs = measureMs(5, [&] { buffer.build(makeView<RenderComponent, TransformComponent>(world), jobs, hierarchy); });
+            size_t vertexVisible = countVertexVisible(buffer, context.getViewProjection());
+            double culledMs = measureMs(5, [&] { buffer.build(makeView<RenderComponent, TransformComponent>(world), jobs, hierarchy, view); });
+            size_t kept = countVertexVisible(buffer, context.getViewProjection());
+
+            const CullStats& stats = buffer.getCullStats();
+            std::printf("%zu instances, %zu kept by the frustum, %zu with a vertex in clip space, %zu of them culled\n",
+                        stats.total, stats.visible, vertexVisible, vertexVisible - kept);
+            std::printf("build without culling %8.2f ms\n", unculledMs);
+            std::printf("build with culling    %8.2f ms\n", culledMs);
+        }
+
+        BenchmarkRegistration registration("frustum_culling", run);
+
+    }
+
+}
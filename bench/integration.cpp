@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "Bench.hpp"
+#include "Entity.hpp"
+#include "components/TransformComponent.hpp"
+#include "jobs/ThreadPool.hpp"
+#include "physics/PhysicsWorld.hpp"
+
+// Body updates per second over 1M bodies. "Before" rebuilds the original per-entity path:
+// a virtual update per PhysicsComponent that adds its acceleration to its velocity and
+// looks up the entity's TransformComponent to translate it. "After" is
+// PhysicsWorld::integrate for each integrator, on the calling thread and on the pool.
+
+namespace ParteeEngine {
+
+    namespace {
+
+        constexpr uint32_t BodyCount = 1000000;
+        constexpr float Step = 1.0f / 60.0f;
+
+        struct LegacyPhysicsComponent {
+            Vector3 velocity;
+            Vector3 acceleration;
+
+            virtual ~LegacyPhysicsComponent() = default;
+
+            virtual void update(Entity& owner, float dt) {
+                velocity += acceleration * dt;
+                owner.getComponent<TransformComponent>()->translate(velocity * dt);
+            }
+        };
+
+        void report(const char* what, double ms) {
+            std::printf("%-42s %8.2f ms %8.1f M bodies/s\n", what, ms, BodyCount / (ms * 1e3));
+        }
+
+        void run() {
+            {
+                World world;
+                std::vector<EntityHandle> handles;
+                std::vector<std::unique_ptr<LegacyPhysicsComponent>> legacy;
+                for (uint32_t i = 0; i < BodyCount; ++i) {
+                    Entity entity(world, world.createEntity());
+                    entity.addComponent<TransformComponent>();
+                    handles.push_back(entity.getID());
+                    legacy.push_back(std::make_unique<LegacyPhysicsComponent>());
+                    legacy.back()->velocity = Vector3(i % 7, 1.0f, 2.0f);
+                    legacy.back()->acceleration = Vector3(0.0f, -9.8f, 0.0f);
+                }
+                report("before: virtual update per entity", measureMs(5, [&] {
+                    for (uint32_t i = 0; i < BodyCount; ++i) {
+                        Entity owner(world, handles[i]);
+                        legacy[i]->update(owner, Step);
+                    }
+                }));
+            }
+
+            // A third of the bodies get a force each step, as applyForce would add
+            PhysicsWorld physics;
+            physics.setGravity(Vector3(0.0f, -9.8f, 0.0f));
+            for (uint32_t i = 0; i < BodyCount; ++i) physics.setVelocity(physics.createBody(EntityHandle(i, 0)), Vector3(i % 7, 1.0f, 2.0f));
+            auto addForces = [&] {
+                for (uint32_t i = 0; i < BodyCount; i += 3) physics.addForce(i, Vector3(1.0f, 2.0f, 3.0f));
+            };
+
+            ThreadPool jobs;
+            for (IntegratorType integrator : {IntegratorType::SemiImplicitEuler, IntegratorType::Verlet}) {
+                const char* name = integrator == IntegratorType::Verlet ? "Verlet" : "semi-implicit Euler";
+                physics.setIntegrator(integrator);
+                double serial = 0.0, parallel = 0.0;
+                for (int i = 0; i < 10; ++i) {
+                    addForces();
+                    double ms = measureMs(1, [&] { physics.integrate(Step, nullptr); });
+                    serial = i == 0 ? ms : std::min(serial, ms);
+                    addForces();
+                    ms = measureMs(1, [&] { physics.integrate(Step, &jobs); });
+                    parallel = i == 0 ? ms : std::min(parallel, ms);
+                }
+                char label[64];
+                std::snprintf(label, sizeof(label), "after: %s", name);
+                report(label, serial);
+                std::snprintf(label, sizeof(label), "after: %s, %zu threads", name, jobs.getConcurrency());
+                report(label, parallel);
+            }
+        }
+
+        BenchmarkRegistration registration("integration", run);
+
+    }
+
+}
@@ -0,0 +1,92 @@
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Bench.hpp"
+#include "Entity.hpp"
+#include "InstanceBuffer.hpp"
+#include "ecs/View.hpp"
+#include "jobs/ThreadPool.hpp"
+#include "math/Simd.hpp"
+
+// A crowd of 50k models with three levels of detail (1200, 120 and 12 triangles) spread
+// over a 600 m square around the camera. Compares the triangles drawn and the
+// InstanceBuffer::build time with and without level selection, then counts the level
+// switches while the camera jitters by 5 cm, with and without hysteresis.
+
+namespace ParteeEngine {
+
+    namespace {
+
+        constexpr int ModelCount = 50000;
+        constexpr int JitterFrames = 100;
+
+        // n copies of the unit cube, standing in for a detailed model
+        Mesh makeDenseMesh(int copies) {
+            Mesh mesh;
+            for (int i = 0; i < copies; ++i) {
+                for (const RenderVertex& vertex : Mesh::unitCube().vertices) mesh.vertices.push_back(vertex);
+            }
+            mesh.computeBounds();
+            return mesh;
+        }
+
+        size_t countSwitches(World& world, InstanceBuffer& buffer, ThreadPool& jobs, const TransformHierarchy& hierarchy, RenderView camera) {
+            std::vector<size_t> levels;
+            makeView<RenderComponent>(world).each([&](RenderComponent& render) { levels.push_back(render.lodLevel); });
+            size_t switches = 0;
+            for (int frame = 0; frame < JitterFrames; ++frame) {
+                camera.cameraPosition = Vector3(0.05f * (frame & 1), 2.0f, 0.0f);
+                buffer.build(makeView<RenderComponent, TransformComponent>(world), jobs, hierarchy, camera);
+                size_t i = 0;
+                makeView<RenderComponent>(world).each([&](RenderComponent& render) {
+                    switches += render.lodLevel != levels[i];
+                    levels[i++] = render.lodLevel;
+                });
+            }
+            return switches;
+        }
+
+        void run() {
+            World world;
+            TransformHierarchy hierarchy;
+            ThreadPool jobs;
+            InstanceBuffer buffer;
+
+            Mesh detailed = makeDenseMesh(100), simplified = makeDenseMesh(10);
+            LodChain chain;
+            chain.levels = {{&detailed, 0.2f}, {&simplified, 0.05f}, {&Mesh::unitCube(), 0.005f}};
+
+            std::mt19937 rng(3);
+            std::uniform_real_distribution<float> position(-300.0f, 300.0f);
+            for (int i = 0; i < ModelCount; ++i) {
+                Entity entity(world, world.createEntity());
+                entity.addComponent<RenderComponent>().lod = &chain;
+                entity.getComponent<TransformComponent>()->setPosition(position(rng), 0.0f, position(rng));
+            }
+            makeView<TransformComponent>(world).each([](TransformComponent& transform) { transform.updateLocalMatrix(1.0f); });
+
+            RenderView camera;
+            double fullMs = measureMs(5, [&] { buffer.build(makeView<RenderComponent, TransformComponent>(world), jobs, hierarchy, camera); });
+            size_t fullTriangles = buffer.getCullStats().triangles;
+
+            camera.cameraPosition = Vector3(0.0f, 2.0f, 0.0f);
+            camera.projectionScale = 1.0f / std::tan(30.0f * Pi / 180.0f);
+            double lodMs = measureMs(5, [&] { buffer.build(makeView<RenderComponent, TransformComponent>(world), jobs, hierarchy, camera); });
+            const CullStats& stats = buffer.getCullStats();
+            std::printf("%d models, %zu drawn\n", ModelCount, stats.visible);
+            std::printf("full detail          %10zu triangles, build %6.2f ms\n", fullTriangles, fullMs);
+            std::printf("levels of detail     %10zu triangles, build %6.2f ms\n", stats.triangles, lodMs);
+
+            size_t withHysteresis = countSwitches(world, buffer, jobs, hierarchy, camera);
+            camera.lodHysteresis = 0.0f;
+            size_t withoutHysteresis = countSwitches(world, buffer, jobs, hierarchy, camera);
+            std::printf("level switches over %d jittered frames: %zu with hysteresis, %zu without\n", JitterFrames, withHysteresis, withoutHysteresis);
+        }
+
+        BenchmarkRegistration registration("level_of_detail", run);
+
+    }
+
+}
@@ -0,0 +1,67 @@
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "Bench.hpp"
+
+namespace {
+    std::atomic<size_t> allocations{0};
+}
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace ParteeEngine {
+
+    std::vector<Benchmark>& getBenchmarks() {
+        static std::vector<Benchmark> benchmarks;
+        return benchmarks;
+    }
+
+    size_t getAllocationCount() {
+        return allocations.load(std::memory_order_relaxed);
+    }
+
+}
+
+// Runs every benchmark, or only the ones named on the command line.
+int main(int argc, char** argv) {
+    std::vector<ParteeEngine::Benchmark>& benchmarks = ParteeEngine::getBenchmarks();
+    std::sort(benchmarks.begin(), benchmarks.end(), [](const auto& a, const auto& b) { return std::strcmp(a.name, b.name) < 0; });
+
+    if (argc > 1 && std::strcmp(argv[1], "--list") == 0) {
+        for (const ParteeEngine::Benchmark& benchmark : benchmarks) std::printf("%s\n", benchmark.name);
+        return 0;
+    }
+
+    int failed = 0;
+    for (int i = 1; i < argc; ++i) {
+        bool found = false;
+        for (const ParteeEngine::Benchmark& benchmark : benchmarks) found = found || std::strcmp(argv[i], benchmark.name) == 0;
+        if (!found) {
+            std::fprintf(stderr, "Unknown benchmark %s (see --list)\n", argv[i]);
+            failed = 1;
+        }
+    }
+    if (failed) return 1;
+
+    for (const ParteeEngine::Benchmark& benchmark : benchmarks) {
+        bool selected = argc == 1;
+        for (int i = 1; i < argc; ++i) selected = selected || std::strcmp(argv[i], benchmark.name) == 0;
+        if (!selected) continue;
+
+        std::printf("== %s\n", benchmark.name);
+        std::fflush(stdout);
+        benchmark.run();
+        std::printf("\n");
+    }
+    return 0;
+}
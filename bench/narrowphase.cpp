@@ -0,0 +1,115 @@
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Bench.hpp"
+#include "jobs/ThreadPool.hpp"
+#include "physics/Narrowphase.hpp"
+
+// Narrowphase::collide over 100k candidate pairs of mixed spheres, AABBs and oriented
+// boxes, against a scalar separating axis test run one pair at a time, which also checks
+// that both agree on which pairs touch.
+
+namespace ParteeEngine {
+
+    namespace {
+
+        constexpr uint32_t PairCount = 100000;
+
+        float getHalfExtent(const ColliderShape& shape, int axis) {
+            return axis == 0 ? shape.halfExtents.x : axis == 1 ? shape.halfExtents.y : shape.halfExtents.z;
+        }
+
+        void project(const ColliderShape& shape, const Vector3& axis, float& low, float& high) {
+            float center = shape.center.dot(axis);
+            float radius = 0.0f;
+            if (shape.type == ShapeType::Sphere) {
+                radius = shape.radius;
+            } else {
+                for (int i = 0; i < 3; ++i) radius += getHalfExtent(shape, i) * std::fabs(shape.axes[i].dot(axis));
+            }
+            low = center - radius;
+            high = center + radius;
+        }
+
+        bool overlapsScalar(const ColliderShape& a, const ColliderShape& b) {
+            if (a.type == ShapeType::Sphere) return b.distanceTo(a.center) <= a.radius;
+            if (b.type == ShapeType::Sphere) return a.distanceTo(b.center) <= b.radius;
+            Vector3 axes[15];
+            int count = 0;
+            for (int i = 0; i < 3; ++i) axes[count++] = a.axes[i];
+            for (int i = 0; i < 3; ++i) axes[count++] = b.axes[i];
+            for (int i = 0; i < 3; ++i) {
+                for (int j = 0; j < 3; ++j) {
+                    Vector3 cross = a.axes[i].cross(b.axes[j]);
+                    if (cross.dot(cross) > 1e-6f) axes[count++] = cross.normalize();
+                }
+            }
+            for (int i = 0; i < count; ++i) {
+                float lowA, highA, lowB, highB;
+                project(a, axes[i], lowA, highA);
+                project(b, axes[i], lowB, highB);
+                if (highA < lowB || highB < lowA) return false;
+            }
+            return true;
+        }
+
+        ColliderShape makeShape(std::mt19937& rng) {
+            std::uniform_real_distribution<float> position(0.0f, 100.0f), size(0.2f, 1.0f);
+            std::normal_distribution<float> gaussian;
+            ColliderShape shape;
+            shape.center = Vector3(position(rng), position(rng), position(rng));
+            int type = rng() % 3;
+            if (type == 0) {
+                shape.type = ShapeType::Sphere;
+                shape.radius = size(rng);
+                return shape;
+            }
+            shape.type = type == 1 ? ShapeType::AABB : ShapeType::Box;
+            shape.halfExtents = Vector3(size(rng), size(rng), size(rng));
+            if (type == 2) {
+                Vector3 x = Vector3(gaussian(rng), gaussian(rng), gaussian(rng)).normalize();
+                Vector3 y = Vector3(gaussian(rng), gaussian(rng), gaussian(rng)).cross(x).normalize();
+                shape.axes[0] = x;
+                shape.axes[1] = y;
+                shape.axes[2] = x.cross(y);
+            }
+            return shape;
+        }
+
+        void run() {
+            // Each pair's second shape sits next to its first, so about half of them touch
+            std::mt19937 rng(7);
+            std::vector<ColliderShape> shapes;
+            std::vector<EntityHandle> entities;
+            for (uint32_t i = 0; i < PairCount; ++i) {
+                shapes.push_back(makeShape(rng));
+                entities.push_back(EntityHandle(i, 1));
+            }
+            std::vector<BroadphasePair> pairs;
+            for (uint32_t i = 0; i + 1 < PairCount; ++i) pairs.push_back({i, (i * 7919 + 1) % PairCount});
+            for (const BroadphasePair& pair : pairs) shapes[pair.second].center = shapes[pair.first].center + Vector3(0.8f, 0.3f, 0.1f);
+
+            size_t touching = 0;
+            double scalarMs = measureMs(3, [&] {
+                touching = 0;
+                for (const BroadphasePair& pair : pairs) touching += overlapsScalar(shapes[pair.first], shapes[pair.second]);
+            });
+
+            ThreadPool jobs;
+            Narrowphase serial, parallel;
+            double serialMs = measureMs(3, [&] { serial.collide(shapes.data(), entities.data(), pairs, nullptr); });
+            double parallelMs = measureMs(3, [&] { parallel.collide(shapes.data(), entities.data(), pairs, &jobs); });
+
+            std::printf("%zu pairs, %zu touching by scalar SAT, %zu manifolds\n", pairs.size(), touching, serial.getManifolds().size());
+            std::printf("scalar SAT, overlap only            %8.2f ms\n", scalarMs);
+            std::printf("narrowphase on the calling thread   %8.2f ms\n", serialMs);
+            std::printf("narrowphase on the pool (%zu threads) %8.2f ms\n", jobs.getConcurrency(), parallelMs);
+        }
+
+        BenchmarkRegistration registration("narrowphase", run);
+
+    }
+
+}
@@ -0,0 +1,73 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+#include "Bench.hpp"
+#include "ObjLoader.hpp"
+#include "jobs/ThreadPool.hpp"
+
+// loadObj() on a generated multi-million-triangle OBJ, on the calling thread and on the pool.
+
+namespace ParteeEngine {
+
+    namespace {
+
+        // A grid of quads with texture coordinates, normals and a material change every 100
+        // rows, written the way exporters do.
+        void writeGrid(const std::filesystem::path& path, int size) {
+            std::ofstream mtl(path.parent_path() / "bench_grid.mtl");
+            mtl << "newmtl red\nKd 1 0 0\n\nnewmtl blue\nKd 0 0 1\n";
+
+            std::ofstream obj(path);
+            char line[128];
+            obj << "mtllib bench_grid.mtl\n";
+            for (int y = 0; y < size; ++y) {
+                for (int x = 0; x < size; ++x) {
+                    std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\n", x * 0.01f, y * 0.01f, ((x * 7 + y * 13) % 17) * 0.001f);
+                    obj << line;
+                }
+            }
+            for (int y = 0; y < size; ++y) {
+                std::snprintf(line, sizeof(line), "vt %.6f 0.5\n", y / static_cast<float>(size));
+                obj << line;
+            }
+            obj << "vn 0 0 1\n";
+            for (int y = 0; y + 1 < size; ++y) {
+                if (y % 100 == 0) obj << ((y / 100) % 2 ? "usemtl blue\n" : "usemtl red\n");
+                for (int x = 0; x + 1 < size; ++x) {
+                    int a = y * size + x + 1;
+                    std::snprintf(line, sizeof(line), "f %d/%d/1 %d/%d/1 %d/%d/1 %d/%d/1\n",
+                                  a, y + 1, a + 1, y + 1, a + size + 1, y + 1, a + size, y + 1);
+                    obj << line;
+                }
+            }
+        }
+
+        void run() {
+            std::filesystem::path path = std::filesystem::temp_directory_path() / "bench_grid.obj";
+            const int size = 1201;
+            writeGrid(path, size);
+            double megabytes = std::filesystem::file_size(path) / (1024.0 * 1024.0);
+
+            ThreadPool jobs;
+            Mesh mesh;
+            double serial = measureMs(3, [&] { mesh = loadObj(path.string()); });
+            std::vector<uint32_t> serialIndices = mesh.indices;
+            size_t serialVertices = mesh.vertices.size();
+            double parallel = measureMs(3, [&] { mesh = loadObj(path.string(), &jobs); });
+
+            std::printf("%.1f MB OBJ: %zu triangles, %zu vertices after deduplication\n", megabytes, mesh.indices.size() / 3, mesh.vertices.size());
+            std::printf("serial               %8.1f ms  %6.1f M triangles/s\n", serial, mesh.indices.size() / 3 / (serial * 1e3));
+            std::printf("parallel (%u threads) %8.1f ms  %6.1f M triangles/s\n", static_cast<unsigned>(jobs.getConcurrency()),
+                        parallel, mesh.indices.size() / 3 / (parallel * 1e3));
+            std::printf("parallel output %s serial output\n", mesh.indices == serialIndices && mesh.vertices.size() == serialVertices ? "matches" : "DIFFERS from");
+
+            std::filesystem::remove(path);
+            std::filesystem::remove(path.parent_path() / "bench_grid.mtl");
+        }
+
+        BenchmarkRegistration registration("obj_loader", run);
+
+    }
+
+}
@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "Bench.hpp"
+#include "Entity.hpp"
+#include "Frustum.hpp"
+#include "InstanceBuffer.hpp"
+#include "OcclusionBuffer.hpp"
+#include "ecs/View.hpp"
+#include "jobs/ThreadPool.hpp"
+#include "platform/NullRenderContext.hpp"
+
+// The CPU occlusion buffer: 100k cubes scattered around a wall occluder, culled by
+// InstanceBuffer::build with and without occlusion, with every occluded cube checked to be
+// truly hidden behind the wall. Also times the box tests alone and rasterizing 1000 box
+// occluders.
+
+namespace ParteeEngine {
+
+    namespace {
+
+        constexpr int BoxCount = 100000;
+        constexpr int BufferWidth = 256;
+        constexpr int BufferHeight = 192;
+
+        const Vector3 Eye(3.0f, 2.0f, 35.0f);
+        const Vector3 WallPosition(0.0f, 0.0f, 0.0f);
+        const Vector3 WallScale(40.0f, 20.0f, 1.0f);
+
+        // Whether the segment from Eye to point crosses the wall
+        bool isBehindWall(const Vector3& point) {
+            Vector3 low = WallPosition - WallScale * 0.5f, high = WallPosition + WallScale * 0.5f;
+            Vector3 direction = point - Eye;
+            float origin[3] = {Eye.x, Eye.y, Eye.z}, delta[3] = {direction.x, direction.y, direction.z};
+            float lows[3] = {low.x, low.y, low.z}, highs[3] = {high.x, high.y, high.z};
+            float enter = 0.0f, exit = 1.0f;
+            for (int i = 0; i < 3; ++i) {
+                if (delta[i] == 0.0f) {
+                    if (origin[i] < lows[i] || origin[i] > highs[i]) return false;
+                    continue;
+                }
+                float a = (lows[i] - origin[i]) / delta[i], b = (highs[i] - origin[i]) / delta[i];
+                enter = std::max(enter, std::min(a, b));
+                exit = std::min(exit, std::max(a, b));
+                if (enter > exit) return false;
+            }
+            return true;
+        }
+
+        // Whether a cube lies behind the wall's front face with every corner seen through the wall
+        bool isHidden(const InstanceData& instance) {
+            Vector3 center, extents;
+            transformBounds(instance.model, Vector3(0.0f, 0.0f, 0.0f), Vector3(0.5f, 0.5f, 0.5f), center, extents);
+            if (center.z + extents.z > WallPosition.z + WallScale.z * 0.5f) return false;
+            for (int i = 0; i < 8; ++i) {
+                Vector3 corner(center.x + (i & 1 ? extents.x : -extents.x), center.y + (i & 2 ? extents.y : -extents.y),
+                               center.z + (i & 4 ? extents.z : -extents.z));
+                if (!isBehindWall(corner)) return false;
+            }
+            return true;
+        }
+
+        std::tuple<float, float, float> getKey(const InstanceData& instance) {
+            return std::make_tuple(instance.model.m[12], instance.model.m[13], instance.model.m[14]);
+        }
+
+        void run() {
+            World world;
+            TransformHierarchy hierarchy;
+            ThreadPool jobs;
+            InstanceBuffer buffer;
+            OcclusionBuffer occlusion;
+            occlusion.resize(BufferWidth, BufferHeight);
+
+            Entity wall(world, world.createEntity());
+            RenderComponent& wallRender = wall.addComponent<RenderComponent>();
+            wallRender.type = RenderComponent::CUBE;
+            wallRender.occluder = true;
+            wall.getComponent<TransformComponent>()->setPosition(WallPosition);
+            wall.getComponent<TransformComponent>()->setScale(WallScale);
+
+            std::mt19937 rng(7);
+            std::uniform_real_distribution<float> spread(-40.0f, 40.0f), depth(-60.0f, 20.0f), size(0.2f, 1.5f), angle(0.0f, 360.0f);
+            for (int i = 0; i < BoxCount; ++i) {
+                Entity entity(world, world.createEntity());
+                entity.addComponent<RenderComponent>().type = RenderComponent::CUBE;
+                auto* transform = entity.getComponent<TransformComponent>();
+                transform->setPosition(spread(rng), spread(rng) * 0.5f, depth(rng));
+                transform->setRotation(angle(rng), angle(rng), angle(rng));
+                float scale = size(rng);
+                transform->setScale(scale, scale, scale);
+            }
+            makeView<TransformComponent>(world).each([](TransformComponent& transform) { transform.updateLocalMatrix(1.0f); });
+
+            NullRenderContext context;
+            context.initialize(800, 600);
+            context.setCamera(Eye, Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f));
+            context.setPerspective(60.0f, 4.0f / 3.0f, 0.1f, 200.0f);
+            Matrix4 viewProjection = context.getViewProjection();
+            Frustum frustum = Frustum::fromMatrix(viewProjection);
+
+            RenderView view;
+            view.frustum = &frustum;
+            const Mesh& cube = InstanceBuffer::getMesh(RenderComponent::CUBE);
+            double frustumMs = measureMs(5, [&] { buffer.build(makeView<RenderComponent, TransformComponent>(world), jobs, hierarchy, view); });
+            std::vector<InstanceData> inFrustum = buffer.getInstances(cube);
+
+            view.occlusion = &occlusion;
+            double occlusionMs = measureMs(5, [&] {
+                occlusion.clear(viewProjection);
+                buffer.build(makeView<RenderComponent, TransformComponent>(world), jobs, hierarchy, view);
+            });
+            const CullStats stats = buffer.getCullStats();
+
+            // Every cube the buffer dropped must be hidden; the wall itself is always kept
+            std::vector<std::tuple<float, float, float>> kept;
+            for (const InstanceData& instance : buffer.getInstances(cube)) kept.push_back(getKey(instance));
+            std::sort(kept.begin(), kept.end());
+            size_t hidden = 0, wronglyCulled = 0;
+            for (const InstanceData& instance : inFrustum) {
+                bool truth = isHidden(instance);
+                hidden += truth;
+                if (!truth && !std::binary_search(kept.begin(), kept.end(), getKey(instance))) ++wronglyCulled;
+            }
+
+            // The box tests alone, over every cube
+            std::vector<float> centerX, centerY, centerZ, extentX, extentY, extentZ;
+            buffer.build(makeView<RenderComponent, TransformComponent>(world), jobs, hierarchy);
+            for (const InstanceData& instance : buffer.getInstances(cube)) {
+                Vector3 center, extents;
+                transformBounds(instance.model, Vector3(0.0f, 0.0f, 0.0f), Vector3(0.5f, 0.5f, 0.5f), center, extents);
+                centerX.push_back(center.x), centerY.push_back(center.y), centerZ.push_back(center.z);
+                extentX.push_back(extents.x), extentY.push_back(extents.y), extentZ.push_back(extents.z);
+            }
+            occlusion.clear(viewProjection);
+            occlusion.addOccluder(cube, Matrix4::compose(WallPosition, Vector3(0.0f, 0.0f, 0.0f), WallScale));
+            occlusion.rasterize(jobs);
+            size_t boxes = centerX.size() / 4 * 4, visible = 0;
+            double testMs = measureMs(5, [&] {
+                visible = 0;
+                for (size_t i = 0; i < boxes; i += 4) {
+                    Vector3x4 centers(Float4::load(&centerX[i]), Float4::load(&centerY[i]), Float4::load(&centerZ[i]));
+                    Vector3x4 extents(Float4::load(&extentX[i]), Float4::load(&extentY[i]), Float4::load(&extentZ[i]));
+                    int mask = occlusion.testVisible(centers, extents);
+                    visible += (mask & 1) + (mask >> 1 & 1) + (mask >> 2 & 1) + (mask >> 3 & 1);
+                }
+            });
+
+            // A city block of 40x25 buildings as occluders
+            double rasterizeMs = measureMs(20, [&] {
+                occlusion.clear(viewProjection);
+                for (int x = -20; x < 20; ++x) {
+                    for (int z = 0; z < 25; ++z) {
+                        occlusion.addOccluder(cube, Matrix4::compose(Vector3(x * 6.0f, 5.0f, -z * 6.0f - 5.0f), Vector3(0.0f, 0.0f, 0.0f), Vector3(4.0f, 10.0f, 4.0f)));
+                    }
+                }
+                occlusion.rasterize(jobs);
+            });
+
+            std::printf("%dx%d buffer, %zu threads\n", occlusion.getWidth(), occlusion.getHeight(), jobs.getConcurrency());
+            std::printf("%zu cubes, %zu in the frustum, %zu truly hidden, %zu occluded, %zu wrongly culled\n",
+                        stats.total - 1, inFrustum.size() - 1, hidden, stats.occluded, wronglyCulled);
+            std::printf("build, frustum only           %8.2f ms\n", frustumMs);
+            std::printf("build, frustum and occlusion  %8.2f ms\n", occlusionMs);
+            std::printf("%zu box tests, 4 at a time  %8.2f ms (%zu visible)\n", boxes, testMs, visible);
+            std::printf("rasterize 1000 box occluders  %8.2f ms\n", rasterizeMs);
+        }
+
+        BenchmarkRegistration registration("occlusion_culling", run);
+
+    }
+
+}
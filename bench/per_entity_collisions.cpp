@@ -0,0 +1,100 @@
+#include <cstdio>
+#include <vector>
+
+#include "Bench.hpp"
+#include "Entity.hpp"
+#include "ecs/TransformHierarchy.hpp"
+#include "ecs/View.hpp"
+#include "events/EventBus.hpp"
+#include "jobs/ThreadPool.hpp"
+#include "physics/CollisionWorld.hpp"
+#include "physics/PhysicsWorld.hpp"
+#include "components/ColliderComponent.hpp"
+#include "components/PhysicsComponent.hpp"
+#include "components/TransformComponent.hpp"
+
+// Per-entity delivery of a tick's collisions: the 20x20x4 block of 1600 boxes settles on
+// the ground while every box has a collision callback. Times the EventBus dispatch() of
+// each tick, counts its heap allocations and checks each box got exactly its own new or
+// changed contacts.
+
+namespace ParteeEngine {
+
+    namespace {
+
+        constexpr float Step = 1.0f / 60.0f;
+        constexpr int Ticks = 120;
+        constexpr int WarmupTicks = 30;
+
+        void run() {
+            EventBus bus;
+            bus.setDeferred<CollisionEvent>(1024);
+
+            World world;
+            PhysicsWorld physics;
+            CollisionWorld collisions;
+            TransformHierarchy hierarchy;
+            ThreadPool jobs;
+            world.setResource(&physics);
+            world.setResource(&bus);
+            physics.setGravity(Vector3(0.0f, -9.8f, 0.0f));
+
+            Entity ground(world, world.createEntity());
+            ground.addComponent<ColliderComponent>().setBox(Vector3(100.0f, 0.5f, 100.0f));
+            ground.getComponent<TransformComponent>()->setPosition(Vector3(0.0f, -0.5f, 0.0f));
+
+            std::vector<Entity> boxes;
+            size_t delivered = 0;
+            for (int x = 0; x < 20; ++x) {
+                for (int z = 0; z < 20; ++z) {
+                    for (int y = 0; y < 4; ++y) {
+                        Entity box(world, world.createEntity());
+                        box.addComponent<ColliderComponent>().setBox(Vector3(0.5f, 0.5f, 0.5f));
+                        box.getComponent<TransformComponent>()->setPosition(Vector3(x * 1.0f, 0.5f + y, z * 1.0f));
+                        EntityHandle handle = box.getID();
+                        box.addComponent<PhysicsComponent>().setCollisionCallback([&delivered, handle](const CollisionEvent& event) {
+                            delivered += event.first == handle || event.second == handle;
+                        });
+                        boxes.push_back(box);
+                    }
+                }
+            }
+
+            double dispatchMs = 0.0;
+            size_t events = 0, allocations = 0, mismatches = 0;
+            for (int tick = 0; tick < Ticks; ++tick) {
+                makeView<TransformComponent>(world).each([](TransformComponent& transform) { transform.storePreviousState(); });
+                physics.step(world, jobs, Step, collisions);
+                collisions.step(world, jobs, hierarchy);
+
+                // Every manifold reaches the boxes among its two entities, except resting ones
+                // carried over from the last tick, which are not emitted again
+                size_t expected = 0, emitted = 0;
+                for (const ContactManifold& manifold : collisions.getManifolds()) {
+                    if (manifold.resting) continue;
+                    expected += (manifold.first != ground.getID()) + (manifold.second != ground.getID());
+                    emitted++;
+                }
+                delivered = 0;
+                size_t allocationsBefore = getAllocationCount();
+                double ms = measureMs(1, [&] { bus.dispatch(); });
+                mismatches += delivered != expected;
+                if (tick >= WarmupTicks) {
+                    dispatchMs += ms / (Ticks - WarmupTicks);
+                    events += emitted;
+                    allocations += getAllocationCount() - allocationsBefore;
+                }
+            }
+
+            std::printf("%zu subscribed boxes, %.0f collisions emitted per tick\n", boxes.size(), static_cast<double>(events) / (Ticks - WarmupTicks));
+            std::printf("dispatch %.3f ms per tick, %zu allocations over the last %d ticks, %zu ticks with wrong deliveries\n",
+                        dispatchMs, allocations, Ticks - WarmupTicks, mismatches);
+
+            for (Entity& box : boxes) box.getComponent<PhysicsComponent>()->setCollisionCallback(nullptr);
+        }
+
+        BenchmarkRegistration registration("per_entity_collisions", run);
+
+    }
+
+}
@@ -0,0 +1,89 @@
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Bench.hpp"
+#include "Engine.hpp"
+#include "components/ColliderComponent.hpp"
+#include "components/TransformComponent.hpp"
+#include "jobs/ThreadPool.hpp"
+
+// CollisionWorld scene queries through the dynamic AABB tree, against testing every
+// collider's shape, over 20k mixed colliders.
+
+namespace ParteeEngine {
+
+    namespace {
+
+        constexpr int ColliderCount = 20000;
+        constexpr int RayCount = 10000;
+        constexpr int BruteForceRayCount = 500;
+
+        void run() {
+            std::mt19937 rng(5);
+            std::uniform_real_distribution<float> position(-50.0f, 50.0f), size(0.2f, 1.5f), angle(0.0f, 360.0f);
+
+            Engine engine(320, 240, PlatformBackend::Headless);
+            for (int i = 0; i < ColliderCount; ++i) {
+                Entity entity = engine.createEntity();
+                auto& collider = entity.addComponent<ColliderComponent>();
+                if (i % 3 == 0) collider.setAABB(Vector3(size(rng), size(rng), size(rng)));
+                else if (i % 3 == 1) collider.setBox(Vector3(size(rng), size(rng), size(rng)));
+                else collider.setSphere(size(rng));
+                auto* transform = entity.getComponent<TransformComponent>();
+                transform->setPosition(position(rng), position(rng), position(rng));
+                transform->setRotation(angle(rng), angle(rng), angle(rng));
+            }
+            engine.run(1);
+
+            const CollisionWorld& collisions = engine.getCollisionWorld();
+            std::vector<Ray> rays(RayCount);
+            for (Ray& ray : rays) {
+                ray.origin = Vector3(position(rng), position(rng), position(rng));
+                ray.direction = Vector3(position(rng), position(rng), position(rng)).normalize();
+                ray.maxDistance = 60.0f;
+            }
+
+            std::vector<RaycastHit> hits(rays.size());
+            double treeMs = measureMs(5, [&] { collisions.raycastBatch(rays.data(), rays.size(), hits.data(), engine.getJobs()); });
+
+            // Brute force on a subset of the rays, scaled to the full count
+            size_t mismatches = 0;
+            double bruteMs = measureMs(1, [&] {
+                for (int r = 0; r < BruteForceRayCount; ++r) {
+                    float best = rays[r].maxDistance;
+                    EntityHandle nearest;
+                    for (uint32_t i = 0; i < collisions.getColliderCount(); ++i) {
+                        float distance;
+                        Vector3 normal;
+                        if (collisions.getShape(i).raycast(rays[r].origin, rays[r].direction, best, distance, normal) && distance <= best) {
+                            best = distance;
+                            nearest = collisions.getEntity(i);
+                        }
+                    }
+                    if (nearest.isValid() != hits[r].entity.isValid()) ++mismatches;
+                }
+            }) * RayCount / BruteForceRayCount;
+
+            std::vector<EntityHandle> found;
+            double sphereMs = measureMs(5, [&] {
+                for (int q = 0; q < 1000; ++q) {
+                    found.clear();
+                    collisions.overlapSphere(rays[q].origin, 4.0f, found);
+                }
+            });
+            double nearestMs = measureMs(5, [&] {
+                for (int q = 0; q < 1000; ++q) collisions.nearest(rays[q].origin, 5, found);
+            });
+
+            std::printf("%zu colliders, %zu threads\n", collisions.getColliderCount(), engine.getJobs().getConcurrency());
+            std::printf("%d rays (length 60)  tree %8.2f ms   brute force %9.2f ms (from %d rays, %zu hit mismatches)\n", RayCount, treeMs, bruteMs, BruteForceRayCount, mismatches);
+            std::printf("1000 sphere overlaps tree %8.2f ms\n", sphereMs);
+            std::printf("1000 5-nearest       tree %8.2f ms\n", nearestMs);
+        }
+
+        BenchmarkRegistration registration("scene_queries", run);
+
+    }
+
+}
@@ -0,0 +1,53 @@
+#include <cstdio>
+#include <vector>
+
+#include "Bench.hpp"
+#include "Engine.hpp"
+#include "components/TransformComponent.hpp"
+#include "jobs/ThreadPool.hpp"
+
+// Cost of a headless Engine tick over 100k transforms that never move, as flat entities
+// and as one hierarchy (fanout 4), then with 1% of the hierarchy moving every tick.
+
+namespace ParteeEngine {
+
+    namespace {
+
+        constexpr int EntityCount = 100000;
+        constexpr int Fanout = 4;
+        constexpr int Ticks = 20;
+
+        void measure(const char* what, bool parented, int movingEvery) {
+            Engine engine(320, 240, PlatformBackend::Headless);
+            std::vector<Entity> entities;
+            entities.reserve(EntityCount);
+            for (int i = 0; i < EntityCount; ++i) {
+                Entity entity = engine.createEntity();
+                entity.addComponent<TransformComponent>().setPosition(static_cast<float>(i % 100), 0.0f, static_cast<float>(i / 100));
+                if (parented && i > 0) engine.setParent(entity, entities[(i - 1) / Fanout]);
+                entities.push_back(entity);
+            }
+            if (movingEvery > 0) {
+                engine.addSystem("mover", [&entities, movingEvery](SystemContext&) {
+                    for (size_t i = 0; i < entities.size(); i += movingEvery) {
+                        entities[i].getComponent<TransformComponent>()->translate(0.0f, 0.01f, 0.0f);
+                    }
+                }).writes<TransformComponent>();
+            }
+            engine.run(2);
+
+            double ms = measureMs(Ticks, [&] { engine.run(1); });
+            std::printf("%-22s %8.3f ms per tick (%zu hierarchy nodes)\n", what, ms, engine.getHierarchy().getNodeCount());
+        }
+
+        void run() {
+            measure("static, flat", false, 0);
+            measure("static, hierarchy", true, 0);
+            measure("1% moving, hierarchy", true, 100);
+        }
+
+        BenchmarkRegistration registration("simulation_matrices", run);
+
+    }
+
+}
@@ -0,0 +1,59 @@
+#include <cstdio>
+#include <vector>
+
+#include "Bench.hpp"
+#include "Mesh.hpp"
+#include "jobs/ThreadPool.hpp"
+#include "platform/SoftwareRenderContext.hpp"
+
+// One 1080p frame of the software rasterizer: a field of rotated cubes drawn through
+// drawInstanced, then binned and rasterized by present(), with tiles on the calling
+// thread and on the pool.
+
+namespace ParteeEngine {
+
+    namespace {
+
+        constexpr int Width = 1920;
+        constexpr int Height = 1080;
+
+        double renderFrame(SoftwareRenderContext& context, const std::vector<InstanceData>& instances) {
+            return measureMs(5, [&] {
+                context.clear();
+                context.drawInstanced(Mesh::unitCube(), instances.data(), instances.size());
+                context.present();
+            });
+        }
+
+        void run() {
+            std::vector<InstanceData> instances;
+            const int side = 100;
+            for (int i = 0; i < side * side; ++i) {
+                Vector3 position((i % side - side / 2) * 1.5f, 0.0f, -(i / side) * 1.5f);
+                Vector3 rotation(0.0f, (i % 13) * 7.0f, 0.0f);
+                Vector3 scale(1.0f, 1.0f + (i % 3) * 0.5f, 1.0f);
+                instances.push_back({Matrix4::compose(position, rotation, scale), packRGBA(0.5f + (i % 5) * 0.1f, 1.0f, 0.5f)});
+            }
+
+            ThreadPool jobs;
+            SoftwareRenderContext serial;
+            SoftwareRenderContext parallel(&jobs);
+            for (SoftwareRenderContext* context : {&serial, &parallel}) {
+                context->initialize(Width, Height);
+                context->setPerspective(60.0f, static_cast<float>(Width) / Height, 0.1f, 500.0f);
+                context->setCamera(Vector3(0.0f, 8.0f, 12.0f), Vector3(0.0f, 0.0f, -10.0f), Vector3(0.0f, 1.0f, 0.0f));
+            }
+
+            double serialMs = renderFrame(serial, instances);
+            double parallelMs = renderFrame(parallel, instances);
+            std::printf("%dx%d, %zu cubes, %zu triangles after clipping and culling\n", Width, Height, instances.size(), serial.getTriangleCount());
+            std::printf("tiles on the calling thread  %8.2f ms\n", serialMs);
+            std::printf("tiles on the pool (%zu threads) %8.2f ms\n", jobs.getConcurrency(), parallelMs);
+            std::printf("framebuffers %s\n", serial.getColorBuffer() == parallel.getColorBuffer() ? "match" : "DIFFER");
+        }
+
+        BenchmarkRegistration registration("software_raster", run);
+
+    }
+
+}
@@ -1,32 +1,169 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
-#include "entity.hpp"
+#include "Entity.hpp"
+#include "InstanceBuffer.hpp"
+#include "ecs/World.hpp"
+#include "ecs/View.hpp"
+#include "ecs/SystemScheduler.hpp"
+#include "ecs/TransformHierarchy.hpp"
+#include "events/EventBus.hpp"
+#include "physics/CollisionWorld.hpp"
+#include "physics/PhysicsWorld.hpp"
+#include "platform/Platform.hpp"
 
 namespace ParteeEngine {
     class Window;
     class Renderer; 
+    class ThreadPool;
 
     class Engine {
 
         public:
-            Engine(int width, int height);
+            Engine(int width, int height, PlatformBackend backend = PlatformBackend::Native);
             ~Engine();
 
+            // Runs the main loop until the window closes or stop() is called. Headless engines
+            // run back-to-back fixed ticks as fast as possible instead of tracking real time.
             void start();
 
-            Entity& createEntity();
+            // Runs exactly the given number of fixed ticks as fast as possible, then returns.
+            // Only the Software backend renders (one frame per tick).
+            void run(uint64_t ticks);
+
+            // Makes start() return. Safe to call from any thread or from a system.
+            void stop();
+
+            // True for every backend without a display (Headless and Software).
+            bool isHeadless() const { return backend != PlatformBackend::Native; }
+
+            Renderer& getRenderer() { return *renderer; }
+
+            uint64_t getTickCount() const { return tickCount; }
+
+            // World matrices recomputed by the last rendered frame. Transforms that have not
+            // changed since their matrix was built are skipped.
+            size_t getUpdatedTransformCount() const { return updatedTransformCount; }
+
+            // RenderComponents considered by the last rendered frame and those left after
+            // frustum culling.
+            const CullStats& getCullStats() const { return instanceBuffer.getCullStats(); }
+
+            // Depth of the RenderComponents marked as occluders in the last rendered frame.
+            const OcclusionBuffer& getOcclusionBuffer() const { return occlusion; }
+
+            // Loads the OBJ file at path (see loadObj) the first time it is asked for; later
+            // calls return the same mesh. Meshes live as long as the engine.
+            const Mesh& loadMesh(const std::string& path);
+
+            Entity createEntity();
+
+            // Destroys the entity and its components; its slot is recycled by later createEntity calls.
+            void destroyEntity(Entity entity);
+
+            Entity getEntity(EntityHandle handle);
+
+            // Attaches child to parent: the child's transform becomes relative to the parent's.
+            // Both get a TransformComponent if they lack one.
+            void setParent(Entity child, Entity parent);
+
+            // Makes the entity a root again; its transform is interpreted in world space.
+            void clearParent(Entity child);
+
+            TransformHierarchy& getHierarchy() { return hierarchy; }
+
+            // This engine's events, also reachable from components as a World resource.
+            // CollisionEvents are deferred and delivered once per tick.
+            EventBus& getEventBus() { return events; }
+
+            // Rigid bodies of every PhysicsComponent, integrated once per tick.
+            PhysicsWorld& getPhysicsWorld() { return physics; }
+
+            // Colliders are checked for overlaps once per tick. The broadphase can be switched
+            // at any time: SpatialHash suits evenly spread scenes, SweepAndPrune clustered ones.
+            void setBroadphase(BroadphaseType type) { collisions.setBroadphase(type); }
+            CollisionWorld& getCollisionWorld() { return collisions; }
+
+            // Registers a system that runs every tick. Declare the component types it touches
+            // with reads<...>()/writes<...>() on the returned System so it can be scheduled.
+            System& addSystem(std::string name, System::UpdateFn update);
+
+            ThreadPool& getJobs() { return *jobs; }
+
+            // Simulation runs at a fixed rate independent of the frame rate.
+            void setTickRate(float ticksPerSecond);
+            float getTickRate() const { return 1.0f / fixedDelta; }
+
+            // Upper bound on simulation ticks per rendered frame. When a frame falls further
+            // behind than this, the extra time is dropped instead of piling up.
+            void setMaxSubsteps(int substeps) { maxSubsteps = substeps; }
+
+            // Fraction of a tick between the last simulated state and the next one, used
+            // to interpolate transforms when rendering.
+            float getInterpolationAlpha() const { return interpolationAlpha; }
+
+            // Returns a view over entities that have all of Ts and none of the excluded types.
+            template <typename... Ts, typename... Excluded>
+            View<Ts...> view(Exclude<Excluded...> exclude = {})
+            {
+                return makeView<Ts...>(world, exclude);
+            }
 
         private:
             int width;
             int height;
 
+            // Advances the simulation by one fixed tick.
             void update();
 
-            Window* window;
-            Renderer* renderer;
+            // Runs as many ticks as the elapsed real time calls for, then renders.
+            void frame();
+
+            // Draws every RenderComponent in the camera frustum, interpolated alpha of the way into
+            // the last tick, as one instanced submission per mesh.
+            void render(float alpha);
+
+            // Recomputes the cached matrix of every changed TransformComponent in parallel,
+            // then propagates them through the hierarchy. Interpolation is applied on top of
+            // the simulation matrices the last tick left there.
+            void updateWorldMatrices(float alpha);
+
+            // Pushes the simulation state (no interpolation) of the hierarchy nodes whose transform
+            // changed since the last tick and propagates it, so systems see this tick's world matrices.
+            void updateSimulationMatrices(ThreadPool &jobs);
+
+            PlatformBackend backend;
+
+            float fixedDelta = 1.0f / 60.0f;
+            int maxSubsteps = 8;
+            double accumulator = 0.0;
+            float interpolationAlpha = 0.0f;
+            std::chrono::steady_clock::time_point lastFrameTime;
+            std::atomic<uint64_t> tickCount{0};
+            size_t updatedTransformCount = 0;
+
+            std::unique_ptr<Window> window;
+            std::unique_ptr<Renderer> renderer;
+            std::unique_ptr<ThreadPool> jobs;
+
+            // Outlives the world, whose PhysicsComponents point at it; subscriptions end with the engine
+            EventBus events;
+            World world;
+            SystemScheduler scheduler;
+            TransformHierarchy hierarchy;
+            PhysicsWorld physics;
+            CollisionWorld collisions;
+            InstanceBuffer instanceBuffer;
+            OcclusionBuffer occlusion;
+            std::unordered_map<std::string, std::unique_ptr<Mesh>> meshes; // by path
 
-            std::vector<Entity> entities;
+            void registerDefaultSystems();
     };
 } // namespace ParteeEngine
@@ -1,24 +1,32 @@
 #pragma once
-#include <unordered_map>
-#include <unordered_set>
-#include <typeindex>
 #include <memory>
 #include <vector>
 #include <stdexcept>
 #include <functional>
 
 #include "components/Component.hpp"
+#include "ecs/ComponentType.hpp"
+#include "ecs/EntityHandle.hpp"
 
 namespace ParteeEngine {
 
+    class World;
+
+    // Lightweight, copyable handle to an entity whose components live in a World.
+    // Stays safe to hold across frames: once the entity is destroyed, lookups
+    // through the handle fail instead of touching a recycled slot.
     class Entity {
 
         public:
-            Entity(int id);
-            
+            // Inline so views that hand out an Entity per row do not pay a call for each
+            Entity(World &world, EntityHandle id) : world_(&world), id(id) {}
+
             template <typename T, typename... Args>
             T &addComponent(Args &&...args);
 
+            template <typename T>
+            void removeComponent();
+
             template<typename T>
             T* getComponent();
 
@@ -35,55 +43,69 @@ namespace ParteeEngine {
 
             void update(float dt);
 
-            int getID() const;
+            EntityHandle getID() const;
 
-        private:
-            int id = -1;
+            // False once the entity has been destroyed.
+            bool isAlive() const;
+
+            World &getWorld() const { return *world_; }
 
-            std::unordered_map<std::type_index, std::unique_ptr<Component>> components_;
+        private:
+            World *world_;
+            EntityHandle id;
 
-            Component* getComponentByType(std::type_index type);
+            Component* getComponentByType(ComponentTypeId type);
     };
+}
+
+#include "ecs/World.hpp"
+
+namespace ParteeEngine {
 
     template <typename T, typename... Args>
     T& Entity::addComponent(Args&&... args)
     {
-        // get the component type
-        auto type = std::type_index(typeid(T));
         // check if component already exists
-        if (components_.find(type) != components_.end()) {
+        if (hasComponent<T>()) {
             throw std::runtime_error("Component already exists on this entity");
         }
 
-        // create the component
-        auto component = std::make_unique<T>(std::forward<Args>(args)...);
-        component->requireDependencies(*this);
-        component->onAttach(*this);
+        // create the component; dependencies may add other components first
+        T component(std::forward<Args>(args)...);
+        component.requireDependencies(*this);
 
-        // add the component
-        T& ref = *component;
-        components_[type] = std::move(component);
+        // move it into the archetype storage
+        T& ref = world_->insertComponent<T>(id, std::move(component));
+        ref.onAttach(*this);
 
         return ref;
     }
 
+    template <typename T>
+    void Entity::removeComponent()
+    {
+        if (auto *comp = getComponent<T>()) {
+            comp->onDetach(*this);
+        }
+        world_->removeComponent<T>(id);
+    }
+
     template <typename T>
     T* Entity::getComponent()
     {
-        auto it = components_.find(std::type_index(typeid(T)));
-        return it != components_.end() ? static_cast<T*>(it->second.get()) : nullptr;
+        return world_->getComponent<T>(id);
     }
 
     template <typename T>
     bool Entity::hasComponent()
     {
-        return components_.count(std::type_index(typeid(T))) > 0;
+        return world_->hasComponent<T>(id);
     }
 
     template <typename T>
-    void Entity::ensureComponent() 
+    void Entity::ensureComponent()
     {
-        if (!hasComponent<T>()) 
+        if (!hasComponent<T>())
         {
             addComponent<T>();
         }
@@ -96,4 +118,4 @@ namespace ParteeEngine {
         if (comp)
             comp->update(*this, dt);
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cmath>
+
+#include "Vector3.hpp"
+#include "math/Float4.hpp"
+#include "math/Matrix4.hpp"
+#include "physics/Aabb.hpp"
+
+namespace ParteeEngine {
+
+    class RenderContext;
+
+    // Plane with normal . p + distance >= 0 on the inner side.
+    struct Plane {
+        Vector3 normal;
+        float distance = 0.0f;
+
+        float signedDistance(const Vector3& p) const { return normal.dot(p) + distance; }
+    };
+
+    // The six planes bounding what a camera sees, extracted from its view-projection matrix.
+    // Box tests are conservative: boxes near a frustum corner may pass without being visible.
+    struct Frustum {
+        enum Side { Left, Right, Bottom, Top, Near, Far, SideCount };
+
+        Plane planes[SideCount];
+
+        static Frustum fromMatrix(const Matrix4& viewProjection);
+
+        // The frustum of the context's camera and perspective projection.
+        static Frustum fromCamera(const RenderContext& context);
+
+        bool intersects(const Aabb& box) const;
+
+        // Tests four boxes given by their centers and half extents at once. Bit i of the
+        // result is set if box i may be visible.
+        int intersects(const Vector3x4& centers, const Vector3x4& halfExtents) const;
+    };
+
+    // Box containing the local box (center, halfExtents) transformed by model.
+    inline void transformBounds(const Matrix4& model, const Vector3& center, const Vector3& halfExtents,
+                                Vector3& worldCenter, Vector3& worldHalfExtents) {
+        worldCenter = model.transformPoint(center);
+        worldHalfExtents = Vector3(
+            std::fabs(model.m[0]) * halfExtents.x + std::fabs(model.m[4]) * halfExtents.y + std::fabs(model.m[8]) * halfExtents.z,
+            std::fabs(model.m[1]) * halfExtents.x + std::fabs(model.m[5]) * halfExtents.y + std::fabs(model.m[9]) * halfExtents.z,
+            std::fabs(model.m[2]) * halfExtents.x + std::fabs(model.m[6]) * halfExtents.y + std::fabs(model.m[10]) * halfExtents.z);
+    }
+
+}
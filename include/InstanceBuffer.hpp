@@ -0,0 +1,130 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "Frustum.hpp"
+#include "Mesh.hpp"
+#include "OcclusionBuffer.hpp"
+#include "ecs/TransformHierarchy.hpp"
+#include "ecs/View.hpp"
+#include "components/RenderComponent.hpp"
+#include "components/TransformComponent.hpp"
+
+namespace ParteeEngine {
+
+    class ThreadPool;
+
+    // Instances considered and kept by the last InstanceBuffer::build().
+    struct CullStats {
+        size_t total = 0;
+        size_t visible = 0;
+        size_t occluded = 0;  // inside the frustum but hidden behind occluders
+        size_t triangles = 0; // of the visible instances, at their selected level of detail
+    };
+
+    // What the camera sees, for InstanceBuffer::build(). Passes whose input is missing are skipped.
+    struct RenderView {
+        const Frustum* frustum = nullptr;
+        OcclusionBuffer* occlusion = nullptr; // cleared for this frame's camera
+
+        // Level-of-detail selection: the camera position and 1 / tan(fov / 2), which turns a
+        // radius over a distance into a fraction of the screen height. With 0, RenderComponents
+        // keep their current level.
+        Vector3 cameraPosition;
+        float projectionScale = 0.0f;
+        float lodHysteresis = 0.1f; // see LodChain::selectLevel()
+    };
+
+    // Instances of one mesh, drawn as a single instanced submission.
+    struct InstanceGroup {
+        const Mesh* mesh = nullptr;
+        std::vector<InstanceData> instances;
+    };
+
+    // Per-frame instance data for every visible RenderComponent, grouped by the mesh it is
+    // drawn with: its own mesh or the unit mesh of its RenderType, or the selected level of
+    // its LodChain.
+    class InstanceBuffer {
+    public:
+        static constexpr size_t ChunkSize = 1024;
+
+        // Rebuilds the groups from the view using the cached transform matrices (world
+        // matrices from the hierarchy for parented entities), so both must be up to date.
+        // Instances whose bounds lie outside the frustum are dropped while they are gathered,
+        // four at a time; the others with a LodChain pick their level from their projected
+        // size. With an occlusion buffer, the visible RenderComponents marked as occluders are
+        // drawn into it and the instances it hides are dropped as well. Chunks of the view are
+        // processed in parallel on jobs.
+        void build(View<RenderComponent, TransformComponent> view, ThreadPool& jobs, const TransformHierarchy& hierarchy,
+                   const RenderView& camera = RenderView());
+
+        // One group per mesh with visible instances, in the order the meshes were first seen.
+        const std::vector<InstanceGroup>& getGroups() const { return groups; }
+
+        // Instances drawn with mesh, or an empty list.
+        const std::vector<InstanceData>& getInstances(const Mesh& mesh) const;
+
+        const CullStats& getCullStats() const { return cullStats; }
+
+        // Unit mesh of SQUARE and CUBE.
+        static const Mesh& getMesh(RenderComponent::RenderType type);
+
+    private:
+        struct ChunkGroup {
+            const Mesh* mesh;
+            std::vector<InstanceData> instances;
+            size_t group;  // index into groups
+            size_t offset; // of the first instance in it
+        };
+
+        struct Occluder {
+            const Mesh* mesh;
+            Matrix4 model;
+        };
+
+        // A gathered instance with the mesh it would be drawn with before level selection.
+        struct Candidate {
+            InstanceData instance;
+            RenderComponent* render;
+            const Mesh* mesh;
+        };
+
+        // Everything one chunk of the view produced; kept across frames to reuse allocations.
+        struct Chunk {
+            std::vector<ChunkGroup> groups; // by mesh, groups of meshes no longer drawn stay empty
+            std::vector<Occluder> occluders;
+            size_t total = 0;
+            size_t occluded = 0;
+
+            // Candidates waiting for the frustum test, with their world bounds transposed into lanes
+            Candidate pending[4];
+            alignas(16) float pendingCenters[3][4];
+            alignas(16) float pendingHalfExtents[3][4];
+            size_t pendingCount = 0;
+
+            std::vector<InstanceData>& getGroup(const Mesh* mesh);
+
+            // Selects the candidate's level of detail and adds it to its group. center and
+            // halfExtents are its world bounds, only read when a level is selected.
+            void keep(const Candidate& candidate, const Vector3& center, const Vector3& halfExtents, const RenderView& camera);
+
+            // Queues a candidate for the frustum test, which runs once four are queued.
+            void stage(const Candidate& candidate, const Vector3& center, const Vector3& halfExtents,
+                       const Frustum& frustum, const RenderView& camera);
+
+            // Tests the queued candidates against frustum at once and keeps the visible ones.
+            void flushPending(const Frustum& frustum, const RenderView& camera);
+        };
+
+        std::vector<Chunk> chunks;
+        std::vector<InstanceGroup> groups;
+        std::unordered_map<const Mesh*, size_t> groupOfMesh;
+        CullStats cullStats;
+
+        // Compacts instances to the ones whose mesh bounds occlusion does not hide. Returns how
+        // many it removed.
+        static size_t cull(std::vector<InstanceData>& instances, const Mesh& mesh, const OcclusionBuffer& occlusion);
+    };
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+
+#include "RenderContext.hpp"
+#include "math/Matrix4.hpp"
+#include "physics/Aabb.hpp"
+
+namespace ParteeEngine {
+
+    // Triangle list in model space, shared by every instance drawn with it. Indexed when
+    // indices is not empty: each three indices into vertices make a triangle.
+    struct Mesh {
+        std::vector<RenderVertex> vertices;
+        std::vector<uint32_t> indices;
+        Aabb bounds; // of the vertices, see computeBounds()
+
+        void computeBounds();
+
+        // Corners of the triangle list, three per triangle.
+        size_t getCornerCount() const { return indices.empty() ? vertices.size() : indices.size(); }
+        const RenderVertex& getCorner(size_t i) const { return indices.empty() ? vertices[i] : vertices[indices[i]]; }
+
+        // 1x1 white square in the z = 0 plane, centered on the origin.
+        static const Mesh& unitSquare();
+
+        // 1x1x1 cube centered on the origin with a different color per face.
+        static const Mesh& unitCube();
+    };
+
+    // Versions of one model from most to least detailed. Level i is drawn while the model's
+    // projected size (bounding sphere diameter over screen height) is at least its screenSize;
+    // below the last level's screenSize the model is not drawn at all.
+    struct LodChain {
+        struct Level {
+            const Mesh* mesh;
+            float screenSize;
+        };
+        std::vector<Level> levels; // screenSize decreasing
+
+        // Level for a model of the given projected size currently drawn at level current, or
+        // levels.size() if it is too small to draw. Levels only change once the size is past a
+        // threshold by the fraction hysteresis, so models near one do not flicker between two.
+        size_t selectLevel(float screenSize, size_t current, float hysteresis) const;
+    };
+
+    // Per-instance data for instanced draws.
+    struct InstanceData {
+        Matrix4 model;
+        uint32_t color; // packRGBA, multiplies the mesh colors
+    };
+
+    // Multiplies two packRGBA colors channel by channel.
+    inline uint32_t modulateRGBA(uint32_t a, uint32_t b) {
+        uint32_t result = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            uint32_t channel = (((a >> shift) & 0xFF) * ((b >> shift) & 0xFF) + 127) / 255;
+            result |= channel << shift;
+        }
+        return result;
+    }
+
+}
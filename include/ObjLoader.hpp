@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "Mesh.hpp"
+#include "Vector3.hpp"
+
+namespace ParteeEngine {
+
+    class ThreadPool;
+
+    // Reads a Wavefront OBJ file into an indexed Mesh. Only what RenderVertex holds is kept:
+    // positions, colored with the diffuse color (Kd) of each face's material from the MTL
+    // libraries the file references, or white. Polygons are triangulated as fans; texture
+    // coordinates, normals, groups and smoothing are skipped. Corners sharing a position and
+    // a color become one vertex.
+    //
+    // The file is memory-mapped and split into chunks of lines parsed in parallel on jobs
+    // (or on the calling thread without a pool). Throws std::runtime_error when the file or
+    // a referenced library cannot be read, or on malformed vertices and faces.
+    Mesh loadObj(const std::string& path, ThreadPool* jobs = nullptr);
+
+    // Diffuse color (Kd) of every material in the MTL file at path, by name.
+    std::unordered_map<std::string, Vector3> loadMtl(const std::string& path);
+
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Vector3.hpp"
+#include "math/Float4.hpp"
+#include "math/Matrix4.hpp"
+
+namespace ParteeEngine {
+
+    struct Mesh;
+    class ThreadPool;
+
+    // Low-resolution CPU depth buffer of selected occluders, used to skip objects hidden
+    // behind them before they reach the Renderer. Occluder triangles are rasterized four
+    // pixels at a time in parallel bands of tile rows, keeping the nearest depth per pixel
+    // as 1 / w (clip w, the distance along the view direction), which unlike w interpolates
+    // linearly across the screen. Each TileSize x TileSize tile then stores the nearest and
+    // farthest depth of its pixels: a box is hidden in a tile if it lies behind the tile's
+    // farthest pixel, visible if it reaches in front of its nearest, and only the remaining
+    // tiles are checked per pixel.
+    //
+    // Occluders are resolved at the buffer's resolution. Boxes are tested with a pixel of
+    // margin around them, but a gap between occluders narrower than a buffer pixel can
+    // still hide objects seen through it.
+    class OcclusionBuffer {
+    public:
+        static constexpr int TileSize = 8;
+
+        // Width and height are rounded up to whole tiles.
+        void resize(int width, int height);
+
+        // Starts a frame seen through viewProjection, with no occluders.
+        void clear(const Matrix4& viewProjection);
+
+        // Queues the mesh's triangles placed by model. Triangles reaching in front of the
+        // near plane are dropped, which only makes the buffer hide less.
+        void addOccluder(const Mesh& mesh, const Matrix4& model);
+
+        // Rasterizes the queued occluders and builds the tile depths.
+        void rasterize(ThreadPool& jobs);
+
+        bool hasOccluders() const { return !triangles.empty(); }
+
+        // Whether a world-space box may be visible past the occluders.
+        bool isVisible(const Vector3& center, const Vector3& halfExtents) const;
+
+        // Tests four boxes at once; bit i of the result is set if box i may be visible.
+        int testVisible(const Vector3x4& centers, const Vector3x4& halfExtents) const;
+
+        int getWidth() const { return width; }
+        int getHeight() const { return height; }
+        size_t getTriangleCount() const { return triangles.size(); }
+
+        // Row-major 1 / w of the nearest occluder per pixel, 0 where nothing was drawn.
+        const std::vector<float>& getDepth() const { return depth; }
+
+    private:
+        // Screen space: pixels in x and y, 1 / w in z
+        struct Triangle {
+            float x[3];
+            float y[3];
+            float z[3];
+            int minY, maxY;
+        };
+
+        int width = 0;
+        int height = 0;
+        int tilesX = 0;
+        int tilesY = 0;
+        Matrix4 viewProjection;
+
+        std::vector<float> depth;
+        std::vector<float> tileFarthest; // smallest 1 / w of each tile
+        std::vector<float> tileNearest;
+        std::vector<Triangle> triangles;
+
+        void rasterizeTriangle(const Triangle& triangle, int rowBegin, int rowEnd);
+        void updateTiles(int tileRow);
+
+        // Whether any pixel in the rectangle is no nearer than nearest (a 1 / w).
+        bool isRectVisible(float minX, float minY, float maxX, float maxY, float nearest) const;
+    };
+
+}
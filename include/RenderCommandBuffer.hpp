@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "RenderContext.hpp"
+
+namespace ParteeEngine {
+
+    // Opaque geometry is drawn first, front to back; transparent geometry last, back to front.
+    enum class RenderPass : uint8_t { Opaque = 0, Transparent = 1 };
+
+    struct Mesh;
+    struct InstanceData;
+
+    struct RenderCommand {
+        // Bits 63-56 pass, 55-32 material, 31-0 depth (see makeSortKey).
+        uint64_t sortKey;
+        uint32_t firstVertex;
+        uint32_t vertexCount;
+
+        // Set for instanced commands, which are never merged with other commands.
+        const Mesh* mesh = nullptr;
+        const InstanceData* instances = nullptr;
+        uint32_t instanceCount = 0;
+    };
+
+    // Counters for the last flushed frame.
+    struct RenderStats {
+        size_t commands = 0;
+        size_t batches = 0;
+        size_t vertices = 0;
+        size_t instances = 0;
+    };
+
+    // Per-frame list of draw commands over world-space triangle vertices. Commands are
+    // recorded in any order, sorted by key at flush(), and every run of commands with
+    // the same pass and material is merged into a single drawTriangles() call.
+    class RenderCommandBuffer {
+    public:
+        static constexpr uint32_t MaxMaterial = (1u << 24) - 1;
+
+        // Pass and material bits of a sort key; commands with equal masked keys batch together.
+        static constexpr uint64_t BatchKeyMask = ~0xFFFFFFFFull;
+
+        // Orders by pass, then material, then depth. depth is any non-negative distance
+        // from the camera; it is reversed for the transparent pass.
+        static uint64_t makeSortKey(RenderPass pass, uint32_t material, float depth);
+
+        // Reserves vertexCount vertices for a new command and returns them for the caller
+        // to fill. The pointer is valid until the next record() or clear().
+        RenderVertex* record(RenderPass pass, uint32_t material, float depth, uint32_t vertexCount);
+
+        // Records one drawInstanced() submission. Nothing is copied, so the mesh and the
+        // instances must stay alive and unchanged until flush().
+        void recordInstanced(RenderPass pass, uint32_t material, float depth,
+                             const Mesh& mesh, const InstanceData* instances, uint32_t instanceCount);
+
+        // Sorts, merges and submits everything recorded since clear(), then empties the buffer.
+        void flush(RenderContext& context);
+
+        void clear();
+
+        size_t getCommandCount() const { return commands.size(); }
+        const RenderStats& getStats() const { return stats; }
+
+    private:
+        std::vector<RenderCommand> commands;
+        std::vector<RenderVertex> vertices;
+        std::vector<RenderVertex> batch;
+        RenderStats stats;
+    };
+
+}
@@ -1,61 +1,99 @@
 #pragma once
 
-#include <windows.h>
-#include <GL/gl.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 #include "Vector3.hpp"
 
 namespace ParteeEngine {
 
     struct Matrix4;
+    struct Mesh;
+    struct InstanceData;
+
+    // Packs a color as RGBA8 with red in the lowest byte (0xAABBGGRR).
+    inline uint32_t packRGBA(float r, float g, float b, float a = 1.0f) {
+        auto channel = [](float v) { return static_cast<uint32_t>(std::min(std::max(v, 0.0f), 1.0f) * 255.0f + 0.5f); };
+        return channel(r) | (channel(g) << 8) | (channel(b) << 16) | (channel(a) << 24);
+    }
+
+    // Vertex layout for batched submission. The color uses the packRGBA layout.
+    struct RenderVertex {
+        Vector3 position;
+        uint32_t color;
+    };
 
+    // Backend-independent rendering interface. The camera and projection state is
+    // tracked here so CPU-side passes can use it regardless of the backend.
     class RenderContext {
     public:
         RenderContext();
-        ~RenderContext();
+        virtual ~RenderContext() = default;
 
         // Context management
-        void initialize(int width, int height);
-        void clear();
-        void present();
+        virtual void initialize(int width, int height) = 0;
+        virtual void clear() = 0;
+        virtual void present() = 0;
 
         // Transformation matrix operations
-        void pushMatrix();
-        void popMatrix();
-        void loadIdentity();
-        void translate(const Vector3& position);
-        void rotate(const Vector3& rotation);
-        void scale(const Vector3& scale);
-        void multMatrix(const Matrix4& matrix);
+        virtual void pushMatrix() = 0;
+        virtual void popMatrix() = 0;
+        virtual void loadIdentity() = 0;
+        virtual void translate(const Vector3& position) = 0;
+        virtual void rotate(const Vector3& rotation) = 0;
+        virtual void scale(const Vector3& scale) = 0;
+        virtual void multMatrix(const Matrix4& matrix) = 0;
 
         // Drawing operations
-        void setColor(float r, float g, float b, float a = 1.0f);
-        void drawTriangle(const Vector3& v1, const Vector3& v2, const Vector3& v3);
-        void drawQuad(const Vector3& v1, const Vector3& v2, const Vector3& v3, const Vector3& v4);
+        virtual void setColor(float r, float g, float b, float a = 1.0f) = 0;
+        virtual void drawTriangle(const Vector3& v1, const Vector3& v2, const Vector3& v3) = 0;
+        virtual void drawQuad(const Vector3& v1, const Vector3& v2, const Vector3& v3, const Vector3& v4) = 0;
         
         // Immediate mode helpers
-        void beginTriangles();
-        void beginQuads();
-        void end();
-        void vertex(const Vector3& v);
-        void color(float r, float g, float b, float a = 1.0f);
+        virtual void beginTriangles() = 0;
+        virtual void beginQuads() = 0;
+        virtual void end() = 0;
+        virtual void vertex(const Vector3& v) = 0;
+        virtual void color(float r, float g, float b, float a = 1.0f) = 0;
+
+        // Draws count / 3 triangles in one call under the current matrix. The default
+        // goes through the immediate mode helpers; backends override it with a bulk path.
+        virtual void drawTriangles(const RenderVertex* vertices, size_t count);
+
+        // Draws the mesh once per instance, each under the current matrix times its model
+        // matrix with the mesh colors multiplied by its color. The default expands the
+        // instances on the CPU and goes through drawTriangles().
+        virtual void drawInstanced(const Mesh& mesh, const InstanceData* instances, size_t count);
 
         // State management
-        void enableDepthTest(bool enable);
-        void setCullFace(bool enable);
-        void setViewport(int x, int y, int width, int height);
+        virtual void enableDepthTest(bool enable) = 0;
+        virtual void setCullFace(bool enable) = 0;
+        virtual void setViewport(int x, int y, int width, int height);
 
         // Camera and projection
-        void setPerspective(float fov, float aspect, float near, float far);
-        void setCamera(const Vector3& position, const Vector3& target, const Vector3& up);
+        virtual void setPerspective(float fov, float aspect, float nearDistance, float farDistance);
+        virtual void setCamera(const Vector3& position, const Vector3& target, const Vector3& up);
 
-    private:
+        int getViewportWidth() const { return viewportWidth; }
+        int getViewportHeight() const { return viewportHeight; }
+        const Vector3& getCameraPosition() const { return cameraPosition; }
+        const Vector3& getCameraTarget() const { return cameraTarget; }
+        const Vector3& getCameraUp() const { return cameraUp; }
+        float getFov() const { return fov; }
+        float getAspect() const { return aspect; }
+        float getNearPlane() const { return nearPlane; }
+        float getFarPlane() const { return farPlane; }
+
+        // Projection times view matrix of the camera state above.
+        Matrix4 getViewProjection() const;
+
+    protected:
         int viewportWidth;
         int viewportHeight;
         bool initialized;
 
-        void setupPerspective();
-        void setupCamera();
-        
         Vector3 cameraPosition;
         Vector3 cameraTarget;
         Vector3 cameraUp;
@@ -63,6 +101,9 @@ namespace ParteeEngine {
         float aspect;
         float nearPlane;
         float farPlane;
+
+    private:
+        std::vector<RenderVertex> expandedInstances;
     };
 
-}
\ No newline at end of file
+}
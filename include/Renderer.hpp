@@ -1,14 +1,18 @@
 #pragma once
 
+#include "RenderCommandBuffer.hpp"
 #include "RenderContext.hpp"
+#include "Mesh.hpp"
 #include "Vector3.hpp"
 #include <memory>
 
 namespace ParteeEngine {
 
+    // Draw calls are recorded into a command buffer as world-space triangles and only
+    // reach the RenderContext at present(), sorted and merged into as few batches as possible.
     class Renderer {
     public:
-        Renderer();
+        explicit Renderer(std::unique_ptr<RenderContext> context);
         ~Renderer();
         
         void initialize(int width, int height);
@@ -19,6 +23,11 @@ namespace ParteeEngine {
         void drawSquare(const Vector3& position, float size = 1.0f);
         void drawCube(const Vector3& position, const Vector3& size);
         void drawTriangle(const Vector3& v1, const Vector3& v2, const Vector3& v3);
+        void drawMesh(const Mesh& mesh, const Vector3& position);
+
+        // Draws the mesh once per instance in a single submission. Nothing is copied:
+        // mesh and instances must stay valid until present().
+        void drawInstanced(const Mesh& mesh, const InstanceData* instances, size_t count);
         
         // Camera operations
         void setCamera(const Vector3& position, const Vector3& target, const Vector3& up);
@@ -26,9 +35,16 @@ namespace ParteeEngine {
         
         // Get render context for low-level operations (use sparingly)
         RenderContext& getRenderContext() { return *renderContext; }
+
+        // Commands, batches and vertices submitted by the last present()
+        const RenderStats& getFrameStats() const { return commandBuffer.getStats(); }
         
     private:
         std::unique_ptr<RenderContext> renderContext;
+        RenderCommandBuffer commandBuffer;
+
+        // Sort depth for geometry centered at position
+        float depthOf(const Vector3& position) const;
         void loadMatrix(const Matrix4& matrix);
     };
 }
\ No newline at end of file
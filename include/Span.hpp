@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace ParteeEngine {
+
+    // Non-owning view of a contiguous array, a stand-in for C++20's std::span.
+    template <typename T>
+    class Span {
+
+        public:
+            Span() = default;
+            Span(T *data, size_t size) : data_(data), size_(size) {}
+
+            template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+            Span(const Span<U> &other) : data_(other.data()), size_(other.size()) {}
+
+            template <typename U, typename Allocator, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+            Span(std::vector<U, Allocator> &vector) : data_(vector.data()), size_(vector.size()) {}
+
+            template <typename U, typename Allocator, typename = std::enable_if_t<std::is_convertible_v<const U (*)[], T (*)[]>>>
+            Span(const std::vector<U, Allocator> &vector) : data_(vector.data()), size_(vector.size()) {}
+
+            T *data() const { return data_; }
+            size_t size() const { return size_; }
+            bool empty() const { return size_ == 0; }
+
+            T &operator[](size_t index) const { return data_[index]; }
+            T *begin() const { return data_; }
+            T *end() const { return data_ + size_; }
+
+            Span subspan(size_t offset, size_t count) const { return Span(data_ + offset, count); }
+
+        private:
+            T *data_ = nullptr;
+            size_t size_ = 0;
+    };
+
+} // namespace ParteeEngine
@@ -1,39 +1,34 @@
 #pragma once
 
-#include <windows.h>
 #include <functional>
-#include <GL/gl.h>
 
 namespace ParteeEngine {
+
+    // Platform-independent window interface. Backends live in include/platform.
     class Window {
         public:
             using RenderCallback = std::function<void()>;
 
-            Window(const int width, const int height);
-            ~Window();
+            Window(const int width, const int height) : width(width), height(height) {}
+            virtual ~Window() = default;
+
+            // Runs the main loop, calling the render callback every iteration until the window closes.
+            virtual void show() = 0;
+            virtual void swapBuffers() = 0;
+
+            // Asks the main loop to return. Safe to call from any thread.
+            virtual void requestClose() = 0;
 
-            void show();
-            void setRenderCallback(RenderCallback callback);
-            void swapBuffers();
+            void setRenderCallback(RenderCallback callback) { renderCallback = callback; }
 
-            HWND getHWND() const;
-            HDC getHDC() const;
-            int getWidth() const;
-            int getHeight() const;
+            int getWidth() const { return width; }
+            int getHeight() const { return height; }
 
-        private:
+        protected:
             const int width;
             const int height;
 
-            HWND hwnd;
-            HDC hdc;
-            HGLRC hglrc; // OpenGL rendering context
             RenderCallback renderCallback;
-
-            static LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
-
-            void createWindow();
-            void setupOpenGL();
     };
 
-} // namespace ParteeEngine
\ No newline at end of file
+} // namespace ParteeEngine
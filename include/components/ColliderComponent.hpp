@@ -1,6 +1,12 @@
 #pragma once
 
+#include <cstdint>
+
 #include "Component.hpp"
+#include "Vector3.hpp"
+#include "math/Matrix4.hpp"
+#include "physics/Aabb.hpp"
+#include "physics/ColliderShape.hpp"
 
 namespace ParteeEngine 
 {
@@ -9,9 +15,50 @@ namespace ParteeEngine
     class ColliderComponent : public Component 
     {
         public:
+            using Shape = ShapeType;
 
             void requireDependencies(Entity &owner) override;
 
+            void setAABB(const Vector3 &halfExtents)
+            {
+                shape = Shape::AABB;
+                this->halfExtents = halfExtents;
+                version++;
+            }
+
+            void setBox(const Vector3 &halfExtents)
+            {
+                shape = Shape::Box;
+                this->halfExtents = halfExtents;
+                version++;
+            }
+
+            void setSphere(float radius)
+            {
+                shape = Shape::Sphere;
+                this->radius = radius;
+                version++;
+            }
+
+            Shape getShape() const { return shape; }
+            const Vector3 &getHalfExtents() const { return halfExtents; }
+            float getRadius() const { return radius; }
+
+            // Incremented by every set*() call; see TransformComponent::getVersion().
+            uint32_t getVersion() const { return version; }
+
+            // The shape placed by the entity's world matrix, and its world-space bounds.
+            ColliderShape computeShape(const Matrix4 &world) const;
+            Aabb computeBounds(const Matrix4 &world) const { return computeShape(world).getBounds(); }
+
+            // Shape center relative to the entity, in its local frame
+            Vector3 offset = Vector3(0.0f, 0.0f, 0.0f);
+
+        private:
+            Shape shape = Shape::AABB;
+            Vector3 halfExtents = Vector3(0.5f, 0.5f, 0.5f); // AABB and Box
+            float radius = 0.5f;                              // Sphere
+            uint32_t version = 0;
     };
 
-} //namespace ParteeEngine
\ No newline at end of file
+} //namespace ParteeEngine
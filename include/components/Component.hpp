@@ -12,6 +12,7 @@ namespace ParteeEngine {
         public:
             virtual ~Component() = default;
             virtual void onAttach(Entity &owner) {}
+            virtual void onDetach(Entity &owner) {}
 
             virtual void requireDependencies(Entity&) {}
 
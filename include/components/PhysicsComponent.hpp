@@ -3,6 +3,10 @@
 #include "Component.hpp"
 #include "Vector3.hpp"
 #include "events/Event.hpp"
+#include "events/EventBus.hpp"
+#include "physics/PhysicsWorld.hpp"
+#include <cstdint>
+#include <functional>
 #include <iostream>
 #include <typeindex>
 
@@ -11,24 +15,51 @@ namespace ParteeEngine
     class Entity;             // Forward declaration
     class TransformComponent; // Forward declaration
 
+    // Handle to a rigid body in the engine's PhysicsWorld, which owns the state and
+    // integrates it every tick. The body is created on attach and freed on detach.
     class PhysicsComponent : public Component {
         public:
             void requireDependencies(Entity &owner) override;
 
-            void update(Entity& owner, float dt) override;
+            void onAttach(Entity &owner) override;
 
+            void onDetach(Entity &owner) override;
+
+            // Adds a force for the next physics step only.
             void applyForce(const Vector3 &force);
 
             void applyImpulse(const Vector3 &impulse);
 
+            // Drops the forces applied since the last physics step.
             void resetAcceleration();
 
-            void onCollide(CollisionEvent e);
+            // Calls callback for each of the entity's contacts when the World's EventBus resource
+            // dispatches the tick's collisions; contacts between colliders at rest are not repeated.
+            // null stops. Notification only: contacts are resolved by the PhysicsWorld's solver.
+            // Other subscriptions to the entity's collisions are kept.
+            void setCollisionCallback(std::function<void(const CollisionEvent &)> callback);
+
+            Vector3 getVelocity() const;
+            void setVelocity(const Vector3 &velocity);
+
+            // Zero makes the body static; forces and gravity no longer move it.
+            void setMass(float mass);
+            float getMass() const;
+
+            // Continuous bodies are swept against the colliders in their way instead of jumping
+            // through them, for fast projectiles. Costs a scene query per step while fast.
+            void setContinuous(bool continuous);
+            bool isContinuous() const;
+
+            uint32_t getBody() const { return body; }
 
-            PhysicsComponent() : velocity(0.0f, 0.0f, 0.0f), acceleration(0.0f, 0.0f, 0.0f) {}
+            PhysicsComponent() = default;
 
         private:
-            Vector3 velocity;
-            Vector3 acceleration;
+            PhysicsWorld *world = nullptr;
+            EventBus *events = nullptr;
+            uint32_t body = PhysicsWorld::NoBody;
+            EntityHandle entity;
+            EventBus::Subscription collisionSubscription;
     };
-}
\ No newline at end of file
+}
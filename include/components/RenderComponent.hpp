@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Component.hpp"
+#include "Vector3.hpp"
 #include <iostream>
 #include <typeindex>
 
@@ -8,6 +9,8 @@ namespace ParteeEngine {
     class Entity; // Forward declaration
     class TransformComponent; // Forward declaration
     class Renderer; // Forward declaration
+    struct LodChain; // Forward declaration
+    struct Mesh; // Forward declaration
     
     class RenderComponent : public Component {
         public:
@@ -15,10 +18,22 @@ namespace ParteeEngine {
 
             void update(Entity& owner, float dt) override {};
 
-            void render(Entity& owner, Renderer& renderer);
+            // alpha blends between the previous and current simulation tick (see Engine::getInterpolationAlpha).
+            void render(Entity& owner, Renderer& renderer, float alpha = 1.0f);
 
             // Rendering properties
             bool visible = true;
-            enum RenderType { SQUARE, CUBE } type = SQUARE;
+            enum RenderType { SQUARE, CUBE, MESH } type = SQUARE;
+            const Mesh* mesh = nullptr; // drawn by MESH, e.g. from Engine::loadMesh(). Not owned.
+            Vector3 color = Vector3(1.0f, 1.0f, 1.0f); // multiplies the mesh colors
+
+            // Large opaque geometry (walls, terrain) drawn into the OcclusionBuffer so that
+            // whatever it hides is skipped.
+            bool occluder = false;
+
+            // Replaces the RenderType's mesh with the chain's level for the projected size,
+            // chosen each frame by the InstanceBuffer. Not owned.
+            const LodChain* lod = nullptr;
+            size_t lodLevel = 0;
     };
 }
\ No newline at end of file
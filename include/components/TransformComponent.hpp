@@ -1,97 +1,232 @@
 #pragma once
 
+#include <cstdint>
+
 #include "Vector3.hpp"
 #include "Component.hpp"
 #include "components/PhysicsComponent.hpp"
 #include "components/ColliderComponent.hpp"
+#include "math/Matrix4.hpp"
+#include "math/Quaternion.hpp"
 
 namespace ParteeEngine {
     struct TransformComponent : public Component {
-        Vector3 position;
-        Vector3 rotation;
-        Vector3 scale;
-
+        // Every mutator marks the cached world matrix dirty and flags the simulation state as
+        // changed (see consumeSimulationChange() and getVersion()). The set* functions teleport: they move the previous state along so nothing
+        // is interpolated.
         void translate(const Vector3 &delta) {
-            position.x += delta.x;
-            position.y += delta.y;
-            position.z += delta.z;
+            position += delta;
+            interpolating = true;
+            markChanged();
         };
-        void setPosition(const Vector3 &delta) {
-            position.x = delta.x;
-            position.y = delta.y;
-            position.z = delta.z;
+        void setPosition(const Vector3 &value) {
+            position = value;
+            previousPosition = position;
+            dirty = true;
+            markChanged();
         };
         void translate(const float x, const float y, const float z)
         {
-            position.x += x;
-            position.y += y;
-            position.z += z;
+            translate(Vector3(x, y, z));
         };
         void setPosition(const float x, const float y, const float z)
         {
-            position.x = x;
-            position.y = y;
-            position.z = z;
+            setPosition(Vector3(x, y, z));
         };
-        Vector3& getPosition() {
+        const Vector3& getPosition() const {
             return position;
         }
 
+        // Euler angles in degrees. With a quaternion orientation in use they rotate the
+        // orientation instead, and getRotation() only tracks the Euler inputs.
         void rotate(const Vector3 &delta) {
-            rotation.x += delta.x;
-            rotation.y += delta.y;
-            rotation.z += delta.z;
+            rotation += delta;
+            if (useQuaternion) {
+                orientation = (orientation * Quaternion::fromEuler(delta)).normalize();
+            }
+            interpolating = true;
+            markChanged();
         };
-        void setRotation(const Vector3 &delta) {
-            rotation.x = delta.x;
-            rotation.y = delta.y;
-            rotation.z = delta.z;
+        void setRotation(const Vector3 &value) {
+            rotation = value;
+            previousRotation = rotation;
+            if (useQuaternion) {
+                orientation = Quaternion::fromEuler(value);
+                previousOrientation = orientation;
+            }
+            dirty = true;
+            markChanged();
         };
         void rotate(const float x, const float y, const float z)
         {
-            rotation.x += x;
-            rotation.y += y;
-            rotation.z += z;
+            rotate(Vector3(x, y, z));
         };
         void setRotation(const float x, const float y, const float z)
         {
-            rotation.x = x;
-            rotation.y = y;
-            rotation.z = z;
+            setRotation(Vector3(x, y, z));
         };
-        Vector3& getRotation() {
+        const Vector3& getRotation() const {
             return rotation;
         }
 
+        // Switches the transform to quaternion rotation, which avoids gimbal lock and
+        // interpolates along the shorter arc.
+        void setOrientation(const Quaternion &value) {
+            orientation = value.normalize();
+            previousOrientation = orientation;
+            useQuaternion = true;
+            dirty = true;
+            markChanged();
+        }
+        // Applies delta in the local frame; switches to quaternion rotation like setOrientation().
+        void rotate(const Quaternion &delta) {
+            if (!useQuaternion) {
+                setOrientation(Quaternion::fromEuler(rotation));
+            }
+            orientation = (orientation * delta).normalize();
+            interpolating = true;
+            markChanged();
+        }
+        const Quaternion& getOrientation() const {
+            return orientation;
+        }
+        bool usesQuaternion() const {
+            return useQuaternion;
+        }
+
         void addScale(const Vector3 &delta) {
-            scale.x += delta.x;
-            scale.y += delta.y;
-            scale.z += delta.z;
+            scale += delta;
+            interpolating = true;
+            markChanged();
         };
-        void setScale(const Vector3 &delta) {
-            scale.x = delta.x;
-            scale.y = delta.y;
-            scale.z = delta.z;
+        void setScale(const Vector3 &value) {
+            scale = value;
+            previousScale = scale;
+            dirty = true;
+            markChanged();
         };
         void addScale(const float x, const float y, const float z)
         {
-            scale.x += x;
-            scale.y += y;
-            scale.z += z;
+            addScale(Vector3(x, y, z));
         };
         void setScale(const float x, const float y, const float z)
         {
-            scale.x = x;
-            scale.y = y;
-            scale.z = z;
+            setScale(Vector3(x, y, z));
         };
-        Vector3& getScale() {
+        const Vector3& getScale() const {
             return scale;
         }
 
-        TransformComponent() : position(0.0f, 0.0f, 0.0f), rotation(0.0f, 0.0f, 0.0f), scale(1.0f, 1.0f, 1.0f) {}
+        // Snapshots the state at the end of a simulation tick, for render interpolation.
+        // Free for transforms that did not move during the tick. Those that did count as
+        // changed once more, since a frame may have built their matrix at an interpolated state.
+        void storePreviousState() {
+            if (!interpolating) return;
+
+            previousPosition = position;
+            previousRotation = rotation;
+            previousScale = scale;
+            previousOrientation = orientation;
+            interpolating = false;
+            dirty = true;
+            simulationChanged = true;
+        }
+        Vector3 getInterpolatedPosition(float alpha) const {
+            return previousPosition + (position - previousPosition) * alpha;
+        }
+        Vector3 getInterpolatedRotation(float alpha) const {
+            return previousRotation + (rotation - previousRotation) * alpha;
+        }
+        Vector3 getInterpolatedScale(float alpha) const {
+            return previousScale + (scale - previousScale) * alpha;
+        }
+        Quaternion getInterpolatedOrientation(float alpha) const {
+            return Quaternion::nlerp(previousOrientation, orientation, alpha);
+        }
+
+        // Matrix relative to the parent (see TransformHierarchy) as of the last
+        // updateLocalMatrix(). For transforms without a parent this is the world matrix.
+        const Matrix4& getLocalMatrix() const {
+            return localMatrix;
+        }
+
+        // Matrix of the current simulation state, ignoring interpolation and the cache.
+        Matrix4 computeMatrix() const {
+            if (useQuaternion) {
+                return Matrix4::compose(position, orientation, scale);
+            }
+            return Matrix4::compose(position, rotation, scale);
+        }
+
+        // True if the cached matrix is stale, or depends on alpha because the transform
+        // moved during the last tick.
+        bool needsUpdate() const {
+            return dirty || interpolating;
+        }
+
+        // Forces the next updateLocalMatrix() to recompute, e.g. after reparenting.
+        void markDirty() {
+            dirty = true;
+            markChanged();
+        }
+
+        // True if the simulation state changed since the last call, so computeMatrix()
+        // may differ from what was last taken from it. Clears the flag.
+        bool consumeSimulationChange() {
+            bool changed = simulationChanged;
+            simulationChanged = false;
+            return changed;
+        }
+
+        // Incremented by every change to the simulation state, so anything derived from it
+        // can be checked for staleness without recomputing.
+        uint32_t getVersion() const {
+            return version;
+        }
+
+        // Recomputes the local matrix at the given interpolation alpha if needsUpdate().
+        // Returns whether anything was recomputed.
+        bool updateLocalMatrix(float alpha) {
+            if (!needsUpdate()) return false;
+
+            if (!interpolating) alpha = 1.0f;
+            if (useQuaternion) {
+                localMatrix = Matrix4::compose(getInterpolatedPosition(alpha), getInterpolatedOrientation(alpha), getInterpolatedScale(alpha));
+            } else {
+                localMatrix = Matrix4::compose(getInterpolatedPosition(alpha), getInterpolatedRotation(alpha), getInterpolatedScale(alpha));
+            }
+            dirty = false;
+            return true;
+        }
+
+        TransformComponent() : position(0.0f, 0.0f, 0.0f), rotation(0.0f, 0.0f, 0.0f), scale(1.0f, 1.0f, 1.0f),
+                               previousPosition(position), previousRotation(rotation), previousScale(scale) {}
 
         void update(Entity& owner, float dt) override {
         }
+
+    private:
+        Vector3 position;
+        Vector3 rotation;
+        Vector3 scale;
+        Quaternion orientation;
+
+        // State at the end of the previous simulation tick
+        Vector3 previousPosition;
+        Vector3 previousRotation;
+        Vector3 previousScale;
+        Quaternion previousOrientation;
+
+        Matrix4 localMatrix;
+        bool useQuaternion = false;
+        bool dirty = true;          // state changed since localMatrix was built
+        bool interpolating = false; // previous state differs from the current one
+        bool simulationChanged = true; // state changed since consumeSimulationChange()
+        uint32_t version = 0;
+
+        void markChanged() {
+            simulationChanged = true;
+            version++;
+        }
     };
-}
\ No newline at end of file
+}
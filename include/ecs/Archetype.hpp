@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "ecs/ComponentColumn.hpp"
+#include "ecs/ComponentType.hpp"
+#include "ecs/EntityHandle.hpp"
+
+namespace ParteeEngine {
+
+    // All entities sharing the exact same set of component types. Each component
+    // type is stored in its own contiguous column, and row i of every column
+    // belongs to entities[i]. The archetype's mask doubles as the component
+    // signature of every entity stored in it.
+    class Archetype {
+
+        public:
+            explicit Archetype(const ComponentMask &mask);
+
+            const ComponentMask &getMask() const { return mask_; }
+
+            // Component type ids in this archetype, in ascending order.
+            const std::vector<ComponentTypeId> &getTypes() const { return types_; }
+
+            bool has(ComponentTypeId type) const { return mask_.test(type); }
+
+            IComponentColumn *getColumn(ComponentTypeId type)
+            {
+                int index = columnIndex_[type];
+                return index >= 0 ? columns_[index].get() : nullptr;
+            }
+
+            template <typename T>
+            ComponentColumn<T> *getColumn();
+
+            // Registers the column for one of the mask's types. Used while building a new archetype.
+            void setColumn(ComponentTypeId type, std::unique_ptr<IComponentColumn> column);
+
+            // Appends src's row to every column shared with this archetype. Columns only
+            // present here must be filled by the caller before calling addEntity().
+            void moveFrom(Archetype &src, size_t srcRow);
+
+            // Registers entity as the owner of the newly appended row. Returns that row.
+            size_t addEntity(EntityHandle entity);
+
+            // Swap-removes row from every column. Returns the entity now occupying row, or an invalid handle.
+            EntityHandle removeRow(size_t row);
+
+            size_t size() const { return entities_.size(); }
+
+            const std::vector<EntityHandle> &getEntities() const { return entities_; }
+
+            // Cached transitions to the archetype with one component type added or removed.
+            std::array<Archetype *, MaxComponentTypes> addEdges{};
+            std::array<Archetype *, MaxComponentTypes> removeEdges{};
+
+        private:
+            ComponentMask mask_;
+            std::vector<ComponentTypeId> types_;
+
+            std::vector<std::unique_ptr<IComponentColumn>> columns_;
+            std::array<int16_t, MaxComponentTypes> columnIndex_;
+
+            std::vector<EntityHandle> entities_;
+    };
+
+    template <typename T>
+    ComponentColumn<T> *Archetype::getColumn()
+    {
+        return static_cast<ComponentColumn<T> *>(getColumn(componentTypeId<T>()));
+    }
+
+} // namespace ParteeEngine
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "components/Component.hpp"
+
+namespace ParteeEngine {
+
+    // Type-erased view of one contiguous array of components inside an archetype.
+    class IComponentColumn {
+        public:
+            virtual ~IComponentColumn() = default;
+
+            // Creates an empty column holding the same component type.
+            virtual std::unique_ptr<IComponentColumn> createEmpty() const = 0;
+
+            // Appends the component at row to dst (which must hold the same type).
+            virtual void moveTo(size_t row, IComponentColumn &dst) = 0;
+
+            // Removes row by moving the last element into its place.
+            virtual void swapRemove(size_t row) = 0;
+
+            virtual Component *get(size_t row) = 0;
+
+            virtual size_t size() const = 0;
+    };
+
+    template <typename T>
+    class ComponentColumn : public IComponentColumn {
+        public:
+            std::unique_ptr<IComponentColumn> createEmpty() const override
+            {
+                return std::make_unique<ComponentColumn<T>>();
+            }
+
+            void moveTo(size_t row, IComponentColumn &dst) override
+            {
+                static_cast<ComponentColumn<T> &>(dst).data.push_back(std::move(data[row]));
+            }
+
+            void swapRemove(size_t row) override
+            {
+                if (row + 1 != data.size()) {
+                    data[row] = std::move(data.back());
+                }
+                data.pop_back();
+            }
+
+            Component *get(size_t row) override { return &data[row]; }
+
+            size_t size() const override { return data.size(); }
+
+            T &at(size_t row) { return data[row]; }
+
+            std::vector<T> data;
+    };
+
+} // namespace ParteeEngine
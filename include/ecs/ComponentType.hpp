@@ -0,0 +1,41 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "ecs/TypeFamily.hpp"
+
+namespace ParteeEngine {
+
+    class Component;
+
+    // Upper bound on the number of distinct component types in one program.
+    constexpr size_t MaxComponentTypes = 64;
+
+    using ComponentTypeId = uint32_t;
+    using ComponentMask = std::bitset<MaxComponentTypes>;
+
+    template <typename T>
+    ComponentTypeId componentTypeId()
+    {
+        static const ComponentTypeId id = [] {
+            ComponentTypeId value = TypeFamily<Component>::id<T>();
+            if (value >= MaxComponentTypes) {
+                throw std::runtime_error("Too many component types; raise MaxComponentTypes");
+            }
+            return value;
+        }();
+        return id;
+    }
+
+    template <typename... Ts>
+    ComponentMask componentMask()
+    {
+        ComponentMask mask;
+        (mask.set(componentTypeId<Ts>()), ...);
+        return mask;
+    }
+
+} // namespace ParteeEngine
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace ParteeEngine {
+
+    // Stable reference to an entity slot. The generation is bumped every time the
+    // slot is freed, so handles to destroyed entities never alias a new one.
+    struct EntityHandle {
+        static constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+        uint32_t index = InvalidIndex;
+        uint32_t generation = 0;
+
+        constexpr EntityHandle() = default;
+        constexpr EntityHandle(uint32_t index, uint32_t generation) : index(index), generation(generation) {}
+
+        constexpr bool isValid() const { return index != InvalidIndex; }
+
+        // Packs the handle into a single 64-bit value (generation in the high bits).
+        constexpr uint64_t value() const { return (static_cast<uint64_t>(generation) << 32) | index; }
+
+        constexpr bool operator==(const EntityHandle &other) const { return index == other.index && generation == other.generation; }
+        constexpr bool operator!=(const EntityHandle &other) const { return !(*this == other); }
+        constexpr bool operator<(const EntityHandle &other) const { return value() < other.value(); }
+    };
+
+} // namespace ParteeEngine
+
+namespace std {
+    template <>
+    struct hash<ParteeEngine::EntityHandle> {
+        size_t operator()(const ParteeEngine::EntityHandle &handle) const noexcept
+        {
+            return hash<uint64_t>()(handle.value());
+        }
+    };
+}
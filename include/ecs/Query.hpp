@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>
+
+#include "ecs/Archetype.hpp"
+
+namespace ParteeEngine {
+
+    // Cached list of archetypes that contain every type in include and none in
+    // exclude. The World appends to it whenever a matching archetype is created, and
+    // entities gaining or losing components just move between archetypes, so the
+    // membership never has to be recomputed.
+    struct Query {
+        ComponentMask include;
+        ComponentMask exclude;
+        std::vector<Archetype *> archetypes;
+
+        bool matches(const ComponentMask &mask) const
+        {
+            return (mask & include) == include && (mask & exclude).none();
+        }
+
+        // Number of entities currently matching.
+        size_t size() const
+        {
+            size_t count = 0;
+            for (const Archetype *archetype : archetypes) {
+                count += archetype->size();
+            }
+            return count;
+        }
+    };
+
+} // namespace ParteeEngine
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include "ecs/ComponentType.hpp"
+
+namespace ParteeEngine {
+
+    class World;
+    class ThreadPool;
+
+    struct SystemContext {
+        World &world;
+        ThreadPool &jobs;
+        float dt;
+    };
+
+    // A unit of per-tick work together with the component types it reads and writes.
+    // The scheduler uses those declarations to decide which systems may run at the
+    // same time; systems must not add or remove components while running.
+    class System {
+
+        public:
+            using UpdateFn = std::function<void(SystemContext &)>;
+
+            System(std::string name, UpdateFn update) : name_(std::move(name)), update_(std::move(update)) {}
+
+            template <typename... Ts>
+            System &reads()
+            {
+                reads_ |= componentMask<Ts...>();
+                return *this;
+            }
+
+            template <typename... Ts>
+            System &writes()
+            {
+                writes_ |= componentMask<Ts...>();
+                return *this;
+            }
+
+            // True if the two systems touch the same component type and at least one writes it.
+            bool conflictsWith(const System &other) const
+            {
+                return (writes_ & (other.reads_ | other.writes_)).any() || (reads_ & other.writes_).any();
+            }
+
+            void run(SystemContext &context) { update_(context); }
+
+            const std::string &getName() const { return name_; }
+            const ComponentMask &getReads() const { return reads_; }
+            const ComponentMask &getWrites() const { return writes_; }
+
+        private:
+            std::string name_;
+            UpdateFn update_;
+            ComponentMask reads_;
+            ComponentMask writes_;
+    };
+
+} // namespace ParteeEngine
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ecs/System.hpp"
+
+namespace ParteeEngine {
+
+    struct JobCounter;
+
+    // Runs registered systems as a dependency graph on a ThreadPool. A system depends
+    // on every earlier-registered system it conflicts with, so registration order
+    // decides the order of conflicting systems while independent ones run in parallel.
+    class SystemScheduler {
+
+        public:
+            // The returned reference stays valid; use it to declare reads/writes.
+            System &addSystem(std::string name, System::UpdateFn update);
+
+            void run(World &world, ThreadPool &jobs, float dt);
+
+            size_t getSystemCount() const { return systems_.size(); }
+
+            // Indices of the systems that must wait for system i.
+            const std::vector<size_t> &getDependents(size_t i);
+
+        private:
+            std::vector<std::unique_ptr<System>> systems_;
+
+            std::vector<std::vector<size_t>> dependents_;
+            std::vector<int> dependencyCounts_;
+            std::unique_ptr<std::atomic<int>[]> remaining_;
+            bool dirty_ = true;
+
+            void buildGraph();
+            void launch(size_t index, SystemContext &context, JobCounter &counter);
+    };
+
+} // namespace ParteeEngine
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "ecs/EntityHandle.hpp"
+#include "math/Matrix4.hpp"
+
+namespace ParteeEngine {
+
+    class ThreadPool;
+
+    // Parent/child relationships between entities and their world matrices. Nodes are
+    // laid out breadth-first in flat arrays, so every parent precedes its children and
+    // an update is one forward sweep per depth level. Only subtrees below a node whose
+    // local matrix changed are recomputed.
+    //
+    // Reparenting moves the node and its subtree to their new levels in place: a node
+    // changes level by swapping with the boundary node of each level it crosses, so it
+    // costs about (subtree size) x (levels crossed) node swaps, and keeping the level
+    // costs nothing. A move that would swap more than a quarter of the nodes instead
+    // marks the layout for a full breadth-first rebuild by the next rebuild(). Node
+    // indices change when entities are reparented or removed.
+    class TransformHierarchy {
+
+        public:
+            // Makes child a child of parent, or a root when parent is invalid. Throws
+            // std::runtime_error if that would create a cycle.
+            void setParent(EntityHandle child, EntityHandle parent);
+
+            // Drops the entity from the hierarchy; its children become roots.
+            void remove(EntityHandle entity);
+
+            // Invalid for roots and entities outside the hierarchy.
+            EntityHandle getParent(EntityHandle entity) const;
+            std::vector<EntityHandle> getChildren(EntityHandle entity) const;
+
+            // Node of an entity with a parent or children, or -1.
+            int32_t getNode(EntityHandle entity) const;
+
+            // Re-lays out every node breadth-first if a large move asked for it since the last call.
+            void rebuild();
+
+            // Sets a node's matrix relative to its parent (its world matrix for roots). Safe to
+            // call concurrently for different nodes.
+            void setLocalMatrix(int32_t node, const Matrix4 &local);
+
+            // Recomputes the world matrices of every dirty subtree, one level at a time.
+            // Levels are split across jobs when it is not null.
+            void update(ThreadPool *jobs);
+
+            const Matrix4 &getLocalMatrix(int32_t node) const { return local_[node]; }
+            const Matrix4 &getWorldMatrix(int32_t node) const { return world_[node]; }
+
+            EntityHandle getNodeEntity(int32_t node) const { return links_[nodeEntity_[node]].entity; }
+
+            // -1 for roots.
+            int32_t getParentNode(int32_t node) const { return nodeParent_[node]; }
+
+            size_t getNodeCount() const { return nodeEntity_.size(); }
+            size_t getLevelCount() const { return levelStart_.empty() ? 0 : levelStart_.size() - 1; }
+
+            // Nodes whose world matrix the last update() recomputed.
+            size_t getUpdatedNodeCount() const { return updatedNodes_; }
+
+        private:
+            static constexpr uint32_t None = 0xFFFFFFFFu;
+
+            // Topology, indexed by entity index. Children form a doubly linked sibling list.
+            struct Link {
+                EntityHandle entity;
+                uint32_t parent = None;
+                uint32_t firstChild = None;
+                uint32_t nextSibling = None;
+                uint32_t previousSibling = None;
+                int32_t node = -1;
+                bool reparented = false;
+            };
+
+            std::vector<Link> links_;
+            bool topologyDirty_ = false;
+
+            // Breadth-first node arrays
+            std::vector<uint32_t> nodeEntity_;
+            std::vector<int32_t> nodeParent_;
+            std::vector<Matrix4> local_;
+            std::vector<Matrix4> world_;
+            std::vector<uint8_t> dirty_;
+            std::vector<size_t> levelStart_; // nodes of level d are [levelStart_[d], levelStart_[d + 1])
+            std::atomic<bool> anyDirty_{false};
+            size_t updatedNodes_ = 0;
+
+            Link *findLink(EntityHandle entity);
+            const Link *findLink(EntityHandle entity) const;
+            Link &linkFor(EntityHandle entity);
+            void unlink(uint32_t child);
+            bool isMember(const Link &link) const { return link.parent != None || link.firstChild != None; }
+
+            // In-place layout changes, used while topologyDirty_ is clear
+            size_t getLevel(int32_t node) const;
+            void swapNodes(int32_t a, int32_t b);
+            int32_t moveToLevel(int32_t node, size_t level);
+            void insertNode(uint32_t index);
+            void eraseNode(uint32_t index);
+            void placeSubtree(uint32_t index);
+            void updateMembership(uint32_t index);
+    };
+
+} // namespace ParteeEngine
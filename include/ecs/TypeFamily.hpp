@@ -0,0 +1,34 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace ParteeEngine {
+
+    // Hands out dense, sequential ids per type within a Family. The id is assigned on
+    // first use and cached in a function-local static, so lookups after that are a
+    // single load with no RTTI or hashing.
+    template <typename Family>
+    class TypeFamily {
+        public:
+            template <typename T>
+            static uint32_t id()
+            {
+                return typeId<std::remove_cv_t<std::remove_reference_t<T>>>();
+            }
+
+            static uint32_t count() { return counter_.load(); }
+
+        private:
+            template <typename T>
+            static uint32_t typeId()
+            {
+                static const uint32_t value = counter_++;
+                return value;
+            }
+
+            static inline std::atomic<uint32_t> counter_{0};
+    };
+
+} // namespace ParteeEngine
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+
+#include "Entity.hpp"
+#include "ecs/Query.hpp"
+#include "jobs/ThreadPool.hpp"
+
+namespace ParteeEngine {
+
+    // Tag used to list component types an entity must not have, e.g.
+    // engine.view<TransformComponent>(Exclude<PhysicsComponent>{}).
+    template <typename... Ts>
+    struct Exclude {};
+
+    // Iterates the entities matched by a cached Query, yielding typed component
+    // references. Cost is proportional to the number of matches, not the number
+    // of entities in the world. Must not add or remove components while iterating.
+    template <typename... Ts>
+    class View {
+
+        public:
+            View(World &world, Query &query) : world_(&world), query_(&query) {}
+
+            // Calls fn(Entity, Ts&...) or fn(Ts&...) for every matching entity.
+            template <typename Func>
+            void each(Func &&fn);
+
+            // Like each(), but splits every archetype into chunks of at most chunkSize rows and
+            // runs the chunks in parallel. fn must only touch the components it is handed.
+            template <typename Func>
+            void parallelEach(ThreadPool &jobs, size_t chunkSize, Func &&fn);
+
+            // Like parallelEach(), but fn also receives the index of its chunk first, in
+            // [0, chunkCount(chunkSize)), so each chunk can write to its own output slot.
+            template <typename Func>
+            void parallelEachChunk(ThreadPool &jobs, size_t chunkSize, Func &&fn);
+
+            size_t chunkCount(size_t chunkSize) const;
+
+            size_t size() const { return query_->size(); }
+
+            bool empty() const { return size() == 0; }
+
+            class Iterator {
+                public:
+                    using iterator_category = std::forward_iterator_tag;
+                    using value_type = std::tuple<Entity, Ts &...>;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = void;
+                    using reference = value_type;
+
+                    Iterator(World *world, Query *query, size_t archetype)
+                        : world_(world), query_(query), archetype_(archetype), row_(0)
+                    {
+                        skipEmpty();
+                    }
+
+                    value_type operator*() const
+                    {
+                        Archetype *archetype = query_->archetypes[archetype_];
+                        return value_type(Entity(*world_, archetype->getEntities()[row_]),
+                                          archetype->getColumn<Ts>()->at(row_)...);
+                    }
+
+                    Iterator &operator++()
+                    {
+                        if (++row_ >= query_->archetypes[archetype_]->size()) {
+                            ++archetype_;
+                            row_ = 0;
+                            skipEmpty();
+                        }
+                        return *this;
+                    }
+
+                    bool operator==(const Iterator &other) const { return archetype_ == other.archetype_ && row_ == other.row_; }
+                    bool operator!=(const Iterator &other) const { return !(*this == other); }
+
+                private:
+                    World *world_;
+                    Query *query_;
+                    size_t archetype_;
+                    size_t row_;
+
+                    void skipEmpty()
+                    {
+                        while (archetype_ < query_->archetypes.size() && query_->archetypes[archetype_]->size() == 0) {
+                            ++archetype_;
+                        }
+                    }
+            };
+
+            Iterator begin() const { return Iterator(world_, query_, 0); }
+            Iterator end() const { return Iterator(world_, query_, query_->archetypes.size()); }
+
+        private:
+            World *world_;
+            Query *query_;
+
+            // Calls body(chunkIndex, archetype, beginRow, endRow) for every chunk on the pool.
+            template <typename Body>
+            void runChunks(ThreadPool &jobs, size_t chunkSize, Body &&body);
+    };
+
+    template <typename... Ts>
+    template <typename Func>
+    void View<Ts...>::each(Func &&fn)
+    {
+        for (Archetype *archetype : query_->archetypes) {
+            size_t count = archetype->size();
+            if (count == 0) {
+                continue;
+            }
+
+            auto columns = std::make_tuple(archetype->getColumn<Ts>()...);
+            const std::vector<EntityHandle> &entities = archetype->getEntities();
+            for (size_t row = 0; row < count; ++row) {
+                if constexpr (std::is_invocable_v<Func, Entity, Ts &...>) {
+                    fn(Entity(*world_, entities[row]), std::get<ComponentColumn<Ts> *>(columns)->at(row)...);
+                } else {
+                    fn(std::get<ComponentColumn<Ts> *>(columns)->at(row)...);
+                }
+            }
+        }
+    }
+
+    template <typename... Ts>
+    template <typename Func>
+    void View<Ts...>::parallelEach(ThreadPool &jobs, size_t chunkSize, Func &&fn)
+    {
+        runChunks(jobs, chunkSize, [this, &fn](size_t, Archetype *archetype, size_t begin, size_t end) {
+            auto columns = std::make_tuple(archetype->getColumn<Ts>()...);
+            const std::vector<EntityHandle> &entities = archetype->getEntities();
+            for (size_t row = begin; row < end; ++row) {
+                if constexpr (std::is_invocable_v<Func, Entity, Ts &...>) {
+                    fn(Entity(*world_, entities[row]), std::get<ComponentColumn<Ts> *>(columns)->at(row)...);
+                } else {
+                    fn(std::get<ComponentColumn<Ts> *>(columns)->at(row)...);
+                }
+            }
+        });
+    }
+
+    template <typename... Ts>
+    template <typename Func>
+    void View<Ts...>::parallelEachChunk(ThreadPool &jobs, size_t chunkSize, Func &&fn)
+    {
+        runChunks(jobs, chunkSize, [this, &fn](size_t chunk, Archetype *archetype, size_t begin, size_t end) {
+            auto columns = std::make_tuple(archetype->getColumn<Ts>()...);
+            const std::vector<EntityHandle> &entities = archetype->getEntities();
+            for (size_t row = begin; row < end; ++row) {
+                if constexpr (std::is_invocable_v<Func, size_t, Entity, Ts &...>) {
+                    fn(chunk, Entity(*world_, entities[row]), std::get<ComponentColumn<Ts> *>(columns)->at(row)...);
+                } else {
+                    fn(chunk, std::get<ComponentColumn<Ts> *>(columns)->at(row)...);
+                }
+            }
+        });
+    }
+
+    template <typename... Ts>
+    size_t View<Ts...>::chunkCount(size_t chunkSize) const
+    {
+        size_t count = 0;
+        for (Archetype *archetype : query_->archetypes) {
+            count += (archetype->size() + chunkSize - 1) / chunkSize;
+        }
+        return count;
+    }
+
+    template <typename... Ts>
+    template <typename Body>
+    void View<Ts...>::runChunks(ThreadPool &jobs, size_t chunkSize, Body &&body)
+    {
+        JobCounter counter;
+        size_t chunkIndex = 0;
+        for (Archetype *archetype : query_->archetypes) {
+            size_t count = archetype->size();
+            for (size_t chunk = 0; chunk < count; chunk += chunkSize) {
+                size_t chunkEnd = std::min(chunk + chunkSize, count);
+                jobs.submit([archetype, chunk, chunkEnd, chunkIndex, &body]() {
+                    body(chunkIndex, archetype, chunk, chunkEnd);
+                }, counter);
+                ++chunkIndex;
+            }
+        }
+        jobs.wait(counter);
+    }
+
+    template <typename... Ts, typename... Excluded>
+    View<Ts...> makeView(World &world, Exclude<Excluded...> = {})
+    {
+        return View<Ts...>(world, world.getQuery(componentMask<Ts...>(), componentMask<Excluded...>()));
+    }
+
+} // namespace ParteeEngine
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "ecs/Archetype.hpp"
+#include "ecs/Query.hpp"
+#include "ecs/TypeFamily.hpp"
+
+namespace ParteeEngine {
+
+    // Owns every component in the engine. Entities with the same set of component
+    // types share an Archetype, so iterating a component combination walks
+    // contiguous arrays instead of chasing one heap allocation per component.
+    //
+    // Component pointers and references are only valid until the next structural
+    // change (adding/removing a component or creating an entity in the same archetype).
+    //
+    // Entities are addressed by generational handles. Destroyed slots go on a free
+    // list and are reused, and handles to a destroyed entity are rejected.
+    class World {
+
+        public:
+            World();
+
+            EntityHandle createEntity();
+
+            // Destroys the entity and all of its components. Returns false for stale handles.
+            bool destroyEntity(EntityHandle entity);
+
+            bool isAlive(EntityHandle entity) const;
+
+            size_t getEntityCount() const { return records_.size() - freeList_.size(); }
+
+            // Moves an already constructed component into the entity's storage.
+            template <typename T>
+            T &insertComponent(EntityHandle entity, T &&component);
+
+            template <typename T>
+            void removeComponent(EntityHandle entity);
+
+            template <typename T>
+            T *getComponent(EntityHandle entity);
+
+            template <typename T>
+            bool hasComponent(EntityHandle entity) const;
+
+            Component *getComponent(EntityHandle entity, ComponentTypeId type);
+
+            std::vector<Component *> getComponents(EntityHandle entity) const;
+
+            // Calls fn(EntityHandle, Ts&...) for every entity that has all of Ts.
+            // Must not add or remove components while iterating.
+            template <typename... Ts, typename Func>
+            void each(Func &&fn);
+
+            // Returns the cached query for the given filter, creating it on first use.
+            // The reference stays valid for the lifetime of the World.
+            Query &getQuery(const ComponentMask &include, const ComponentMask &exclude = ComponentMask{});
+
+            size_t getArchetypeCount() const { return archetypes_.size(); }
+
+            // Engine-wide objects that components reach through their entity's world, such as
+            // the PhysicsWorld holding rigid body state. The World does not own them.
+            template <typename T>
+            void setResource(T *resource);
+
+            // Returns nullptr if no resource of type T was set.
+            template <typename T>
+            T *getResource() const;
+
+        private:
+            struct EntityRecord {
+                Archetype *archetype;
+                size_t row;
+                uint32_t generation;
+            };
+
+            std::vector<EntityRecord> records_;
+            std::vector<uint32_t> freeList_;
+
+            std::vector<std::unique_ptr<Archetype>> archetypes_;
+            std::unordered_map<ComponentMask, Archetype *> archetypeIndex_;
+            Archetype *emptyArchetype_;
+
+            std::vector<std::unique_ptr<Query>> queries_;
+
+            struct ResourceFamily;
+            std::vector<void *> resources_; // indexed by TypeFamily<ResourceFamily>::id<T>()
+
+            // Returns nullptr for stale or invalid handles.
+            EntityRecord *findRecord(EntityHandle entity);
+            const EntityRecord *findRecord(EntityHandle entity) const;
+
+            // Like findRecord, but throws for stale or invalid handles.
+            EntityRecord &getRecord(EntityHandle entity);
+
+            // Builds (or finds) the archetype for mask. Columns are cloned from src,
+            // except extraType which receives extraColumn.
+            Archetype *getOrCreateArchetype(const ComponentMask &mask, Archetype &src,
+                                            ComponentTypeId extraType, std::unique_ptr<IComponentColumn> extraColumn);
+
+            template <typename T>
+            Archetype *getAddTarget(Archetype &src);
+
+            Archetype *getRemoveTarget(Archetype &src, ComponentTypeId type);
+
+            // Moves the entity's row from its current archetype into dst (which must already
+            // have had any new columns appended) and fixes up the record of the swapped entity.
+            void relocate(EntityHandle entity, Archetype &dst);
+    };
+
+    template <typename T>
+    Archetype *World::getAddTarget(Archetype &src)
+    {
+        ComponentTypeId type = componentTypeId<T>();
+        if (src.addEdges[type]) {
+            return src.addEdges[type];
+        }
+
+        ComponentMask mask = src.getMask();
+        mask.set(type);
+
+        Archetype *target = getOrCreateArchetype(mask, src, type, std::make_unique<ComponentColumn<T>>());
+        src.addEdges[type] = target;
+        target->removeEdges[type] = &src;
+        return target;
+    }
+
+    template <typename T>
+    T &World::insertComponent(EntityHandle entity, T &&component)
+    {
+        EntityRecord &record = getRecord(entity);
+        if (record.archetype->has(componentTypeId<T>())) {
+            throw std::runtime_error("Component already exists on this entity");
+        }
+
+        Archetype *target = getAddTarget<T>(*record.archetype);
+        ComponentColumn<T> *column = target->getColumn<T>();
+
+        target->moveFrom(*record.archetype, record.row);
+        column->data.push_back(std::move(component));
+        relocate(entity, *target);
+
+        return column->data.back();
+    }
+
+    template <typename T>
+    void World::removeComponent(EntityHandle entity)
+    {
+        EntityRecord *record = findRecord(entity);
+        ComponentTypeId type = componentTypeId<T>();
+        if (!record || !record->archetype->has(type)) {
+            return;
+        }
+
+        Archetype *target = getRemoveTarget(*record->archetype, type);
+        target->moveFrom(*record->archetype, record->row);
+        relocate(entity, *target);
+    }
+
+    template <typename T>
+    T *World::getComponent(EntityHandle entity)
+    {
+        EntityRecord *record = findRecord(entity);
+        if (!record) {
+            return nullptr;
+        }
+        ComponentColumn<T> *column = record->archetype->getColumn<T>();
+        return column ? &column->at(record->row) : nullptr;
+    }
+
+    template <typename T>
+    bool World::hasComponent(EntityHandle entity) const
+    {
+        const EntityRecord *record = findRecord(entity);
+        return record && record->archetype->has(componentTypeId<T>());
+    }
+
+    template <typename T>
+    void World::setResource(T *resource)
+    {
+        uint32_t type = TypeFamily<ResourceFamily>::id<T>();
+        if (type >= resources_.size()) {
+            resources_.resize(type + 1, nullptr);
+        }
+        resources_[type] = resource;
+    }
+
+    template <typename T>
+    T *World::getResource() const
+    {
+        uint32_t type = TypeFamily<ResourceFamily>::id<T>();
+        return type < resources_.size() ? static_cast<T *>(resources_[type]) : nullptr;
+    }
+
+    template <typename... Ts, typename Func>
+    void World::each(Func &&fn)
+    {
+        for (Archetype *archetype : getQuery(componentMask<Ts...>()).archetypes) {
+            if (archetype->size() == 0) {
+                continue;
+            }
+
+            auto columns = std::make_tuple(archetype->getColumn<Ts>()...);
+            const std::vector<EntityHandle> &entities = archetype->getEntities();
+            for (size_t row = 0; row < entities.size(); ++row) {
+                fn(entities[row], std::get<ComponentColumn<Ts> *>(columns)->at(row)...);
+            }
+        }
+    }
+
+} // namespace ParteeEngine
@@ -1,21 +1,45 @@
 #pragma once
-#include <typeindex>
+
+#include <type_traits>
+
+#include "Vector3.hpp"
+#include "ecs/EntityHandle.hpp"
+#include "physics/ContactManifold.hpp"
 
 namespace ParteeEngine {
-    class Entity;
 
     struct Event {
         virtual ~Event() = default;
     };
 
-    struct CollisionEvent : public Event{
-        public:
-            CollisionEvent(const Entity& first, const Entity& second) : first_(first), second_(second) {}
-            const Entity& getFirstEntity() { return first_; }
-            const Entity& getSecondEntity() { return second_; }
+    // Contact between two colliders in the last physics step. A plain value holding entity
+    // handles rather than references, so it can be copied, queued and kept around safely.
+    struct CollisionEvent {
+        static constexpr int EntityCount = 2;
+
+        EntityHandle first;       // lower entity index
+        EntityHandle second;
+        Vector3 normal;           // unit, pointing from first to second
+        int pointCount = 0;
+        bool persistent = false;  // the pair was already touching the step before
+        Vector3 points[ContactManifold::MaxPoints];
+        float depths[ContactManifold::MaxPoints] = {};
 
-        private:
-            const Entity& first_;
-            const Entity& second_;
+        CollisionEvent() = default;
+        explicit CollisionEvent(const ContactManifold &manifold)
+            : first(manifold.first), second(manifold.second), normal(manifold.normal),
+              pointCount(manifold.pointCount), persistent(manifold.persistent) {
+            for (int i = 0; i < pointCount; ++i) {
+                points[i] = manifold.points[i].position;
+                depths[i] = manifold.points[i].depth;
+            }
+        }
+
+        EntityHandle getEntity(int i) const { return i == 0 ? first : second; }
+
+        // The entity entity collided with.
+        EntityHandle getOther(EntityHandle entity) const { return entity == first ? second : first; }
     };
-}
\ No newline at end of file
+
+    static_assert(std::is_trivially_copyable_v<CollisionEvent>, "CollisionEvent is queued and copied by value");
+}
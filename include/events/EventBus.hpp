@@ -1,48 +1,423 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
-#include <unordered_map>
+#include <memory>
+#include <type_traits>
 #include <vector>
-#include <typeindex>
+
+#include "Span.hpp"
+#include "ecs/EntityHandle.hpp"
+#include "ecs/TypeFamily.hpp"
 
 namespace ParteeEngine 
 {
     class Event;
 
+    // Events that concern entities list them with a static constexpr int EntityCount and an
+    // EntityHandle getEntity(int) const, which lets subscribers listen to a single entity.
+    template <typename T, typename = void>
+    struct HasEventEntities : std::false_type {};
+
+    template <typename T>
+    struct HasEventEntities<T, std::void_t<decltype(T::EntityCount), decltype(std::declval<const T &>().getEntity(0))>>
+        : std::true_type {};
+
+    // Delivers events to the subscribers of their type. By default emit() calls them right
+    // away. Types made deferred with setDeferred() are instead copied into a preallocated
+    // per-type ring buffer and delivered in batches by dispatch(). Each Engine owns a bus
+    // (registered as a World resource) and dispatches it once per tick after the systems
+    // have run; there is no process-wide bus, so engines never drain each other's queues.
+    //
+    // Channels are indexed by TypeFamily<Event>::id<T>(), so emitting never hashes or
+    // inserts. Not thread-safe: emit from one thread at a time.
     class EventBus 
     {
         public:
+            // Called once per event.
             template <typename T>
             void subscribe(std::function<void(const T &)> callback);
 
+            // Called with every queued event of a deferred type at once (in up to two spans when
+            // the ring buffer wraps), or with a one-event span for immediate types.
             template <typename T>
-            void emit(const T &e);
+            void subscribeBatch(std::function<void(Span<const T>)> callback);
 
-            static EventBus &instance()
+            // One per-entity subscription, for unsubscribe().
+            struct Subscription
             {
-                static EventBus bus;
-                return bus;
+                EntityHandle entity;
+                uint32_t id = 0;  // 0 for none
+
+                bool isValid() const { return id != 0; }
             };
 
+            // Called once per event that concerns entity. Subscribers are looked up by entity index,
+            // so an entity's callbacks cost nothing for the events of other entities.
+            template <typename T>
+            Subscription subscribe(EntityHandle entity, std::function<void(const T &)> callback);
+
+            // Drops one subscription made by subscribe(entity, callback); the entity's others stay.
+            template <typename T>
+            void unsubscribe(Subscription subscription);
+
+            // Drops all of entity's subscriptions to T.
+            template <typename T>
+            void unsubscribe(EntityHandle entity);
+
+            // Queues events of type T until dispatch(). The ring buffer holds capacity events
+            // (rounded up to a power of two) and only grows when a tick emits more.
+            template <typename T>
+            void setDeferred(size_t capacity);
+
+            template <typename T>
+            void emit(const T &e);
+
+            // Delivers the queued events of every deferred type, type by type. Events that
+            // subscribers emit meanwhile wait for the next dispatch().
+            void dispatch()
+            {
+                for (ChannelBase *channel : deferred)
+                {
+                    channel->dispatch();
+                }
+            }
+
+            template <typename T>
+            size_t getQueuedCount() const;
+
         private:
-            std::unordered_map<std::type_index, std::vector<std::function<void(const void *)>>> subscribers;
+            struct ChannelBase
+            {
+                virtual ~ChannelBase() = default;
+                virtual void dispatch() = 0;
+            };
+
+            template <typename T>
+            struct Channel;
+
+            // Indexed by TypeFamily<Event>::id<T>(); null for types nobody subscribed to
+            std::vector<std::unique_ptr<ChannelBase>> channels;
+            std::vector<ChannelBase *> deferred;
+
+            template <typename T>
+            Channel<T> &getChannel();
+
+            template <typename T>
+            Channel<T> *findChannel() const;
     };
 
+    template <typename T>
+    struct EventBus::Channel : ChannelBase
+    {
+        // Only such types can be queued; the others are always delivered immediately
+        static constexpr bool Queueable = std::is_default_constructible_v<T> && std::is_copy_assignable_v<T>;
+
+        std::vector<std::function<void(const T &)>> subscribers;
+        std::vector<std::function<void(Span<const T>)>> batchSubscribers;
+
+        struct EntitySubscriber
+        {
+            EntityHandle entity;  // invalid once unsubscribed; the slot is reused
+            uint32_t id;
+            std::function<void(const T &)> callback;
+        };
+        std::vector<std::vector<EntitySubscriber>> entitySubscribers;  // by entity index
+        std::vector<EntitySubscriber> pendingEntitySubscribers;        // subscribed while delivering
+        size_t entitySubscriberCount = 0;
+        uint32_t lastSubscriptionId = 0;
+
+        bool isDeferred = false;
+        int delivering = 0;
+        std::vector<T> ring;  // size is a power of two
+        size_t mask = 0;
+        size_t head = 0;
+        size_t count = 0;
+        std::vector<T> late;  // emitted while dispatching into a full ring
+
+        bool hasSubscribers() const
+        {
+            return !subscribers.empty() || !batchSubscribers.empty() || entitySubscriberCount > 0;
+        }
+
+        void deliver(Span<const T> events)
+        {
+            delivering++;
+            for (auto &fn : batchSubscribers)
+            {
+                fn(events);
+            }
+            for (auto &fn : subscribers)
+            {
+                for (const T &e : events)
+                {
+                    fn(e);
+                }
+            }
+            if constexpr (HasEventEntities<T>::value)
+            {
+                if (entitySubscriberCount > 0)
+                {
+                    for (const T &e : events)
+                    {
+                        deliverToEntities(e);
+                    }
+                }
+            }
+            if (--delivering == 0)
+            {
+                for (EntitySubscriber &subscriber : pendingEntitySubscribers)
+                {
+                    if (subscriber.entity.isValid())
+                    {
+                        addEntitySubscriber(std::move(subscriber));
+                    }
+                }
+                pendingEntitySubscribers.clear();
+            }
+        }
+
+        void deliverToEntities(const T &e)
+        {
+            for (int i = 0; i < T::EntityCount; ++i)
+            {
+                EntityHandle entity = e.getEntity(i);
+                if (entity.index >= entitySubscribers.size())
+                {
+                    continue;
+                }
+                // Callbacks may unsubscribe, which only invalidates entries, never moves them
+                for (EntitySubscriber &subscriber : entitySubscribers[entity.index])
+                {
+                    if (subscriber.entity == entity)
+                    {
+                        subscriber.callback(e);
+                    }
+                }
+            }
+        }
+
+        void addEntitySubscriber(EntitySubscriber subscriber)
+        {
+            if (delivering > 0)
+            {
+                pendingEntitySubscribers.push_back(std::move(subscriber));
+                return;
+            }
+            if (subscriber.entity.index >= entitySubscribers.size())
+            {
+                entitySubscribers.resize(subscriber.entity.index + 1);
+            }
+            entitySubscriberCount++;
+            for (EntitySubscriber &slot : entitySubscribers[subscriber.entity.index])
+            {
+                if (!slot.entity.isValid())
+                {
+                    slot = std::move(subscriber);
+                    return;
+                }
+            }
+            entitySubscribers[subscriber.entity.index].push_back(std::move(subscriber));
+        }
+
+        // Drops entity's subscribers with the given id, or all of them for id 0.
+        void removeEntitySubscribers(EntityHandle entity, uint32_t id)
+        {
+            if (entity.index < entitySubscribers.size())
+            {
+                for (EntitySubscriber &slot : entitySubscribers[entity.index])
+                {
+                    if (slot.entity == entity && (id == 0 || slot.id == id))
+                    {
+                        slot.entity = EntityHandle();
+                        entitySubscriberCount--;
+                    }
+                }
+            }
+            for (EntitySubscriber &subscriber : pendingEntitySubscribers)
+            {
+                if (subscriber.entity == entity && (id == 0 || subscriber.id == id))
+                {
+                    subscriber.entity = EntityHandle();
+                }
+            }
+        }
+
+        void push(const T &e)
+        {
+            static_assert(Queueable);
+            if (count < ring.size())
+            {
+                ring[(head + count) & mask] = e;
+                count++;
+                return;
+            }
+            // Spans handed to subscribers point into the ring, so it cannot move while dispatching
+            if (delivering > 0)
+            {
+                late.push_back(e);
+                return;
+            }
+            grow();
+            ring[count++] = e;
+        }
+
+        void grow()
+        {
+            static_assert(Queueable);
+            std::vector<T> larger(ring.empty() ? 64 : ring.size() * 2);
+            for (size_t i = 0; i < count; ++i)
+            {
+                larger[i] = ring[(head + i) & mask];
+            }
+            ring.swap(larger);
+            mask = ring.size() - 1;
+            head = 0;
+        }
+
+        void dispatch() override
+        {
+            if constexpr (Queueable)
+            {
+                dispatchQueued();
+            }
+        }
+
+        void dispatchQueued()
+        {
+            size_t pending = count;
+            size_t first = pending < ring.size() - head ? pending : ring.size() - head;
+
+            if (first > 0)
+            {
+                deliver(Span<const T>(ring.data() + head, first));
+            }
+            if (pending > first)
+            {
+                deliver(Span<const T>(ring.data(), pending - first));
+            }
+
+            head = (head + pending) & mask;
+            count -= pending;
+            for (const T &e : late)
+            {
+                push(e);
+            }
+            late.clear();
+        }
+    };
+
+    template <typename T>
+    EventBus::Channel<T> &EventBus::getChannel()
+    {
+        uint32_t type = TypeFamily<Event>::id<T>();
+        if (type >= channels.size())
+        {
+            channels.resize(type + 1);
+        }
+        if (!channels[type])
+        {
+            channels[type] = std::make_unique<Channel<T>>();
+        }
+        return static_cast<Channel<T> &>(*channels[type]);
+    }
+
+    template <typename T>
+    EventBus::Channel<T> *EventBus::findChannel() const
+    {
+        uint32_t type = TypeFamily<Event>::id<T>();
+        return type < channels.size() ? static_cast<Channel<T> *>(channels[type].get()) : nullptr;
+    }
+
     template <typename T>
     void EventBus::subscribe(std::function<void(const T &)> callback) 
     {
-        auto type = std::type_index(typeid(T));
-        subscribers[type].push_back([callback](const void *e)
-                                    { callback(*static_cast<const T *>(e)); });
+        getChannel<T>().subscribers.push_back(std::move(callback));
     };
 
+    template <typename T>
+    void EventBus::subscribeBatch(std::function<void(Span<const T>)> callback)
+    {
+        getChannel<T>().batchSubscribers.push_back(std::move(callback));
+    }
+
+    template <typename T>
+    EventBus::Subscription EventBus::subscribe(EntityHandle entity, std::function<void(const T &)> callback)
+    {
+        static_assert(HasEventEntities<T>::value,
+                      "Per-entity subscriptions need EntityCount and getEntity(int) on the event type");
+        Channel<T> &channel = getChannel<T>();
+        uint32_t id = ++channel.lastSubscriptionId;
+        channel.addEntitySubscriber(typename Channel<T>::EntitySubscriber{entity, id, std::move(callback)});
+        return Subscription{entity, id};
+    }
+
+    template <typename T>
+    void EventBus::unsubscribe(Subscription subscription)
+    {
+        Channel<T> *channel = findChannel<T>();
+        if (channel && subscription.isValid())
+        {
+            channel->removeEntitySubscribers(subscription.entity, subscription.id);
+        }
+    }
+
+    template <typename T>
+    void EventBus::unsubscribe(EntityHandle entity)
+    {
+        if (Channel<T> *channel = findChannel<T>())
+        {
+            channel->removeEntitySubscribers(entity, 0);
+        }
+    }
+
+    template <typename T>
+    void EventBus::setDeferred(size_t capacity)
+    {
+        static_assert(Channel<T>::Queueable,
+                      "Deferred events are stored by value and must be default constructible and copy assignable");
+
+        Channel<T> &channel = getChannel<T>();
+        if (!channel.isDeferred)
+        {
+            channel.isDeferred = true;
+            deferred.push_back(&channel);
+        }
+
+        size_t size = 64;
+        while (size < capacity)
+        {
+            size *= 2;
+        }
+        while (channel.ring.size() < size)
+        {
+            channel.grow();
+        }
+    }
+
     template <typename T>
     void EventBus::emit(const T &e) 
     {
-        auto type = std::type_index(typeid(T));
-        for (auto& fn : subscribers[type]) 
+        Channel<T> *channel = findChannel<T>();
+        if (!channel || !channel->hasSubscribers())
+        {
+            return;
+        }
+        if constexpr (Channel<T>::Queueable)
         {
-            fn(&e);
+            if (channel->isDeferred)
+            {
+                channel->push(e);
+                return;
+            }
         }
+        channel->deliver(Span<const T>(&e, 1));
     };
-}   //namespace ParteeEngine
\ No newline at end of file
+
+    template <typename T>
+    size_t EventBus::getQueuedCount() const
+    {
+        Channel<T> *channel = findChannel<T>();
+        return channel ? channel->count + channel->late.size() : 0;
+    }
+}   //namespace ParteeEngine
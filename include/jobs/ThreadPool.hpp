@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ParteeEngine {
+
+    // Counts outstanding jobs so a caller can wait for a group of them. The first exception
+    // a job of the group throws is kept here and rethrown by ThreadPool::wait().
+    struct JobCounter {
+        std::atomic<int> pending{0};
+        std::mutex errorMutex;
+        std::exception_ptr error;
+
+        bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+    };
+
+    // Work-stealing thread pool. Every worker owns a deque: it pushes and pops its own
+    // jobs at the back and steals from the front of other workers' deques when idle.
+    // Threads that wait on a JobCounter run queued jobs instead of blocking, so
+    // waiting from inside a job (nested parallelism) cannot deadlock.
+    class ThreadPool {
+
+        public:
+            // workerCount == 0 picks hardware_concurrency() - 1 (the calling thread also helps).
+            explicit ThreadPool(size_t workerCount = 0);
+            ~ThreadPool();
+
+            ThreadPool(const ThreadPool &) = delete;
+            ThreadPool &operator=(const ThreadPool &) = delete;
+
+            void submit(std::function<void()> job, JobCounter &counter);
+
+            // Runs queued jobs on the calling thread until counter reaches zero, then rethrows the
+            // first exception a job of the counter threw. Jobs that throw still count as finished.
+            void wait(JobCounter &counter);
+
+            // Splits [begin, end) into chunks of at most grainSize and calls fn(chunkBegin, chunkEnd)
+            // for each of them in parallel. Returns once every chunk has finished.
+            void parallelFor(size_t begin, size_t end, size_t grainSize, const std::function<void(size_t, size_t)> &fn);
+
+            // Number of threads that execute jobs, including the waiting caller.
+            size_t getConcurrency() const { return queues_.size(); }
+
+        private:
+            struct Job {
+                std::function<void()> fn;
+                JobCounter *counter;
+            };
+
+            struct Queue {
+                std::mutex mutex;
+                std::deque<Job> jobs;
+            };
+
+            // Queue 0 belongs to external (non-worker) threads; worker i owns queue i + 1.
+            std::vector<std::unique_ptr<Queue>> queues_;
+            std::vector<std::thread> workers_;
+
+            std::mutex sleepMutex_;
+            std::condition_variable wakeup_;
+            std::atomic<int> queued_{0};
+            std::atomic<bool> stopping_{false};
+
+            void workerLoop(size_t index);
+
+            bool tryRunJob(size_t home);
+            bool popLocal(size_t index, Job &job);
+            bool steal(size_t thief, Job &job);
+            void execute(Job &job);
+
+            size_t currentQueue() const;
+    };
+
+} // namespace ParteeEngine
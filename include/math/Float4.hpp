@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cmath>
+
+#include "math/Simd.hpp"
+
+namespace ParteeEngine {
+
+    // Four independent float lanes, for kernels that process four objects at a time
+    // (structure-of-arrays style). Comparisons return lane masks usable with select(),
+    // any() and mask(). Scalar fallback when SSE is unavailable.
+    struct Float4 {
+#ifdef PARTEE_MATH_SSE
+        __m128 v;
+
+        Float4() : v(_mm_setzero_ps()) {}
+        Float4(float s) : v(_mm_set1_ps(s)) {}
+        explicit Float4(__m128 value) : v(value) {}
+
+        static Float4 load(const float* p) { return Float4(_mm_loadu_ps(p)); }
+        void store(float* p) const { _mm_storeu_ps(p, v); }
+        float lane(int i) const { alignas(16) float f[4]; _mm_store_ps(f, v); return f[i]; }
+
+        Float4 operator+(const Float4& o) const { return Float4(_mm_add_ps(v, o.v)); }
+        Float4 operator-(const Float4& o) const { return Float4(_mm_sub_ps(v, o.v)); }
+        Float4 operator*(const Float4& o) const { return Float4(_mm_mul_ps(v, o.v)); }
+        Float4 operator/(const Float4& o) const { return Float4(_mm_div_ps(v, o.v)); }
+        Float4 operator-() const { return Float4(_mm_sub_ps(_mm_setzero_ps(), v)); }
+
+        Float4 operator<(const Float4& o) const { return Float4(_mm_cmplt_ps(v, o.v)); }
+        Float4 operator<=(const Float4& o) const { return Float4(_mm_cmple_ps(v, o.v)); }
+        Float4 operator>(const Float4& o) const { return Float4(_mm_cmpgt_ps(v, o.v)); }
+        Float4 operator>=(const Float4& o) const { return Float4(_mm_cmpge_ps(v, o.v)); }
+        Float4 operator&(const Float4& o) const { return Float4(_mm_and_ps(v, o.v)); }
+        Float4 operator|(const Float4& o) const { return Float4(_mm_or_ps(v, o.v)); }
+
+        // Bit i is set if lane i of a mask is true.
+        int mask() const { return _mm_movemask_ps(v); }
+
+        friend Float4 min(const Float4& a, const Float4& b) { return Float4(_mm_min_ps(a.v, b.v)); }
+        friend Float4 max(const Float4& a, const Float4& b) { return Float4(_mm_max_ps(a.v, b.v)); }
+        friend Float4 abs(const Float4& a) { return Float4(_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)); }
+        friend Float4 sqrt(const Float4& a) { return Float4(_mm_sqrt_ps(a.v)); }
+
+        // Lanes of a where mask is set, of b elsewhere.
+        friend Float4 select(const Float4& mask, const Float4& a, const Float4& b)
+        {
+            return Float4(_mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)));
+        }
+#else
+        float v[4];
+
+        Float4() : v{0, 0, 0, 0} {}
+        Float4(float s) : v{s, s, s, s} {}
+
+        static Float4 load(const float* p) { Float4 r; for (int i = 0; i < 4; ++i) r.v[i] = p[i]; return r; }
+        void store(float* p) const { for (int i = 0; i < 4; ++i) p[i] = v[i]; }
+        float lane(int i) const { return v[i]; }
+
+        template <typename Op>
+        static Float4 apply(const Float4& a, const Float4& b, Op op) { Float4 r; for (int i = 0; i < 4; ++i) r.v[i] = op(a.v[i], b.v[i]); return r; }
+        template <typename Op>
+        static Float4 compare(const Float4& a, const Float4& b, Op op) { Float4 r; for (int i = 0; i < 4; ++i) r.v[i] = op(a.v[i], b.v[i]) ? 1.0f : 0.0f; return r; }
+
+        Float4 operator+(const Float4& o) const { return apply(*this, o, [](float a, float b) { return a + b; }); }
+        Float4 operator-(const Float4& o) const { return apply(*this, o, [](float a, float b) { return a - b; }); }
+        Float4 operator*(const Float4& o) const { return apply(*this, o, [](float a, float b) { return a * b; }); }
+        Float4 operator/(const Float4& o) const { return apply(*this, o, [](float a, float b) { return a / b; }); }
+        Float4 operator-() const { return apply(*this, *this, [](float a, float) { return -a; }); }
+
+        // Masks hold 1.0 for true lanes and 0.0 for false ones
+        Float4 operator<(const Float4& o) const { return compare(*this, o, [](float a, float b) { return a < b; }); }
+        Float4 operator<=(const Float4& o) const { return compare(*this, o, [](float a, float b) { return a <= b; }); }
+        Float4 operator>(const Float4& o) const { return compare(*this, o, [](float a, float b) { return a > b; }); }
+        Float4 operator>=(const Float4& o) const { return compare(*this, o, [](float a, float b) { return a >= b; }); }
+        Float4 operator&(const Float4& o) const { return compare(*this, o, [](float a, float b) { return a != 0.0f && b != 0.0f; }); }
+        Float4 operator|(const Float4& o) const { return compare(*this, o, [](float a, float b) { return a != 0.0f || b != 0.0f; }); }
+
+        int mask() const { int m = 0; for (int i = 0; i < 4; ++i) m |= (v[i] != 0.0f ? 1 : 0) << i; return m; }
+
+        friend Float4 min(const Float4& a, const Float4& b) { return apply(a, b, [](float x, float y) { return x < y ? x : y; }); }
+        friend Float4 max(const Float4& a, const Float4& b) { return apply(a, b, [](float x, float y) { return x > y ? x : y; }); }
+        friend Float4 abs(const Float4& a) { return apply(a, a, [](float x, float) { return std::fabs(x); }); }
+        friend Float4 sqrt(const Float4& a) { return apply(a, a, [](float x, float) { return std::sqrt(x); }); }
+
+        friend Float4 select(const Float4& mask, const Float4& a, const Float4& b)
+        {
+            Float4 r;
+            for (int i = 0; i < 4; ++i) r.v[i] = mask.v[i] != 0.0f ? a.v[i] : b.v[i];
+            return r;
+        }
+#endif
+
+        Float4& operator+=(const Float4& o) { return *this = *this + o; }
+        Float4& operator-=(const Float4& o) { return *this = *this - o; }
+        Float4& operator*=(const Float4& o) { return *this = *this * o; }
+
+        bool any() const { return mask() != 0; }
+    };
+
+    // Three Float4s: one 3D vector per lane.
+    struct Vector3x4 {
+        Float4 x, y, z;
+
+        Vector3x4() = default;
+        Vector3x4(const Float4& x_, const Float4& y_, const Float4& z_) : x(x_), y(y_), z(z_) {}
+
+        Vector3x4 operator+(const Vector3x4& o) const { return Vector3x4(x + o.x, y + o.y, z + o.z); }
+        Vector3x4 operator-(const Vector3x4& o) const { return Vector3x4(x - o.x, y - o.y, z - o.z); }
+        Vector3x4 operator*(const Float4& s) const { return Vector3x4(x * s, y * s, z * s); }
+
+        Float4 dot(const Vector3x4& o) const { return x * o.x + y * o.y + z * o.z; }
+    };
+
+} // namespace ParteeEngine
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+
+#include "math/Matrix4.hpp"
+
+namespace ParteeEngine {
+
+    // Batched kernels over structure-of-arrays data. They process 8 (AVX) or 4 (SSE)
+    // elements per instruction with a scalar tail, need no particular alignment, and
+    // allow the output arrays to be the input arrays.
+
+    // out = m * (x, y, z, 1) for count points.
+    void transformPoints(const Matrix4& m, const float* x, const float* y, const float* z,
+                         float* outX, float* outY, float* outZ, size_t count);
+
+    // out = m * (x, y, z, 0) for count directions.
+    void transformVectors(const Matrix4& m, const float* x, const float* y, const float* z,
+                          float* outX, float* outY, float* outZ, size_t count);
+
+    // Normalizes count vectors in place. Zero vectors stay zero.
+    void normalizeVectors(float* x, float* y, float* z, size_t count);
+
+    // out[i] = a[i] * b[i].
+    void multiplyMatrices(const Matrix4* a, const Matrix4* b, Matrix4* out, size_t count);
+
+    // out[i] = parent * b[i].
+    void multiplyMatrices(const Matrix4& parent, const Matrix4* b, Matrix4* out, size_t count);
+
+}
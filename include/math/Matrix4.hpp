@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Vector3.hpp"
+#include "math/Quaternion.hpp"
+#include "math/Vector4.hpp"
+
+namespace ParteeEngine {
+
+    // 4x4 float matrix, column-major like OpenGL: m[12..14] is the translation and a
+    // point p transforms as M * (p, 1). Each column is one aligned SIMD register.
+    struct alignas(16) Matrix4 {
+        float m[16];
+
+        // Identity
+        Matrix4();
+        explicit Matrix4(const float* columnMajor);
+
+        static Matrix4 identity() { return Matrix4(); }
+        static Matrix4 translation(const Vector3& t);
+        static Matrix4 scale(const Vector3& s);
+
+        // Euler angles in degrees, applied like RenderContext::rotate: Ry * Rx * Rz.
+        static Matrix4 rotation(const Vector3& eulerDegrees);
+        static Matrix4 rotation(const Quaternion& q);
+
+        // translation * rotation * scale, the usual model matrix.
+        static Matrix4 compose(const Vector3& position, const Vector3& eulerDegrees, const Vector3& scale);
+        static Matrix4 compose(const Vector3& position, const Quaternion& rotation, const Vector3& scale);
+
+        // Same conventions as glFrustum / gluLookAt: right-handed, camera looks down -z.
+        static Matrix4 perspective(float fovDegrees, float aspect, float nearDistance, float farDistance);
+        static Matrix4 lookAt(const Vector3& eye, const Vector3& target, const Vector3& up);
+
+        Matrix4 operator*(const Matrix4& other) const;
+        Vector4 operator*(const Vector4& v) const;
+
+        Vector3 transformPoint(const Vector3& p) const;
+        Vector3 transformVector(const Vector3& v) const;
+
+        Matrix4 transposed() const;
+
+        // General inverse; returns identity for singular matrices.
+        Matrix4 inverse() const;
+
+        // Inverse of a rotation/scale/translation matrix, much cheaper than inverse().
+        Matrix4 affineInverse() const;
+
+        Vector3 getTranslation() const { return Vector3(m[12], m[13], m[14]); }
+
+        float& operator()(int row, int column) { return m[column * 4 + row]; }
+        float operator()(int row, int column) const { return m[column * 4 + row]; }
+
+        const float* data() const { return m; }
+    };
+
+    // The products are inline: they sit in the innermost loops of the transform passes.
+    inline Matrix4 Matrix4::operator*(const Matrix4& other) const {
+        Matrix4 result;
+#ifdef PARTEE_MATH_SSE
+        // Each result column is a linear combination of this matrix's columns
+        __m128 c0 = _mm_load_ps(m);
+        __m128 c1 = _mm_load_ps(m + 4);
+        __m128 c2 = _mm_load_ps(m + 8);
+        __m128 c3 = _mm_load_ps(m + 12);
+        for (int j = 0; j < 4; ++j) {
+            const float* b = other.m + j * 4;
+            __m128 r = _mm_mul_ps(c0, _mm_set1_ps(b[0]));
+            r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(b[1])));
+            r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(b[2])));
+            r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_set1_ps(b[3])));
+            _mm_store_ps(result.m + j * 4, r);
+        }
+#else
+        for (int j = 0; j < 4; ++j) {
+            for (int i = 0; i < 4; ++i) {
+                result.m[j * 4 + i] = m[i] * other.m[j * 4] + m[4 + i] * other.m[j * 4 + 1]
+                                    + m[8 + i] * other.m[j * 4 + 2] + m[12 + i] * other.m[j * 4 + 3];
+            }
+        }
+#endif
+        return result;
+    }
+
+    inline Vector4 Matrix4::operator*(const Vector4& v) const {
+#ifdef PARTEE_MATH_SSE
+        __m128 r = _mm_mul_ps(_mm_load_ps(m), _mm_set1_ps(v.x));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(m + 4), _mm_set1_ps(v.y)));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(m + 8), _mm_set1_ps(v.z)));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(m + 12), _mm_set1_ps(v.w)));
+        return Vector4(r);
+#else
+        return Vector4(m[0] * v.x + m[4] * v.y + m[8] * v.z + m[12] * v.w,
+                       m[1] * v.x + m[5] * v.y + m[9] * v.z + m[13] * v.w,
+                       m[2] * v.x + m[6] * v.y + m[10] * v.z + m[14] * v.w,
+                       m[3] * v.x + m[7] * v.y + m[11] * v.z + m[15] * v.w);
+#endif
+    }
+
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Vector3.hpp"
+#include "math/Vector4.hpp"
+
+namespace ParteeEngine {
+
+    // Unit quaternion rotation. Angles are in degrees, like the rest of the engine.
+    struct alignas(16) Quaternion {
+        float x, y, z, w;
+
+        Quaternion(float x_ = 0, float y_ = 0, float z_ = 0, float w_ = 1) : x(x_), y(y_), z(z_), w(w_) {}
+
+        static Quaternion identity() { return Quaternion(); }
+        static Quaternion fromAxisAngle(const Vector3& axis, float degrees);
+
+        // Same convention as RenderContext::rotate: yaw (y), then pitch (x), then roll (z).
+        static Quaternion fromEuler(const Vector3& degrees);
+
+        // Hamilton product: rotates by other first, then by this.
+        Quaternion operator*(const Quaternion& other) const;
+
+        Quaternion conjugate() const { return Quaternion(-x, -y, -z, w); }
+        float dot(const Quaternion& other) const { return x * other.x + y * other.y + z * other.z + w * other.w; }
+        Quaternion normalize() const;
+
+        Vector3 rotate(const Vector3& v) const;
+
+        // Normalized linear interpolation along the shorter arc; cheap and fine for small steps.
+        static Quaternion nlerp(const Quaternion& a, const Quaternion& b, float t);
+        static Quaternion slerp(const Quaternion& a, const Quaternion& b, float t);
+    };
+
+}
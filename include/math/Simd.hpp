@@ -0,0 +1,20 @@
+#pragma once
+
+// Picks the widest instruction set the compiler targets. Every SIMD path in the math
+// module has a scalar fallback, so the engine still builds without SSE.
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define PARTEE_MATH_SSE 1
+#endif
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define PARTEE_MATH_AVX 1
+#endif
+
+namespace ParteeEngine {
+
+    constexpr float Pi = 3.14159265359f;
+    constexpr float DegreesToRadians = Pi / 180.0f;
+
+}
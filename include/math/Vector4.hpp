@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cmath>
+
+#include "Vector3.hpp"
+#include "math/Simd.hpp"
+
+namespace ParteeEngine {
+
+    // Four floats in one 16-byte aligned SIMD register.
+    struct alignas(16) Vector4 {
+        float x, y, z, w;
+
+        Vector4(float x_ = 0, float y_ = 0, float z_ = 0, float w_ = 0) : x(x_), y(y_), z(z_), w(w_) {}
+        Vector4(const Vector3& v, float w_) : x(v.x), y(v.y), z(v.z), w(w_) {}
+
+#ifdef PARTEE_MATH_SSE
+        explicit Vector4(__m128 v) { _mm_store_ps(&x, v); }
+        __m128 load() const { return _mm_load_ps(&x); }
+
+        Vector4 operator+(const Vector4& other) const { return Vector4(_mm_add_ps(load(), other.load())); }
+        Vector4 operator-(const Vector4& other) const { return Vector4(_mm_sub_ps(load(), other.load())); }
+        Vector4 operator*(const Vector4& other) const { return Vector4(_mm_mul_ps(load(), other.load())); }
+        Vector4 operator*(float scalar) const { return Vector4(_mm_mul_ps(load(), _mm_set1_ps(scalar))); }
+#else
+        Vector4 operator+(const Vector4& other) const { return Vector4(x + other.x, y + other.y, z + other.z, w + other.w); }
+        Vector4 operator-(const Vector4& other) const { return Vector4(x - other.x, y - other.y, z - other.z, w - other.w); }
+        Vector4 operator*(const Vector4& other) const { return Vector4(x * other.x, y * other.y, z * other.z, w * other.w); }
+        Vector4 operator*(float scalar) const { return Vector4(x * scalar, y * scalar, z * scalar, w * scalar); }
+#endif
+
+        Vector4& operator+=(const Vector4& other) { return *this = *this + other; }
+        Vector4& operator-=(const Vector4& other) { return *this = *this - other; }
+        Vector4& operator*=(float scalar) { return *this = *this * scalar; }
+
+        float dot(const Vector4& other) const {
+            return x * other.x + y * other.y + z * other.z + w * other.w;
+        }
+
+        float length() const {
+            return std::sqrt(dot(*this));
+        }
+
+        Vector4 normalize() const {
+            float len = length();
+            if (len > 0.0f) {
+                return *this * (1.0f / len);
+            }
+            return Vector4();
+        }
+
+        Vector3 xyz() const { return Vector3(x, y, z); }
+
+        float& operator[](int i) { return (&x)[i]; }
+        float operator[](int i) const { return (&x)[i]; }
+    };
+
+}
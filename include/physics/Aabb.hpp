@@ -0,0 +1,46 @@
+#pragma once
+
+#include <algorithm>
+
+#include "Vector3.hpp"
+
+namespace ParteeEngine {
+
+    // Axis-aligned bounding box in world space.
+    struct Aabb {
+        Vector3 min;
+        Vector3 max;
+
+        Aabb() = default;
+        Aabb(const Vector3 &min, const Vector3 &max) : min(min), max(max) {}
+
+        static Aabb fromCenter(const Vector3 &center, const Vector3 &halfExtents)
+        {
+            return Aabb(center - halfExtents, center + halfExtents);
+        }
+
+        // Touching boxes overlap.
+        bool overlaps(const Aabb &other) const
+        {
+            return min.x <= other.max.x && other.min.x <= max.x &&
+                   min.y <= other.max.y && other.min.y <= max.y &&
+                   min.z <= other.max.z && other.min.z <= max.z;
+        }
+
+        bool contains(const Aabb &other) const
+        {
+            return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z &&
+                   other.max.x <= max.x && other.max.y <= max.y && other.max.z <= max.z;
+        }
+
+        Aabb merged(const Aabb &other) const
+        {
+            return Aabb(Vector3(std::min(min.x, other.min.x), std::min(min.y, other.min.y), std::min(min.z, other.min.z)),
+                        Vector3(std::max(max.x, other.max.x), std::max(max.y, other.max.y), std::max(max.z, other.max.z)));
+        }
+
+        Vector3 getCenter() const { return (min + max) * 0.5f; }
+        Vector3 getHalfExtents() const { return (max - min) * 0.5f; }
+    };
+
+} // namespace ParteeEngine
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "physics/Aabb.hpp"
+
+namespace ParteeEngine {
+
+    class ThreadPool;
+
+    enum class BroadphaseType {
+        SpatialHash,  // uniform grid; best when objects are similar in size and spread evenly
+        SweepAndPrune // sorted intervals kept across steps; best for clustered scenes
+    };
+
+    // Two proxies whose bounds overlap, first < second.
+    struct BroadphasePair {
+        uint32_t first;
+        uint32_t second;
+    };
+
+    // Finds the overlapping pairs among a set of bounding boxes (proxies). Proxy i is
+    // bounds[i] of the last update(); keeping proxies in the same order from step to
+    // step lets implementations reuse the previous step's work.
+    class Broadphase {
+
+        public:
+            virtual ~Broadphase() = default;
+
+            // Replaces the proxy set and recomputes the pairs. jobs may be null. Pairs of two
+            // proxies flagged in resting (optional) are left out: neither moved since the last
+            // update, so the caller already knows whether they touch.
+            virtual void update(const Aabb *bounds, size_t count, ThreadPool *jobs, const uint8_t *resting = nullptr) = 0;
+
+            virtual BroadphaseType getType() const = 0;
+
+            // Every overlapping pair of the last update(), each reported once, in no particular order.
+            const std::vector<BroadphasePair> &getPairs() const { return pairs_; }
+
+        protected:
+            std::vector<BroadphasePair> pairs_;
+
+            // Per-job pair lists, appended to pairs_ by gatherPairs().
+            std::vector<std::vector<BroadphasePair>> chunkPairs_;
+
+            // Splits [0, count) into chunks of grainSize and calls fn(chunk, begin, end) for each,
+            // on jobs when it is not null. Chunk c writes its pairs to chunkPairs_[c].
+            void forEachChunk(ThreadPool *jobs, size_t count, size_t grainSize,
+                              const std::function<void(size_t, size_t, size_t)> &fn);
+            void gatherPairs();
+
+            static bool bothResting(const uint8_t *resting, uint32_t a, uint32_t b) { return resting && resting[a] && resting[b]; }
+    };
+
+    std::unique_ptr<Broadphase> createBroadphase(BroadphaseType type);
+
+} // namespace ParteeEngine
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Vector3.hpp"
+#include "physics/Aabb.hpp"
+
+namespace ParteeEngine {
+
+    enum class ShapeType {
+        AABB,   // axis-aligned box: follows position and scale, ignores rotation
+        Box,    // oriented box
+        Sphere
+    };
+
+    // A collider shape placed in world space.
+    struct ColliderShape {
+        ShapeType type = ShapeType::AABB;
+        Vector3 center;
+        Vector3 axes[3] = {Vector3(1, 0, 0), Vector3(0, 1, 0), Vector3(0, 0, 1)}; // unit box axes
+        Vector3 halfExtents;  // along axes, boxes only
+        float radius = 0.0f;  // spheres only
+
+        Aabb getBounds() const;
+
+        // Distance along a unit direction to the first surface point within maxDistance.
+        // A ray starting inside hits at distance 0 with a zero normal.
+        bool raycast(const Vector3 &origin, const Vector3 &direction, float maxDistance, float &distance, Vector3 &normal) const;
+
+        // Distance from a point to the shape, 0 inside.
+        float distanceTo(const Vector3 &point) const;
+
+        // Point of the shape nearest to point; point itself if it is inside.
+        Vector3 closestPoint(const Vector3 &point) const;
+    };
+
+} // namespace ParteeEngine
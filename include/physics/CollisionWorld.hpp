@@ -0,0 +1,150 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "ecs/EntityHandle.hpp"
+#include "physics/Aabb.hpp"
+#include "physics/Broadphase.hpp"
+#include "physics/ColliderShape.hpp"
+#include "physics/DynamicAabbTree.hpp"
+#include "physics/Narrowphase.hpp"
+
+namespace ParteeEngine {
+
+    class World;
+    class EventBus;
+    class ThreadPool;
+    class PhysicsWorld;
+    class TransformHierarchy;
+    class ColliderComponent;
+    class TransformComponent;
+
+    struct Ray {
+        Vector3 origin;
+        Vector3 direction; // normalized by the queries
+        float maxDistance = 1.0e30f;
+    };
+
+    struct RaycastHit {
+        EntityHandle entity; // invalid if nothing was hit
+        float distance = 0.0f;
+        Vector3 point;
+        Vector3 normal;      // zero when the ray starts inside the collider
+    };
+
+    struct SweepHit {
+        EntityHandle entity;   // invalid if nothing was hit
+        float fraction = 1.0f; // of the displacement travelled before touching
+        Vector3 point;         // on the hit collider
+        Vector3 normal;        // from the hit collider towards the sphere
+    };
+
+    // Tracks the bounds of every ColliderComponent and reports touching colliders once
+    // per step, as CollisionEvents emitted on the World's EventBus resource if it has one
+    // (which delivers them to the subscribers of both entities, see
+    // PhysicsComponent::setCollisionCallback). Candidate pairs from the broadphase
+    // are confirmed by the narrowphase, whose contacts the events carry.
+    //
+    // Colliders that sleep in the World's PhysicsWorld or have no body, and whose transform
+    // and collider did not change, keep last step's shape without recomputing it. Contacts
+    // between two of them are carried over instead of recomputed, and not emitted again.
+    //
+    // The colliders are also kept in a DynamicAabbTree for scene queries. Queries test
+    // the exact shapes and see the colliders as of the last step.
+    class CollisionWorld {
+
+        public:
+            explicit CollisionWorld(BroadphaseType type = BroadphaseType::SweepAndPrune);
+
+            // Takes effect on the next step.
+            void setBroadphase(BroadphaseType type);
+            Broadphase &getBroadphase() { return *broadphase_; }
+
+            // Gathers the collider bounds from their current transforms (under their parents'
+            // world matrices in hierarchy, which must hold this tick's simulation state), finds
+            // the overlapping pairs and dispatches them.
+            void step(World &world, ThreadPool &jobs, const TransformHierarchy &hierarchy);
+
+            // Candidate pairs of the last step as proxies; see getEntity() and getBounds().
+            const std::vector<BroadphasePair> &getPairs() const { return broadphase_->getPairs(); }
+
+            // Contacts of the last step, sorted by entity pair.
+            std::vector<ContactManifold> &getManifolds() { return narrowphase_.getManifolds(); }
+            const std::vector<ContactManifold> &getManifolds() const { return narrowphase_.getManifolds(); }
+
+            // Nearest collider hit by the ray.
+            bool raycast(const Ray &ray, RaycastHit &hit) const;
+
+            // Traces every ray in parallel; hits[i] answers rays[i].
+            void raycastBatch(const Ray *rays, size_t count, RaycastHit *hits, ThreadPool &jobs) const;
+
+            // Colliders whose bounds overlap the box (exact for AABB colliders).
+            void overlapBox(const Aabb &box, std::vector<EntityHandle> &out) const;
+
+            // Colliders whose shape comes within radius of center.
+            void overlapSphere(const Vector3 &center, float radius, std::vector<EntityHandle> &out) const;
+
+            // The k colliders whose shapes are nearest to point, nearest first.
+            void nearest(const Vector3 &point, size_t k, std::vector<EntityHandle> &out) const;
+
+            // First collider a sphere touches while moving from center by displacement. Candidates
+            // come from the swept bounds; the time of impact with each is found by conservative
+            // advancement against its exact shape. Colliders the sphere touches at the start and
+            // the ignored entity are skipped.
+            bool sweepSphere(const Vector3 &center, float radius, const Vector3 &displacement, EntityHandle ignore, SweepHit &hit) const;
+
+            // Shape of the entity's collider as of the last step, or nullptr.
+            const ColliderShape *findShape(EntityHandle entity) const;
+
+            // Rebuilds the query tree from scratch, e.g. after spawning a level.
+            void rebuildTree() { tree_.rebuild(); }
+            const DynamicAabbTree &getTree() const { return tree_; }
+
+            size_t getColliderCount() const { return entities_.size(); }
+            EntityHandle getEntity(uint32_t proxy) const { return entities_[proxy]; }
+            const Aabb &getBounds(uint32_t proxy) const { return bounds_[proxy]; }
+            const ColliderShape &getShape(uint32_t proxy) const { return shapes_[proxy]; }
+
+        private:
+            std::unique_ptr<Broadphase> broadphase_;
+            Narrowphase narrowphase_;
+
+            // Proxy i is entities_[i]; the view order is stable, which keeps proxies coherent between steps
+            std::vector<EntityHandle> entities_;
+            std::vector<ColliderComponent *> colliders_;
+            std::vector<TransformComponent *> transforms_;
+            std::vector<ColliderShape> shapes_;
+            std::vector<Aabb> bounds_;
+            std::vector<uint8_t> resting_; // sleeping or static, and unchanged since last step
+
+            // Last step's shapes and bounds by proxy, reused for resting colliders
+            std::vector<ColliderShape> previousShapes_;
+            std::vector<Aabb> previousBounds_;
+            std::vector<uint32_t> proxyOfPrevious_; // this step's proxy of each of last step's
+
+            // Tree leaves carry the entity index; slots map it to the entity's leaf and proxy
+            struct TreeSlot {
+                EntityHandle entity;
+                int32_t leaf = DynamicAabbTree::Null;
+                uint32_t proxy = 0;
+                uint64_t lastStep = 0;
+                Vector3 center; // of the bounds last step
+
+                // Collider state the shape was last computed from
+                uint32_t transformVersion = 0;
+                uint32_t colliderVersion = 0;
+                Vector3 offset;
+            };
+
+            DynamicAabbTree tree_;
+            std::vector<TreeSlot> slots_;
+            uint64_t stepCount_ = 0;
+
+            bool isResting(size_t proxy, const PhysicsWorld *physics, const TransformHierarchy &hierarchy) const;
+            void updateTree();
+            void dispatch(EventBus &bus);
+            const ColliderShape &shapeOfLeaf(int32_t leaf) const { return shapes_[slots_[tree_.getUserData(leaf)].proxy]; }
+    };
+
+} // namespace ParteeEngine
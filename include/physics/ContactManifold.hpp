@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Vector3.hpp"
+#include "ecs/EntityHandle.hpp"
+
+namespace ParteeEngine {
+
+    struct ContactPoint {
+        Vector3 position;         // world space, halfway between the two surfaces
+        float depth = 0.0f;       // penetration along the manifold normal, positive when overlapping
+
+        // Accumulated solver impulses, carried over from the previous step for warm starting
+        float normalImpulse = 0.0f;
+        float tangentImpulse[2] = {0.0f, 0.0f};
+    };
+
+    // Contact between two colliders: up to four points sharing one normal. The first entity
+    // always has the lower entity index, so a pair keeps its orientation from step to step.
+    struct ContactManifold {
+        static constexpr int MaxPoints = 4;
+
+        EntityHandle first;
+        EntityHandle second;
+        uint32_t firstProxy = 0;  // indices into the collision world's colliders this step
+        uint32_t secondProxy = 0;
+        Vector3 normal;           // unit, pointing from first to second
+        int pointCount = 0;
+        bool persistent = false;  // the pair was already touching last step
+        bool resting = false;     // carried over unchanged from last step, both colliders at rest
+        ContactPoint points[MaxPoints];
+
+        uint64_t key() const { return (static_cast<uint64_t>(first.index) << 32) | second.index; }
+    };
+
+} // namespace ParteeEngine
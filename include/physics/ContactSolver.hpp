@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Vector3.hpp"
+#include "physics/ContactManifold.hpp"
+
+namespace ParteeEngine {
+
+    class PhysicsWorld;
+    class ThreadPool;
+
+    // Sequential impulse (projected Gauss-Seidel) solver for the contact manifolds of a
+    // PhysicsWorld's bodies, with Coulomb friction and warm starting from the impulses
+    // the manifolds carried over. Bodies only translate: contacts act on linear velocity.
+    //
+    // Bodies connected through contacts form islands (union-find over the contact graph;
+    // static colliders do not connect). Islands without an awake body are skipped
+    // entirely, small islands are solved in parallel with each other, and large ones
+    // are split into colors of contacts that share no body, whose contacts are solved
+    // in parallel. Islands whose bodies all stayed at rest long enough fall asleep.
+    class ContactSolver {
+
+        public:
+            void setIterations(int iterations) { iterations_ = iterations; }
+            int getIterations() const { return iterations_; }
+
+            // Coulomb friction coefficient of every contact.
+            void setFriction(float friction) { friction_ = friction; }
+            float getFriction() const { return friction_; }
+
+            // Solves the contacts, changing only the velocities of world's bodies, and updates
+            // which bodies sleep. The accumulated impulses are stored in the manifolds.
+            void solve(PhysicsWorld &world, std::vector<ContactManifold> &manifolds, float dt, ThreadPool *jobs);
+
+            // Awake islands and solved contacts of the last solve().
+            size_t getIslandCount() const { return islands_.size(); }
+            size_t getContactCount() const { return constraints_.size(); }
+
+        private:
+            struct ContactConstraint {
+                ContactManifold *manifold;
+                uint32_t bodyA;   // PhysicsWorld::NoBody for static colliders
+                uint32_t bodyB;
+                float inverseMassA;
+                float inverseMassB;
+                float mass;       // effective mass, shared by every direction without rotation
+                Vector3 tangents[2];
+                float bias[ContactManifold::MaxPoints]; // target separating speed of each point
+            };
+
+            struct Island {
+                size_t bodyBegin, bodyEnd;
+                size_t contactBegin, contactEnd;
+            };
+
+            int iterations_ = 10;
+            float friction_ = 0.5f;
+
+            std::vector<uint32_t> parent_;   // union-find forest over body slots
+            std::vector<uint32_t> islandOf_; // island of each root slot
+            std::vector<Island> islands_;
+            std::vector<uint32_t> islandBodies_;
+            std::vector<uint32_t> contactIslands_;
+            std::vector<ContactConstraint> constraints_;
+            std::vector<ContactConstraint> scratch_;
+            std::vector<uint64_t> bodyColors_;     // bit c: the body has a contact of color c
+            std::vector<uint8_t> contactColors_;
+            std::vector<size_t> colorOffsets_;
+
+            uint32_t find(uint32_t body);
+            void unite(uint32_t a, uint32_t b);
+
+            void buildIslands(PhysicsWorld &world, std::vector<ContactManifold> &manifolds);
+            void solveIsland(PhysicsWorld &world, const Island &island, float dt);
+            void solveLargeIsland(PhysicsWorld &world, const Island &island, float dt, ThreadPool &jobs);
+            void updateSleep(PhysicsWorld &world, const Island &island);
+
+            // Sorts the island's contacts by color and fills colorOffsets_.
+            void colorContacts(const Island &island);
+
+            void prepare(ContactConstraint &constraint, float dt) const;
+            void warmStart(PhysicsWorld &world, const ContactConstraint &constraint) const;
+            void solveContact(PhysicsWorld &world, ContactConstraint &constraint) const;
+
+            static void setVelocity(PhysicsWorld &world, uint32_t body, const Vector3 &velocity);
+    };
+
+} // namespace ParteeEngine
@@ -0,0 +1,262 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "physics/Aabb.hpp"
+
+namespace ParteeEngine {
+
+    // Bounding volume hierarchy over proxies that move from step to step. Leaves store
+    // fattened bounds, so a proxy that moves a little stays inside its leaf and costs
+    // nothing; one that leaves it is removed and reinserted next to the sibling with
+    // the cheapest surface-area cost, and the path to the root is rebalanced with tree
+    // rotations. rebuild() rebuilds the whole tree top-down with the surface area
+    // heuristic when incremental updates have degraded it.
+    //
+    // Queries are const and may run concurrently with each other, not with updates.
+    class DynamicAabbTree {
+
+        public:
+            static constexpr int32_t Null = -1;
+
+            explicit DynamicAabbTree(float margin = 0.1f) : margin_(margin) {}
+
+            // Returns the proxy id, stable until destroyProxy().
+            int32_t createProxy(const Aabb &bounds, uint32_t userData);
+            void destroyProxy(int32_t proxy);
+
+            // Updates the bounds of a proxy that moved by displacement since the last call; the
+            // fattened bounds are stretched along it in anticipation. Returns true if the leaf had
+            // to be reinserted.
+            bool moveProxy(int32_t proxy, const Aabb &bounds, const Vector3 &displacement);
+
+            uint32_t getUserData(int32_t proxy) const { return nodes_[proxy].userData; }
+            const Aabb &getFatBounds(int32_t proxy) const { return nodes_[proxy].bounds; }
+
+            // Rebuilds the tree from its leaves with a binned surface area heuristic.
+            void rebuild();
+
+            // Calls fn(proxy) for every proxy whose fattened bounds overlap bounds, until fn returns false.
+            template <typename Func>
+            void query(const Aabb &bounds, Func &&fn) const;
+
+            // Walks the proxies whose fattened bounds a ray from origin along the unit direction
+            // crosses within maxDistance, nearest subtrees first. fn(proxy, maxDistance) returns the
+            // new maximum distance: the hit distance to clip the ray, maxDistance to ignore the
+            // proxy, or a negative value to stop.
+            template <typename Func>
+            void raycast(const Vector3 &origin, const Vector3 &direction, float maxDistance, Func &&fn) const;
+
+            struct Neighbor {
+                float distance;
+                int32_t proxy;
+
+                bool operator<(const Neighbor &other) const { return distance < other.distance; }
+            };
+
+            // The k proxies closest to point, nearest first. distance(proxy) must be exact and
+            // never smaller than the distance to the proxy's fattened bounds.
+            template <typename Func>
+            void nearest(const Vector3 &point, size_t k, Func &&distance, std::vector<Neighbor> &out) const;
+
+            size_t getProxyCount() const { return proxyCount_; }
+            int getHeight() const { return root_ == Null ? 0 : nodes_[root_].height; }
+
+            // Total surface area of the internal nodes over the root's, a measure of tree quality.
+            float getAreaRatio() const;
+
+            void setMargin(float margin) { margin_ = margin; }
+
+        private:
+            struct Node {
+                Aabb bounds;
+                uint32_t userData = 0;
+                int32_t parent = Null; // next free node while on the free list
+                int32_t child1 = Null;
+                int32_t child2 = Null;
+                int32_t height = 0;    // 0 for leaves, -1 for free nodes
+
+                bool isLeaf() const { return child1 == Null; }
+            };
+
+            std::vector<Node> nodes_;
+            int32_t root_ = Null;
+            int32_t freeList_ = Null;
+            size_t proxyCount_ = 0;
+            float margin_;
+
+            // Traversal stack that only touches the heap for very deep trees.
+            template <typename T>
+            class Stack {
+                public:
+                    void push(const T &item)
+                    {
+                        if (size_ < Capacity) {
+                            fixed_[size_++] = item;
+                        } else {
+                            overflow_.push_back(item);
+                        }
+                    }
+                    T pop()
+                    {
+                        if (!overflow_.empty()) {
+                            T item = overflow_.back();
+                            overflow_.pop_back();
+                            return item;
+                        }
+                        return fixed_[--size_];
+                    }
+                    bool empty() const { return size_ == 0 && overflow_.empty(); }
+
+                private:
+                    static constexpr size_t Capacity = 128;
+                    T fixed_[Capacity];
+                    size_t size_ = 0;
+                    std::vector<T> overflow_;
+            };
+
+            int32_t allocateNode();
+            void freeNode(int32_t node);
+            void insertLeaf(int32_t leaf);
+            void removeLeaf(int32_t leaf);
+            int32_t balance(int32_t node);
+            void refitUpwards(int32_t node);
+            int32_t buildTopDown(int32_t *leaves, size_t count);
+
+            static float surfaceArea(const Aabb &bounds);
+
+            // Entry distance of the ray into bounds, or a negative value if it misses within maxDistance.
+            static float rayDistance(const Aabb &bounds, const Vector3 &origin, const Vector3 &inverseDirection, float maxDistance);
+
+            static float pointDistance(const Aabb &bounds, const Vector3 &point);
+    };
+
+    template <typename Func>
+    void DynamicAabbTree::query(const Aabb &bounds, Func &&fn) const
+    {
+        if (root_ == Null) {
+            return;
+        }
+
+        Stack<int32_t> stack;
+        stack.push(root_);
+        while (!stack.empty()) {
+            const Node &node = nodes_[stack.pop()];
+            if (!node.bounds.overlaps(bounds)) {
+                continue;
+            }
+            if (node.isLeaf()) {
+                if (!fn(static_cast<int32_t>(&node - nodes_.data()))) {
+                    return;
+                }
+            } else {
+                stack.push(node.child1);
+                stack.push(node.child2);
+            }
+        }
+    }
+
+    template <typename Func>
+    void DynamicAabbTree::raycast(const Vector3 &origin, const Vector3 &direction, float maxDistance, Func &&fn) const
+    {
+        if (root_ == Null) {
+            return;
+        }
+
+        const float huge = std::numeric_limits<float>::max();
+        Vector3 inverseDirection(direction.x != 0.0f ? 1.0f / direction.x : huge,
+                                 direction.y != 0.0f ? 1.0f / direction.y : huge,
+                                 direction.z != 0.0f ? 1.0f / direction.z : huge);
+
+        // Nodes are pushed with their entry distance, so a hit found meanwhile prunes them on pop
+        struct Pending {
+            int32_t node;
+            float distance;
+        };
+        float rootDistance = rayDistance(nodes_[root_].bounds, origin, inverseDirection, maxDistance);
+        if (rootDistance < 0.0f) {
+            return;
+        }
+
+        Stack<Pending> stack;
+        stack.push(Pending{root_, rootDistance});
+        while (!stack.empty()) {
+            Pending pending = stack.pop();
+            if (pending.distance > maxDistance) {
+                continue;
+            }
+
+            const Node &node = nodes_[pending.node];
+            if (node.isLeaf()) {
+                maxDistance = fn(pending.node, maxDistance);
+                if (maxDistance < 0.0f) {
+                    return;
+                }
+                continue;
+            }
+
+            // Visit the nearer child first so hits clip the ray early
+            float distance1 = rayDistance(nodes_[node.child1].bounds, origin, inverseDirection, maxDistance);
+            float distance2 = rayDistance(nodes_[node.child2].bounds, origin, inverseDirection, maxDistance);
+            if (distance1 >= 0.0f && distance2 >= 0.0f) {
+                bool firstIsNearer = distance1 <= distance2;
+                stack.push(firstIsNearer ? Pending{node.child2, distance2} : Pending{node.child1, distance1});
+                stack.push(firstIsNearer ? Pending{node.child1, distance1} : Pending{node.child2, distance2});
+            } else if (distance1 >= 0.0f) {
+                stack.push(Pending{node.child1, distance1});
+            } else if (distance2 >= 0.0f) {
+                stack.push(Pending{node.child2, distance2});
+            }
+        }
+    }
+
+    template <typename Func>
+    void DynamicAabbTree::nearest(const Vector3 &point, size_t k, Func &&distance, std::vector<Neighbor> &out) const
+    {
+        out.clear();
+        if (root_ == Null || k == 0) {
+            return;
+        }
+
+        // Best-first: nodes ordered by the distance to their bounds, a lower bound for everything below
+        auto farther = [](const Neighbor &a, const Neighbor &b) { return b < a; };
+        std::priority_queue<Neighbor, std::vector<Neighbor>, decltype(farther)> open(farther);
+        std::priority_queue<Neighbor> best; // the k nearest so far, farthest on top
+
+        open.push(Neighbor{pointDistance(nodes_[root_].bounds, point), root_});
+        while (!open.empty()) {
+            Neighbor candidate = open.top();
+            open.pop();
+            if (best.size() == k && candidate.distance >= best.top().distance) {
+                break;
+            }
+
+            const Node &node = nodes_[candidate.proxy];
+            if (node.isLeaf()) {
+                float exact = distance(candidate.proxy);
+                if (best.size() < k) {
+                    best.push(Neighbor{exact, candidate.proxy});
+                } else if (exact < best.top().distance) {
+                    best.pop();
+                    best.push(Neighbor{exact, candidate.proxy});
+                }
+                continue;
+            }
+            open.push(Neighbor{pointDistance(nodes_[node.child1].bounds, point), node.child1});
+            open.push(Neighbor{pointDistance(nodes_[node.child2].bounds, point), node.child2});
+        }
+
+        out.resize(best.size());
+        for (size_t i = out.size(); i > 0; --i) {
+            out[i - 1] = best.top();
+            best.pop();
+        }
+    }
+
+} // namespace ParteeEngine
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ecs/EntityHandle.hpp"
+#include "physics/Broadphase.hpp"
+#include "physics/ColliderShape.hpp"
+#include "physics/ContactManifold.hpp"
+
+namespace ParteeEngine {
+
+    class ThreadPool;
+
+    // Exact overlap tests for broadphase candidate pairs. Pairs are sorted into batches by
+    // shape combination (sphere-sphere, sphere-box, box-box; AABBs count as boxes) and
+    // each batch is tested four pairs at a time in SIMD lanes: distance tests for spheres,
+    // a 15-axis separating axis test for boxes. Only the pairs that touch go on to
+    // scalar manifold generation (face clipping or edge-edge closest points).
+    //
+    // Manifolds are matched with the previous step's by entity pair, and points lying
+    // close to an old point inherit its accumulated impulses for warm starting.
+    class Narrowphase {
+
+        public:
+            // Points closer than this to a point of the previous step are considered the same contact
+            static constexpr float PersistentDistance = 0.05f;
+
+            static constexpr uint32_t NoProxy = UINT32_MAX;
+
+            // shapes and entities are indexed by proxy. jobs may be null. Proxies flagged in
+            // resting (optional) have not moved since the last collide(): manifolds of the last
+            // step between two of them are kept as they are and marked resting, whether or not
+            // pairs lists them. proxyOfPrevious maps the last step's proxies to this step's
+            // (NoProxy for removed ones) and is required along with resting.
+            void collide(const ColliderShape *shapes, const EntityHandle *entities,
+                         const std::vector<BroadphasePair> &pairs, ThreadPool *jobs, const uint8_t *resting = nullptr,
+                         const uint32_t *proxyOfPrevious = nullptr);
+
+            // Manifolds of the last collide(), sorted by ContactManifold::key(). Writable so a
+            // solver can store its impulses for the next step's warm start.
+            std::vector<ContactManifold> &getManifolds() { return manifolds_; }
+            const std::vector<ContactManifold> &getManifolds() const { return manifolds_; }
+
+        private:
+            // Candidate pairs of each batch, as indices into the pair list
+            std::vector<uint32_t> sphereSphere_;
+            std::vector<uint32_t> sphereBox_;
+            std::vector<uint32_t> boxBox_;
+
+            struct Task {
+                int batch;
+                size_t begin;
+                size_t end;
+            };
+            std::vector<Task> tasks_;
+            std::vector<std::vector<ContactManifold>> taskManifolds_;
+
+            std::vector<ContactManifold> manifolds_;
+            std::vector<ContactManifold> previous_;
+
+            // Manifolds of resting pairs, in key order like previous_, merged into the fresh ones
+            std::vector<ContactManifold> kept_;
+            std::vector<ContactManifold> merged_;
+
+            void warmStart();
+            void keepRestingContacts(const uint8_t *resting, const uint32_t *proxyOfPrevious);
+            void mergeKeptContacts();
+    };
+
+} // namespace ParteeEngine
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Vector3.hpp"
+#include "ecs/EntityHandle.hpp"
+#include "physics/ContactManifold.hpp"
+#include "physics/ContactSolver.hpp"
+
+namespace ParteeEngine {
+
+    class World;
+    class ThreadPool;
+    class CollisionWorld;
+
+    enum class IntegratorType {
+        SemiImplicitEuler, // v += a dt, then x += v dt
+        Verlet             // x += v dt + a dt^2 / 2, then v += a dt; exact for constant acceleration
+    };
+
+    // Rigid body state of every PhysicsComponent, stored as packed arrays (one per
+    // coordinate) so a step integrates all bodies in one SIMD pass instead of one call
+    // per entity. Components only hold their body index.
+    //
+    // Forces added with addForce() act for one step and are cleared by it. A body with
+    // zero inverse mass is static or kinematic: forces and gravity leave it alone, but it
+    // still moves with its velocity.
+    //
+    // Bodies at rest fall asleep with their island (see ContactSolver) and are skipped
+    // until a force, a velocity change or a contact with a moving body wakes them.
+    //
+    // Fast bodies can be flagged continuous: a body that would move further in one step
+    // than the radius of the sphere inscribed in its collider is swept through the
+    // CollisionWorld instead, stopping at the first collider in its way and sliding along
+    // it for the rest of the step. Other bodies pay nothing for this.
+    class PhysicsWorld {
+
+        public:
+            static constexpr uint32_t NoBody = UINT32_MAX;
+
+            uint32_t createBody(EntityHandle entity);
+            void destroyBody(uint32_t body);
+
+            // Body of the entity, or NoBody.
+            uint32_t getBody(EntityHandle entity) const;
+
+            // Integrates the velocities, resolves the contacts found by the last collision step
+            // (their impulses are stored back for warm starting), integrates the positions,
+            // sweeps the continuous bodies, and moves the TransformComponents of the entities that
+            // have a PhysicsComponent by their displacement. Clears the accumulated forces.
+            void step(World &world, ThreadPool &jobs, float dt, CollisionWorld &collisions);
+
+            // Runs only the integration, without contacts; the displacements are left in getDisplacement().
+            void integrate(float dt, ThreadPool *jobs);
+
+            void setIntegrator(IntegratorType type) { integrator_ = type; }
+            IntegratorType getIntegrator() const { return integrator_; }
+
+            // Acceleration applied to every dynamic body, zero by default.
+            void setGravity(const Vector3 &gravity) { gravity_ = gravity; }
+            const Vector3 &getGravity() const { return gravity_; }
+
+            // A body whose speed stays below velocity for steps consecutive steps, along with
+            // everything it touches, falls asleep.
+            void setSleepThreshold(float velocity, int steps);
+            void setSleepEnabled(bool enabled) { sleepEnabled_ = enabled; }
+            bool isAwake(uint32_t body) const { return awake_[body] != 0.0f; }
+            void wake(uint32_t body);
+
+            ContactSolver &getSolver() { return solver_; }
+
+            void setContinuous(uint32_t body, bool continuous);
+            bool isContinuous(uint32_t body) const { return continuous_[body] != 0; }
+
+            Vector3 getVelocity(uint32_t body) const { return Vector3(velocityX_[body], velocityY_[body], velocityZ_[body]); }
+            void setVelocity(uint32_t body, const Vector3 &velocity);
+            void addVelocity(uint32_t body, const Vector3 &delta);
+
+            Vector3 getForce(uint32_t body) const { return Vector3(forceX_[body], forceY_[body], forceZ_[body]); }
+            void addForce(uint32_t body, const Vector3 &force);
+            void clearForce(uint32_t body);
+
+            // Zero makes the body static or kinematic.
+            float getInverseMass(uint32_t body) const { return inverseMass_[body]; }
+            void setInverseMass(uint32_t body, float inverseMass);
+
+            // Movement of the body during the last integrate().
+            Vector3 getDisplacement(uint32_t body) const { return Vector3(displacementX_[body], displacementY_[body], displacementZ_[body]); }
+
+            EntityHandle getEntity(uint32_t body) const { return entities_[body]; }
+            size_t getBodyCount() const { return entities_.size() - freeList_.size(); }
+
+            // Body slots, free ones included; body indices are below this.
+            size_t getSlotCount() const { return entities_.size(); }
+
+        private:
+            friend class ContactSolver;
+
+            IntegratorType integrator_ = IntegratorType::SemiImplicitEuler;
+            Vector3 gravity_;
+            ContactSolver solver_;
+
+            bool sleepEnabled_ = true;
+            float sleepVelocity_ = 0.05f;
+            int sleepSteps_ = 30;
+
+            // One entry per body slot, padded to a multiple of four; free slots hold zeros
+            std::vector<float> velocityX_, velocityY_, velocityZ_;
+            std::vector<float> forceX_, forceY_, forceZ_;
+            std::vector<float> inverseMass_;
+            std::vector<float> awake_;           // 1 or 0, masks the integration
+            std::vector<float> displacementX_, displacementY_, displacementZ_;
+            std::vector<int> stepsAtRest_;
+            std::vector<uint8_t> continuous_;
+            size_t continuousCount_ = 0;
+
+            std::vector<EntityHandle> entities_; // invalid for free slots
+            std::vector<uint32_t> freeList_;
+            std::vector<uint32_t> bodyOfEntity_; // by entity index
+
+            void resetBody(uint32_t body);
+
+            // The two halves of integrate(); contacts are solved in between.
+            void integrateVelocities(float dt, ThreadPool *jobs);
+            void integratePositions(float dt, ThreadPool *jobs);
+
+            // Shortens the displacement of fast continuous bodies to what they can travel
+            // before hitting a collider.
+            void sweepContinuous(const CollisionWorld &collisions);
+    };
+
+} // namespace ParteeEngine
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "physics/Broadphase.hpp"
+
+namespace ParteeEngine {
+
+    // Uniform grid stored as a hash table rebuilt every step with a counting sort. Each
+    // proxy is entered in every cell it touches and pairs are tested per cell; a pair is
+    // only reported by the cell holding the minimum corner of its intersection, so it is
+    // found once however many cells the two proxies share. Proxies spanning too many
+    // cells are kept aside and tested against everything instead.
+    class SpatialHashBroadphase : public Broadphase {
+
+        public:
+            static constexpr uint32_t MaxCellsPerProxy = 64;
+
+            // cellSize <= 0 picks one from the proxies on every update.
+            explicit SpatialHashBroadphase(float cellSize = 0.0f) : cellSize_(cellSize) {}
+
+            void update(const Aabb *bounds, size_t count, ThreadPool *jobs, const uint8_t *resting = nullptr) override;
+
+            BroadphaseType getType() const override { return BroadphaseType::SpatialHash; }
+
+            void setCellSize(float cellSize) { cellSize_ = cellSize; }
+
+            // Cell size used by the last update().
+            float getCellSize() const { return usedCellSize_; }
+
+            // Proxies of the last update() too large for the grid.
+            size_t getOversizedCount() const { return oversized_.size(); }
+
+        private:
+            struct Entry {
+                int32_t x, y, z;
+                uint32_t proxy;
+            };
+
+            float cellSize_;
+            float usedCellSize_ = 0.0f;
+
+            std::vector<uint32_t> firstEntry_; // per proxy, prefix sums of the cells it touches
+            std::vector<Entry> entries_;
+            std::vector<uint32_t> entryBucket_;
+            std::vector<uint32_t> bucketStart_;
+            std::vector<uint32_t> bucketCursor_;
+            std::vector<Entry> sorted_;        // entries_ grouped by bucket
+            std::vector<uint32_t> oversized_;
+            std::vector<uint8_t> isOversized_;
+    };
+
+} // namespace ParteeEngine
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "physics/Broadphase.hpp"
+
+namespace ParteeEngine {
+
+    // Sorts the proxies by their minimum on one axis and sweeps the sorted list, testing
+    // each proxy against the following ones until their intervals stop overlapping.
+    // The order is kept between updates and re-sorted with an insertion sort, which is
+    // close to linear when objects move a little per step. The sweep axis follows the
+    // axis along which the proxies are spread the most.
+    class SweepAndPruneBroadphase : public Broadphase {
+
+        public:
+            void update(const Aabb *bounds, size_t count, ThreadPool *jobs, const uint8_t *resting = nullptr) override;
+
+            BroadphaseType getType() const override { return BroadphaseType::SweepAndPrune; }
+
+            int getAxis() const { return axis_; }
+
+        private:
+            int axis_ = 0;
+            std::vector<uint32_t> order_;   // proxies sorted by their minimum on axis_
+            std::vector<float> keys_;       // minimum on axis_, per entry of order_
+
+            // Bounds in sorted order, one array per bound so the sweep tests four candidates at once
+            std::vector<float> sortedMax_;  // on axis_
+            std::vector<float> sortedMinA_, sortedMaxA_; // on (axis_ + 1) % 3
+            std::vector<float> sortedMinB_, sortedMaxB_; // on (axis_ + 2) % 3
+
+            void chooseAxis(const Aabb *bounds, size_t count);
+            void sortProxies(const Aabb *bounds, size_t count);
+    };
+
+} // namespace ParteeEngine
@@ -0,0 +1,60 @@
+#pragma once
+
+#ifdef _WIN32
+
+#include <windows.h>
+#include <GL/gl.h>
+
+#include <vector>
+
+#include "RenderContext.hpp"
+
+namespace ParteeEngine {
+
+    // Fixed-function OpenGL backend. Requires a current GL context (see Win32Window).
+    class GLRenderContext : public RenderContext {
+    public:
+        GLRenderContext();
+        ~GLRenderContext() override;
+
+        void initialize(int width, int height) override;
+        void clear() override;
+        void present() override;
+
+        void pushMatrix() override;
+        void popMatrix() override;
+        void loadIdentity() override;
+        void translate(const Vector3& position) override;
+        void rotate(const Vector3& rotation) override;
+        void scale(const Vector3& scale) override;
+        void multMatrix(const Matrix4& matrix) override;
+
+        void setColor(float r, float g, float b, float a = 1.0f) override;
+        void drawTriangle(const Vector3& v1, const Vector3& v2, const Vector3& v3) override;
+        void drawQuad(const Vector3& v1, const Vector3& v2, const Vector3& v3, const Vector3& v4) override;
+
+        void beginTriangles() override;
+        void beginQuads() override;
+        void end() override;
+        void vertex(const Vector3& v) override;
+        void color(float r, float g, float b, float a = 1.0f) override;
+        void drawTriangles(const RenderVertex* vertices, size_t count) override;
+        void drawInstanced(const Mesh& mesh, const InstanceData* instances, size_t count) override;
+
+        void enableDepthTest(bool enable) override;
+        void setCullFace(bool enable) override;
+        void setViewport(int x, int y, int width, int height) override;
+
+        void setPerspective(float fov, float aspect, float nearDistance, float farDistance) override;
+        void setCamera(const Vector3& position, const Vector3& target, const Vector3& up) override;
+
+    private:
+        std::vector<uint32_t> tintedColors;
+
+        void setupPerspective();
+        void setupCamera();
+    };
+
+}
+
+#endif // _WIN32
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <atomic>
+
+#include "Window.hpp"
+
+namespace ParteeEngine {
+
+    // Window backend with no display. show() calls the render callback back to back,
+    // as fast as it returns, until requestClose() is called.
+    class HeadlessWindow : public Window {
+        public:
+            HeadlessWindow(const int width, const int height) : Window(width, height) {}
+
+            void show() override;
+            void swapBuffers() override {}
+            void requestClose() override { closeRequested = true; }
+
+        private:
+            std::atomic<bool> closeRequested{false};
+    };
+
+} // namespace ParteeEngine
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "RenderContext.hpp"
+
+namespace ParteeEngine {
+
+    // Render backend that draws nothing. Only the camera/projection state is kept,
+    // so the engine can run headless with the same code paths.
+    class NullRenderContext : public RenderContext {
+    public:
+        void initialize(int width, int height) override;
+        void clear() override {}
+        void present() override {}
+
+        void pushMatrix() override {}
+        void popMatrix() override {}
+        void loadIdentity() override {}
+        void translate(const Vector3&) override {}
+        void rotate(const Vector3&) override {}
+        void scale(const Vector3&) override {}
+        void multMatrix(const Matrix4&) override {}
+
+        void setColor(float, float, float, float = 1.0f) override {}
+        void drawTriangle(const Vector3&, const Vector3&, const Vector3&) override {}
+        void drawQuad(const Vector3&, const Vector3&, const Vector3&, const Vector3&) override {}
+
+        void beginTriangles() override {}
+        void beginQuads() override {}
+        void end() override {}
+        void vertex(const Vector3&) override {}
+        void color(float, float, float, float = 1.0f) override {}
+        void drawTriangles(const RenderVertex*, size_t) override {}
+        void drawInstanced(const Mesh&, const InstanceData*, size_t) override {}
+
+        void enableDepthTest(bool) override {}
+        void setCullFace(bool) override {}
+    };
+
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <memory>
+
+namespace ParteeEngine {
+
+    class Window;
+    class RenderContext;
+    class ThreadPool;
+
+    enum class PlatformBackend {
+        Native,   // OS window + OpenGL (Win32/WGL); falls back to Headless where unavailable
+        Headless, // no window, no GPU; simulation only
+        Software  // no window; frames rendered on the CPU into an in-memory framebuffer
+    };
+
+    // Resolves Native to the backend actually available on this build.
+    PlatformBackend resolveBackend(PlatformBackend requested);
+
+    std::unique_ptr<Window> createWindow(PlatformBackend backend, int width, int height);
+
+    // Must be called after createWindow so a native GL context is current.
+    // jobs is used by backends that render on the CPU and may be null.
+    std::unique_ptr<RenderContext> createRenderContext(PlatformBackend backend, ThreadPool* jobs);
+
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "RenderContext.hpp"
+#include "math/Matrix4.hpp"
+
+namespace ParteeEngine {
+
+    class ThreadPool;
+
+    // CPU rasterizer writing to an in-memory RGBA8 framebuffer. Draw calls only
+    // transform, clip and cull triangles; present() bins them into screen tiles and
+    // rasterizes the tiles in parallel with SIMD edge functions and a depth buffer.
+    class SoftwareRenderContext : public RenderContext {
+    public:
+        static constexpr int TileSize = 64;
+
+        // jobs may be null, in which case tiles are rasterized on the calling thread.
+        explicit SoftwareRenderContext(ThreadPool* jobs = nullptr);
+
+        void initialize(int width, int height) override;
+        void clear() override;
+        void present() override;
+
+        void pushMatrix() override;
+        void popMatrix() override;
+        void loadIdentity() override;
+        void translate(const Vector3& position) override;
+        void rotate(const Vector3& rotation) override;
+        void scale(const Vector3& scale) override;
+        void multMatrix(const Matrix4& matrix) override;
+
+        void setColor(float r, float g, float b, float a = 1.0f) override;
+        void drawTriangle(const Vector3& v1, const Vector3& v2, const Vector3& v3) override;
+        void drawQuad(const Vector3& v1, const Vector3& v2, const Vector3& v3, const Vector3& v4) override;
+
+        void beginTriangles() override;
+        void beginQuads() override;
+        void end() override;
+        void vertex(const Vector3& v) override;
+        void color(float r, float g, float b, float a = 1.0f) override;
+        void drawTriangles(const RenderVertex* vertices, size_t count) override;
+        void drawInstanced(const Mesh& mesh, const InstanceData* instances, size_t count) override;
+
+        void enableDepthTest(bool enable) override { depthTest = enable; }
+        void setCullFace(bool enable) override { cullFace = enable; }
+        void setViewport(int x, int y, int width, int height) override;
+
+        void setPerspective(float fov, float aspect, float nearDistance, float farDistance) override;
+        void setCamera(const Vector3& position, const Vector3& target, const Vector3& up) override;
+
+        // Framebuffer with getStride() pixels per row, packed as 0xAABBGGRR. Complete after present().
+        const std::vector<uint32_t>& getColorBuffer() const { return colorBuffer; }
+        const std::vector<float>& getDepthBuffer() const { return depthBuffer; }
+        int getStride() const { return stride; }
+
+        // Triangles that survived clipping and culling in the last presented frame.
+        size_t getTriangleCount() const { return presentedTriangles; }
+
+        // Writes the framebuffer as a binary PPM. Returns false if the file cannot be opened.
+        bool savePPM(const std::string& path) const;
+
+    private:
+        struct ScreenTriangle {
+            float x[3], y[3], z[3];
+            uint32_t color;
+        };
+
+        ThreadPool* jobs;
+
+        Matrix4 projection;
+        Matrix4 view;
+        std::vector<Matrix4> matrixStack; // back() is the current modelview
+        Matrix4 modelViewProjection;
+        bool mvpDirty;
+
+        uint32_t currentColor;
+        bool depthTest;
+        bool cullFace;
+
+        enum class Primitive { None, Triangles, Quads } primitive;
+        std::vector<Vector3> pending;
+
+        std::vector<ScreenTriangle> triangles;
+        std::vector<std::vector<uint32_t>> bins;
+        int tilesX, tilesY;
+        int stride, paddedHeight;
+        size_t presentedTriangles;
+
+        std::vector<uint32_t> colorBuffer;
+        std::vector<float> depthBuffer;
+        uint32_t clearColor;
+
+        void resizeTargets();
+        void rebuildProjection();
+        void rebuildView();
+
+        void submitTriangle(const Vector3& v1, const Vector3& v2, const Vector3& v3);
+        void setupTriangle(const float* a, const float* b, const float* c);
+        void rasterizeTile(int tileIndex);
+    };
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#ifdef _WIN32
+
+#include <windows.h>
+#include <GL/gl.h>
+
+#include "Window.hpp"
+
+namespace ParteeEngine {
+    class Win32Window : public Window {
+        public:
+            Win32Window(const int width, const int height);
+            ~Win32Window() override;
+
+            void show() override;
+            void swapBuffers() override;
+            void requestClose() override;
+
+            HWND getHWND() const;
+            HDC getHDC() const;
+
+        private:
+            HWND hwnd;
+            HDC hdc;
+            HGLRC hglrc; // OpenGL rendering context
+
+            static LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+
+            void createWindow();
+            void setupOpenGL();
+    };
+
+} // namespace ParteeEngine
+
+#endif // _WIN32
@@ -1,54 +1,236 @@
 #include "Engine.hpp"
+
+#include <cmath>
+
+#include "ObjLoader.hpp"
 #include "Window.hpp"
 #include "Renderer.hpp"
 #include "Vector3.hpp"
+#include "math/Simd.hpp"
+#include "jobs/ThreadPool.hpp"
+#include "components/TransformComponent.hpp"
 #include "components/RenderComponent.hpp"
 #include "components/PhysicsComponent.hpp"
 #include "components/ColliderComponent.hpp"
+#include "events/EventBus.hpp"
 
 namespace ParteeEngine {
 
-    Engine::Engine(int width, int height) : width(width), height(height) {
-        window = new Window(width, height);
-        renderer = new Renderer();
+    Engine::Engine(int width, int height, PlatformBackend requestedBackend)
+        : width(width), height(height), backend(resolveBackend(requestedBackend)) {
+        window = createWindow(backend, width, height);
+        jobs = std::make_unique<ThreadPool>();
+        renderer = std::make_unique<Renderer>(createRenderContext(backend, jobs.get()));
+
+        // PhysicsComponents allocate their bodies and subscribe to collisions through the world
+        world.setResource(&physics);
+        world.setResource(&events);
+
+        // Collisions are queued during the tick and delivered together after it
+        events.setDeferred<CollisionEvent>(1024);
+
+        // A low resolution is enough to find what occluders hide
+        occlusion.resize(256, 256 * height / width);
+        registerDefaultSystems();
         
         // Initialize the renderer after OpenGL context is created
         renderer->initialize(width, height);
 
-        window->setRenderCallback([&]() {
-            static int frameCount = 0;
-            frameCount++;
-            
-            // Clear the screen
-            renderer->clear();
-
-            for (Entity &e : entities) { e.updateComponent<PhysicsComponent>(0.0016f); }
-
-            for (Entity &e : entities) { e.updateComponent<ColliderComponent>(0.0016f); }
-
-            // Update and render entities
-            for (Entity& e : entities) {
-                auto renderComp = e.getComponent<RenderComponent>();
-                if (renderComp) renderComp->render(e, *renderer);
-            }
-            
-            // Present the frame
-            renderer->present();
-        });
+        if (backend == PlatformBackend::Headless) {
+            // Nothing to display, so simulate as fast as the ticks complete
+            window->setRenderCallback([&]() { update(); });
+        } else if (backend == PlatformBackend::Software) {
+            // Offscreen: one tick and one rendered frame per iteration
+            window->setRenderCallback([&]() { update(); render(1.0f); });
+        } else {
+            window->setRenderCallback([&]() { frame(); });
+        }
     }
 
     void Engine::start() {
+        lastFrameTime = std::chrono::steady_clock::now();
+        accumulator = 0.0;
         window->show();
     }
 
-    Entity& Engine::createEntity() {
-        int newID = static_cast<int>(entities.size());
-        entities.emplace_back(newID);
-        return entities.back();
+    void Engine::run(uint64_t ticks) {
+        for (uint64_t i = 0; i < ticks; ++i) {
+            update();
+            if (backend == PlatformBackend::Software) render(1.0f);
+        }
+    }
+
+    void Engine::stop() {
+        window->requestClose();
+    }
+
+    void Engine::setTickRate(float ticksPerSecond) {
+        fixedDelta = 1.0f / ticksPerSecond;
+    }
+
+    void Engine::update() {
+        // Keep the previous tick's state around for render interpolation
+        view<TransformComponent>().parallelEach(*jobs, 4096, [](TransformComponent &transform) {
+            transform.storePreviousState();
+        });
+
+        scheduler.run(world, *jobs, fixedDelta);
+
+        // Deliver the events systems queued during the tick
+        events.dispatch();
+        tickCount++;
+    }
+
+    void Engine::frame() {
+        auto now = std::chrono::steady_clock::now();
+        double frameTime = std::chrono::duration<double>(now - lastFrameTime).count();
+        lastFrameTime = now;
+
+        accumulator += frameTime;
+
+        int substeps = 0;
+        while (accumulator >= fixedDelta && substeps < maxSubsteps) {
+            update();
+            accumulator -= fixedDelta;
+            substeps++;
+        }
+
+        // Spiral-of-death protection: drop whatever time the capped substeps could not cover
+        if (accumulator >= fixedDelta) {
+            accumulator = 0.0;
+        }
+        interpolationAlpha = static_cast<float>(accumulator / fixedDelta);
+
+        render(interpolationAlpha);
+    }
+
+    void Engine::render(float alpha) {
+        // Clear the screen
+        renderer->clear();
+
+        // Render entities at their interpolated state, one instanced draw per mesh
+        updateWorldMatrices(alpha);
+        const RenderContext& context = renderer->getRenderContext();
+        Matrix4 viewProjection = context.getViewProjection();
+        Frustum frustum = Frustum::fromMatrix(viewProjection);
+        occlusion.clear(viewProjection);
+
+        RenderView camera;
+        camera.frustum = &frustum;
+        camera.occlusion = &occlusion;
+        camera.cameraPosition = context.getCameraPosition();
+        camera.projectionScale = 1.0f / std::tan(context.getFov() * 0.5f * Pi / 180.0f);
+        instanceBuffer.build(view<RenderComponent, TransformComponent>(), *jobs, hierarchy, camera);
+        for (const InstanceGroup& group : instanceBuffer.getGroups()) {
+            renderer->drawInstanced(*group.mesh, group.instances.data(), group.instances.size());
+        }
+
+        // Present the frame
+        renderer->present();
+    }
+
+    void Engine::updateWorldMatrices(float alpha) {
+        hierarchy.rebuild();
+
+        auto transforms = view<TransformComponent>();
+        std::vector<size_t> updated(transforms.chunkCount(4096), 0);
+        transforms.parallelEachChunk(*jobs, 4096, [&](size_t chunk, Entity e, TransformComponent &transform) {
+            if (!transform.updateLocalMatrix(alpha)) return;
+            updated[chunk]++;
+
+            int32_t node = hierarchy.getNode(e.getID());
+            if (node >= 0) hierarchy.setLocalMatrix(node, transform.getLocalMatrix());
+        });
+
+        updatedTransformCount = 0;
+        for (size_t count : updated) updatedTransformCount += count;
+
+        // Parents before children, only below changed nodes
+        hierarchy.update(jobs.get());
+    }
+
+    void Engine::updateSimulationMatrices(ThreadPool &jobs) {
+        hierarchy.rebuild();
+        if (hierarchy.getNodeCount() == 0) return;
+
+        // Only transforms changed since the last tick push their matrix, so resting subtrees
+        // are not recomputed
+        view<TransformComponent>().parallelEachChunk(jobs, 4096, [this](size_t, Entity e, TransformComponent &transform) {
+            if (!transform.consumeSimulationChange()) return;
+
+            int32_t node = hierarchy.getNode(e.getID());
+            if (node >= 0) hierarchy.setLocalMatrix(node, transform.computeMatrix());
+        });
+        hierarchy.update(&jobs);
+    }
+
+    void Engine::registerDefaultSystems() {
+        addSystem("physics", [this](SystemContext &ctx) {
+            physics.step(ctx.world, ctx.jobs, ctx.dt, collisions);
+        }).writes<TransformComponent, PhysicsComponent>();
+
+        addSystem("collider", [this](SystemContext &ctx) {
+            // Parented colliders are placed under their parents' world matrices of this tick,
+            // after physics has moved them. Pushing them clears the transforms' change flags,
+            // hence the write access.
+            updateSimulationMatrices(ctx.jobs);
+            collisions.step(ctx.world, ctx.jobs, hierarchy);
+        }).reads<ColliderComponent>().writes<TransformComponent, PhysicsComponent>();
+    }
+
+    System& Engine::addSystem(std::string name, System::UpdateFn update) {
+        return scheduler.addSystem(std::move(name), std::move(update));
+    }
+
+    const Mesh& Engine::loadMesh(const std::string& path) {
+        std::unique_ptr<Mesh>& mesh = meshes[path];
+        if (!mesh) mesh = std::make_unique<Mesh>(loadObj(path, jobs.get()));
+        return *mesh;
+    }
+
+    Entity Engine::createEntity() {
+        return Entity(world, world.createEntity());
+    }
+
+    void Engine::destroyEntity(Entity entity) {
+        if (!entity.isAlive()) return;
+
+        for (Component* component : entity.getComponents()) {
+            component->onDetach(entity);
+        }
+
+        // Orphaned children become roots; their transforms now apply in world space
+        for (EntityHandle child : hierarchy.getChildren(entity.getID())) {
+            if (TransformComponent *transform = getEntity(child).getComponent<TransformComponent>()) transform->markDirty();
+        }
+        hierarchy.remove(entity.getID());
+        world.destroyEntity(entity.getID());
+    }
+
+    Entity Engine::getEntity(EntityHandle handle) {
+        return Entity(world, handle);
+    }
+
+    void Engine::setParent(Entity child, Entity parent) {
+        hierarchy.setParent(child.getID(), parent.getID());
+
+        // Both may have joined the hierarchy and need their local matrix pushed to it
+        child.ensureComponent<TransformComponent>();
+        parent.ensureComponent<TransformComponent>();
+        child.getComponent<TransformComponent>()->markDirty();
+        parent.getComponent<TransformComponent>()->markDirty();
+    }
+
+    void Engine::clearParent(Entity child) {
+        EntityHandle parent = hierarchy.getParent(child.getID());
+        hierarchy.setParent(child.getID(), EntityHandle());
+
+        // The former parent may have left the hierarchy with its last child
+        if (TransformComponent *transform = child.getComponent<TransformComponent>()) transform->markDirty();
+        if (TransformComponent *transform = getEntity(parent).getComponent<TransformComponent>()) transform->markDirty();
     }
     
     Engine::~Engine() {
-        delete renderer;
-        delete window;
+        // Members are destroyed in reverse order: jobs, then the renderer, then the window owning its GL context
     }
 }
\ No newline at end of file
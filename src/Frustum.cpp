@@ -0,0 +1,52 @@
+#include "Frustum.hpp"
+
+#include "RenderContext.hpp"
+
+namespace ParteeEngine {
+
+    Frustum Frustum::fromMatrix(const Matrix4& viewProjection) {
+        // Gribb-Hartmann: each plane is the last row of the matrix plus or minus another row
+        const Matrix4& m = viewProjection;
+        auto row = [&](int i) { return Vector4(m(i, 0), m(i, 1), m(i, 2), m(i, 3)); };
+        Vector4 x = row(0), y = row(1), z = row(2), w = row(3);
+        const Vector4 sides[SideCount] = {w + x, w - x, w + y, w - y, w + z, w - z};
+
+        Frustum frustum;
+        for (int i = 0; i < SideCount; ++i) {
+            Vector3 normal(sides[i].x, sides[i].y, sides[i].z);
+            float length = normal.length();
+            float scale = length > 0.0f ? 1.0f / length : 0.0f;
+            frustum.planes[i].normal = normal * scale;
+            frustum.planes[i].distance = sides[i].w * scale;
+        }
+        return frustum;
+    }
+
+    Frustum Frustum::fromCamera(const RenderContext& context) {
+        return fromMatrix(context.getViewProjection());
+    }
+
+    bool Frustum::intersects(const Aabb& box) const {
+        Vector3 center = box.getCenter();
+        Vector3 halfExtents = box.getHalfExtents();
+        for (const Plane& plane : planes) {
+            // Distance of the box's most inward corner
+            float radius = std::fabs(plane.normal.x) * halfExtents.x + std::fabs(plane.normal.y) * halfExtents.y
+                         + std::fabs(plane.normal.z) * halfExtents.z;
+            if (plane.signedDistance(center) + radius < 0.0f) return false;
+        }
+        return true;
+    }
+
+    int Frustum::intersects(const Vector3x4& centers, const Vector3x4& halfExtents) const {
+        Float4 inside = Float4(0.0f) <= Float4(0.0f);
+        for (const Plane& plane : planes) {
+            Vector3x4 normal(Float4(plane.normal.x), Float4(plane.normal.y), Float4(plane.normal.z));
+            Vector3x4 absNormal(Float4(std::fabs(plane.normal.x)), Float4(std::fabs(plane.normal.y)), Float4(std::fabs(plane.normal.z)));
+            Float4 distance = normal.dot(centers) + Float4(plane.distance);
+            inside = inside & (distance + absNormal.dot(halfExtents) >= Float4(0.0f));
+        }
+        return inside.mask();
+    }
+
+}
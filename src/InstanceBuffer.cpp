@@ -0,0 +1,256 @@
+#include "InstanceBuffer.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "jobs/ThreadPool.hpp"
+
+namespace ParteeEngine {
+
+    void InstanceBuffer::build(View<RenderComponent, TransformComponent> view, ThreadPool& jobs, const TransformHierarchy& hierarchy,
+                               const RenderView& camera) {
+        const Frustum* frustum = camera.frustum;
+        OcclusionBuffer* occlusion = camera.occlusion;
+
+        size_t chunkCount = view.chunkCount(ChunkSize);
+        if (chunks.size() < chunkCount) chunks.resize(chunkCount);
+
+        // Each chunk fills its own groups, so no synchronization is needed
+        view.parallelEachChunk(jobs, ChunkSize, [&](size_t index, Entity entity, RenderComponent& render, TransformComponent& transform) {
+            if (!render.visible) return;
+            Chunk& chunk = chunks[index];
+            chunk.total++;
+
+            Candidate candidate;
+            int32_t node = hierarchy.getNode(entity.getID());
+            candidate.instance.model = node >= 0 ? hierarchy.getWorldMatrix(node) : transform.getLocalMatrix();
+            candidate.instance.color = packRGBA(render.color.x, render.color.y, render.color.z);
+            candidate.render = &render;
+            candidate.mesh = render.type == RenderComponent::MESH ? render.mesh : &getMesh(render.type);
+            if (!candidate.mesh) return;
+
+            // World bounds, shared by the frustum test and level selection. Every level of a
+            // chain uses its finest level's bounds, so the levels agree.
+            bool hasLod = render.lod && !render.lod->levels.empty();
+            Vector3 center, halfExtents;
+            if (frustum || (hasLod && camera.projectionScale > 0.0f)) {
+                const Mesh& bounded = hasLod ? *render.lod->levels[0].mesh : *candidate.mesh;
+                transformBounds(candidate.instance.model, bounded.bounds.getCenter(), bounded.bounds.getHalfExtents(), center, halfExtents);
+            }
+            if (frustum) {
+                chunk.stage(candidate, center, halfExtents, *frustum, camera);
+            } else {
+                chunk.keep(candidate, center, halfExtents, camera);
+            }
+        });
+        if (frustum) {
+            for (size_t chunk = 0; chunk < chunkCount; ++chunk) chunks[chunk].flushPending(*frustum, camera);
+        }
+
+        cullStats = CullStats();
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+            cullStats.total += chunks[chunk].total;
+            chunks[chunk].total = 0;
+        }
+
+        if (occlusion) {
+            for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+                for (const Occluder& occluder : chunks[chunk].occluders) {
+                    occlusion->addOccluder(*occluder.mesh, occluder.model);
+                }
+                chunks[chunk].occluders.clear();
+            }
+            if (occlusion->hasOccluders()) {
+                occlusion->rasterize(jobs);
+            } else {
+                occlusion = nullptr;
+            }
+        }
+
+        // Occlusion culling compacts each chunk's groups in place, before anything is copied
+        if (occlusion) {
+            jobs.parallelFor(0, chunkCount, 1, [&](size_t begin, size_t end) {
+                for (size_t chunk = begin; chunk < end; ++chunk) {
+                    for (ChunkGroup& group : chunks[chunk].groups) {
+                        if (group.instances.empty()) continue;
+                        chunks[chunk].occluded += cull(group.instances, *group.mesh, *occlusion);
+                    }
+                }
+            });
+            for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+                cullStats.occluded += chunks[chunk].occluded;
+                chunks[chunk].occluded = 0;
+            }
+        }
+
+        // Concatenate the chunks in order; the copies run in parallel at precomputed offsets
+        std::vector<size_t> sizes(groups.size(), 0);
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+            for (ChunkGroup& group : chunks[chunk].groups) {
+                if (group.instances.empty()) continue;
+                auto found = groupOfMesh.find(group.mesh);
+                if (found == groupOfMesh.end()) {
+                    found = groupOfMesh.emplace(group.mesh, groups.size()).first;
+                    groups.push_back({group.mesh, {}});
+                    sizes.push_back(0);
+                }
+                group.group = found->second;
+                group.offset = sizes[group.group];
+                sizes[group.group] += group.instances.size();
+            }
+        }
+        for (size_t group = 0; group < groups.size(); ++group) {
+            groups[group].instances.resize(sizes[group]);
+        }
+
+        jobs.parallelFor(0, chunkCount, 1, [&](size_t begin, size_t end) {
+            for (size_t chunk = begin; chunk < end; ++chunk) {
+                for (ChunkGroup& source : chunks[chunk].groups) {
+                    if (source.instances.empty()) continue;
+                    std::copy(source.instances.begin(), source.instances.end(), groups[source.group].instances.begin() + source.offset);
+                    source.instances.clear();
+                }
+            }
+        });
+
+        // Meshes no longer drawn may have been destroyed, so their groups go
+        size_t drawn = 0;
+        for (InstanceGroup& group : groups) {
+            if (group.instances.empty()) continue;
+            cullStats.visible += group.instances.size();
+            cullStats.triangles += group.instances.size() * (group.mesh->getCornerCount() / 3);
+            if (&groups[drawn] != &group) groups[drawn] = std::move(group);
+            drawn++;
+        }
+        if (drawn < groups.size()) {
+            groups.resize(drawn);
+            groupOfMesh.clear();
+            for (size_t group = 0; group < groups.size(); ++group) {
+                groupOfMesh.emplace(groups[group].mesh, group);
+            }
+        }
+    }
+
+    const std::vector<InstanceData>& InstanceBuffer::getInstances(const Mesh& mesh) const {
+        static const std::vector<InstanceData> none;
+        auto found = groupOfMesh.find(&mesh);
+        return found != groupOfMesh.end() ? groups[found->second].instances : none;
+    }
+
+    std::vector<InstanceData>& InstanceBuffer::Chunk::getGroup(const Mesh* mesh) {
+        // A chunk rarely holds more than a few meshes
+        for (ChunkGroup& group : groups) {
+            if (group.mesh == mesh) return group.instances;
+        }
+        groups.push_back({mesh, {}, 0, 0});
+        return groups.back().instances;
+    }
+
+    void InstanceBuffer::Chunk::keep(const Candidate& candidate, const Vector3& center, const Vector3& halfExtents,
+                                     const RenderView& camera) {
+        const Mesh* mesh = candidate.mesh;
+        RenderComponent& render = *candidate.render;
+        if (render.lod && !render.lod->levels.empty()) {
+            const LodChain& lod = *render.lod;
+            if (camera.projectionScale > 0.0f) {
+                // Projected size of the bounding sphere
+                float radius = halfExtents.length();
+                float distance = (center - camera.cameraPosition).length();
+                float screenSize = distance > radius ? radius * camera.projectionScale / distance : std::numeric_limits<float>::max();
+                render.lodLevel = lod.selectLevel(screenSize, render.lodLevel, camera.lodHysteresis);
+            }
+            if (render.lodLevel >= lod.levels.size()) return; // too small to see
+            mesh = lod.levels[render.lodLevel].mesh;
+        }
+
+        getGroup(mesh).push_back(candidate.instance);
+        if (render.occluder && camera.occlusion) occluders.push_back({mesh, candidate.instance.model});
+    }
+
+    void InstanceBuffer::Chunk::stage(const Candidate& candidate, const Vector3& center, const Vector3& halfExtents,
+                                      const Frustum& frustum, const RenderView& camera) {
+        size_t lane = pendingCount++;
+        pending[lane] = candidate;
+        pendingCenters[0][lane] = center.x;
+        pendingCenters[1][lane] = center.y;
+        pendingCenters[2][lane] = center.z;
+        pendingHalfExtents[0][lane] = halfExtents.x;
+        pendingHalfExtents[1][lane] = halfExtents.y;
+        pendingHalfExtents[2][lane] = halfExtents.z;
+        if (pendingCount == 4) flushPending(frustum, camera);
+    }
+
+    void InstanceBuffer::Chunk::flushPending(const Frustum& frustum, const RenderView& camera) {
+        size_t lanes = pendingCount;
+        if (lanes == 0) return;
+        pendingCount = 0;
+
+        // A partial batch repeats its last box
+        for (size_t lane = lanes; lane < 4; ++lane) {
+            for (int axis = 0; axis < 3; ++axis) {
+                pendingCenters[axis][lane] = pendingCenters[axis][lanes - 1];
+                pendingHalfExtents[axis][lane] = pendingHalfExtents[axis][lanes - 1];
+            }
+        }
+        Vector3x4 centers(Float4::load(pendingCenters[0]), Float4::load(pendingCenters[1]), Float4::load(pendingCenters[2]));
+        Vector3x4 halfExtents(Float4::load(pendingHalfExtents[0]), Float4::load(pendingHalfExtents[1]), Float4::load(pendingHalfExtents[2]));
+        int visible = frustum.intersects(centers, halfExtents) & ((1 << lanes) - 1);
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            if (!(visible & (1 << lane))) continue;
+            keep(pending[lane],
+                 Vector3(pendingCenters[0][lane], pendingCenters[1][lane], pendingCenters[2][lane]),
+                 Vector3(pendingHalfExtents[0][lane], pendingHalfExtents[1][lane], pendingHalfExtents[2][lane]), camera);
+        }
+    }
+
+    size_t InstanceBuffer::cull(std::vector<InstanceData>& instances, const Mesh& mesh, const OcclusionBuffer& occlusion) {
+        Vector3 localCenter = mesh.bounds.getCenter();
+        Vector3 localHalfExtents = mesh.bounds.getHalfExtents();
+
+        size_t kept = 0;
+        size_t occluded = 0;
+        for (size_t first = 0; first < instances.size(); first += 4) {
+            size_t lanes = std::min<size_t>(4, instances.size() - first);
+
+            // Transposed into lanes; a partial last group repeats its last box
+            alignas(16) float centers[3][4];
+            alignas(16) float halfExtents[3][4];
+            for (size_t lane = 0; lane < 4; ++lane) {
+                Vector3 center, halfExtent;
+                transformBounds(instances[first + std::min(lane, lanes - 1)].model, localCenter, localHalfExtents, center, halfExtent);
+                centers[0][lane] = center.x;
+                centers[1][lane] = center.y;
+                centers[2][lane] = center.z;
+                halfExtents[0][lane] = halfExtent.x;
+                halfExtents[1][lane] = halfExtent.y;
+                halfExtents[2][lane] = halfExtent.z;
+            }
+
+            Vector3x4 center(Float4::load(centers[0]), Float4::load(centers[1]), Float4::load(centers[2]));
+            Vector3x4 halfExtent(Float4::load(halfExtents[0]), Float4::load(halfExtents[1]), Float4::load(halfExtents[2]));
+            int visible = (1 << lanes) - 1;
+            int unoccluded = occlusion.testVisible(center, halfExtent);
+            for (int hidden = visible & ~unoccluded; hidden; hidden &= hidden - 1) occluded++;
+            visible &= unoccluded;
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                if (visible & (1 << lane)) {
+                    if (kept != first + lane) instances[kept] = instances[first + lane];
+                    kept++;
+                }
+            }
+        }
+        instances.resize(kept);
+        return occluded;
+    }
+
+    const Mesh& InstanceBuffer::getMesh(RenderComponent::RenderType type) {
+        switch (type) {
+            case RenderComponent::CUBE:
+                return Mesh::unitCube();
+            case RenderComponent::SQUARE:
+            default:
+                return Mesh::unitSquare();
+        }
+    }
+
+}
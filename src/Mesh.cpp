@@ -0,0 +1,69 @@
+#include "Mesh.hpp"
+
+#include <algorithm>
+
+namespace ParteeEngine {
+
+    void Mesh::computeBounds() {
+        if (vertices.empty()) {
+            bounds = Aabb();
+            return;
+        }
+        bounds = Aabb(vertices[0].position, vertices[0].position);
+        for (const RenderVertex& v : vertices) {
+            bounds = bounds.merged(Aabb(v.position, v.position));
+        }
+    }
+
+    const Mesh& Mesh::unitSquare() {
+        static const Mesh mesh = [] {
+            uint32_t white = packRGBA(1.0f, 1.0f, 1.0f);
+            Mesh m;
+            m.vertices = {
+                {Vector3(-0.5f, -0.5f, 0.0f), white}, {Vector3( 0.5f, -0.5f, 0.0f), white}, {Vector3(-0.5f,  0.5f, 0.0f), white},
+                {Vector3( 0.5f, -0.5f, 0.0f), white}, {Vector3( 0.5f,  0.5f, 0.0f), white}, {Vector3(-0.5f,  0.5f, 0.0f), white},
+            };
+            m.computeBounds();
+            return m;
+        }();
+        return mesh;
+    }
+
+    const Mesh& Mesh::unitCube() {
+        static const Mesh mesh = [] {
+            // Faces as quads, counter-clockwise seen from outside
+            const float corners[6][4][3] = {
+                {{-0.5f, -0.5f,  0.5f}, { 0.5f, -0.5f,  0.5f}, { 0.5f,  0.5f,  0.5f}, {-0.5f,  0.5f,  0.5f}}, // Front
+                {{-0.5f, -0.5f, -0.5f}, {-0.5f,  0.5f, -0.5f}, { 0.5f,  0.5f, -0.5f}, { 0.5f, -0.5f, -0.5f}}, // Back
+                {{-0.5f,  0.5f, -0.5f}, {-0.5f,  0.5f,  0.5f}, { 0.5f,  0.5f,  0.5f}, { 0.5f,  0.5f, -0.5f}}, // Top
+                {{-0.5f, -0.5f, -0.5f}, { 0.5f, -0.5f, -0.5f}, { 0.5f, -0.5f,  0.5f}, {-0.5f, -0.5f,  0.5f}}, // Bottom
+                {{ 0.5f, -0.5f, -0.5f}, { 0.5f,  0.5f, -0.5f}, { 0.5f,  0.5f,  0.5f}, { 0.5f, -0.5f,  0.5f}}, // Right
+                {{-0.5f, -0.5f, -0.5f}, {-0.5f, -0.5f,  0.5f}, {-0.5f,  0.5f,  0.5f}, {-0.5f,  0.5f, -0.5f}}, // Left
+            };
+            const uint32_t colors[6] = {
+                packRGBA(1.0f, 0.0f, 0.0f), packRGBA(0.0f, 1.0f, 0.0f), packRGBA(0.0f, 0.0f, 1.0f),
+                packRGBA(1.0f, 1.0f, 0.0f), packRGBA(1.0f, 0.0f, 1.0f), packRGBA(0.0f, 1.0f, 1.0f),
+            };
+            const int quadToTriangles[6] = {0, 1, 2, 0, 2, 3};
+
+            Mesh m;
+            for (int face = 0; face < 6; ++face) {
+                for (int i = 0; i < 6; ++i) {
+                    const float* c = corners[face][quadToTriangles[i]];
+                    m.vertices.push_back({Vector3(c[0], c[1], c[2]), colors[face]});
+                }
+            }
+            m.computeBounds();
+            return m;
+        }();
+        return mesh;
+    }
+
+    size_t LodChain::selectLevel(float screenSize, size_t current, float hysteresis) const {
+        size_t level = std::min(current, levels.size());
+        while (level > 0 && screenSize >= levels[level - 1].screenSize * (1.0f + hysteresis)) level--;
+        while (level < levels.size() && screenSize < levels[level].screenSize * (1.0f - hysteresis)) level++;
+        return level;
+    }
+
+}
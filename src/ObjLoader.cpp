@@ -0,0 +1,343 @@
+#include "ObjLoader.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "jobs/ThreadPool.hpp"
+
+namespace ParteeEngine {
+
+    namespace {
+
+        // Read-only view of a whole file, paged in by the OS as it is parsed.
+        class MappedFile {
+        public:
+            explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+                file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+                LARGE_INTEGER fileSize;
+                if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &fileSize)) {
+                    release();
+                    throw std::runtime_error("Cannot open " + path);
+                }
+                length = static_cast<size_t>(fileSize.QuadPart);
+                if (length > 0) {
+                    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                    if (mapping) bytes = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                }
+#else
+                int descriptor = open(path.c_str(), O_RDONLY);
+                struct stat info;
+                if (descriptor < 0 || fstat(descriptor, &info) != 0) {
+                    if (descriptor >= 0) close(descriptor);
+                    throw std::runtime_error("Cannot open " + path);
+                }
+                length = static_cast<size_t>(info.st_size);
+                if (length > 0) {
+                    void* view = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+                    if (view != MAP_FAILED) bytes = static_cast<const char*>(view);
+                }
+                // The mapping keeps the file open
+                close(descriptor);
+#endif
+                if (length > 0 && !bytes) {
+                    release();
+                    throw std::runtime_error("Cannot map " + path);
+                }
+            }
+
+            ~MappedFile() { release(); }
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            const char* data() const { return bytes; }
+            size_t size() const { return length; }
+
+        private:
+            const char* bytes = nullptr;
+            size_t length = 0;
+#ifdef _WIN32
+            HANDLE file = INVALID_HANDLE_VALUE;
+            HANDLE mapping = nullptr;
+#endif
+
+            void release() {
+#ifdef _WIN32
+                if (bytes) UnmapViewOfFile(bytes);
+                if (mapping) CloseHandle(mapping);
+                if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+                mapping = nullptr;
+                file = INVALID_HANDLE_VALUE;
+#else
+                if (bytes) munmap(const_cast<char*>(bytes), length);
+#endif
+                bytes = nullptr;
+            }
+        };
+
+        // Lines of the file parsed by one job. Faces refer to positions by their 0-based index
+        // in the whole file, except relativeCorners: those count from the chunk's first position
+        // (negative OBJ indices) until the chunks are joined.
+        struct ObjChunk {
+            const char* begin = nullptr;
+            const char* end = nullptr;
+            std::vector<Vector3> positions;
+            std::vector<int64_t> corners; // three per triangle
+            std::vector<size_t> relativeCorners;
+            std::vector<std::pair<size_t, std::string>> materials; // usemtl: first corner it applies to, name
+            std::vector<std::string> libraries;
+            std::string error; // first malformed line
+        };
+
+        // Below this, splitting the file costs more than parsing it in parallel saves.
+        constexpr size_t MinChunkSize = 256 * 1024;
+
+        bool isSpace(char c) { return c == ' ' || c == '\t'; }
+
+        const char* skipSpaces(const char* p, const char* end) {
+            while (p < end && isSpace(*p)) ++p;
+            return p;
+        }
+
+        // True if the line starts with keyword followed by a space.
+        bool isKeyword(const char* line, const char* end, const char* keyword) {
+            size_t length = std::strlen(keyword);
+            return static_cast<size_t>(end - line) > length && std::memcmp(line, keyword, length) == 0 && isSpace(line[length]);
+        }
+
+        // Parses a number after optional spaces. Returns the position after it, or null.
+        template <typename T>
+        const char* parseNumber(const char* p, const char* end, T& value) {
+            p = skipSpaces(p, end);
+            if (p < end && *p == '+') ++p;
+            std::from_chars_result result = std::from_chars(p, end, value);
+            return result.ec == std::errc() ? result.ptr : nullptr;
+        }
+
+        // Parses the face at p (after "f") into fan-triangulated corners. False if malformed.
+        bool parseFace(ObjChunk& chunk, const char* p, const char* end) {
+            int64_t first = 0, previous = 0;
+            bool firstRelative = false, previousRelative = false;
+            int count = 0;
+
+            auto push = [&chunk](int64_t corner, bool relative) {
+                if (relative) chunk.relativeCorners.push_back(chunk.corners.size());
+                chunk.corners.push_back(corner);
+            };
+
+            while ((p = skipSpaces(p, end)) < end) {
+                int64_t index;
+                p = parseNumber(p, end, index);
+                if (!p || index == 0 || (p < end && *p != '/' && !isSpace(*p))) return false;
+
+                // Texture coordinate and normal references are not kept
+                while (p < end && !isSpace(*p)) ++p;
+
+                bool relative = index < 0;
+                int64_t corner = relative ? static_cast<int64_t>(chunk.positions.size()) + index : index - 1;
+                if (count >= 2) {
+                    push(first, firstRelative);
+                    push(previous, previousRelative);
+                    push(corner, relative);
+                }
+                if (count == 0) {
+                    first = corner;
+                    firstRelative = relative;
+                }
+                previous = corner;
+                previousRelative = relative;
+                count++;
+            }
+            return count >= 3;
+        }
+
+        void parseChunk(ObjChunk& chunk) {
+            const char* p = chunk.begin;
+            while (p < chunk.end) {
+                const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', chunk.end - p));
+                if (!lineEnd) lineEnd = chunk.end;
+                const char* line = skipSpaces(p, lineEnd);
+                p = lineEnd < chunk.end ? lineEnd + 1 : chunk.end;
+
+                const char* end = lineEnd;
+                while (end > line && (end[-1] == '\r' || isSpace(end[-1]))) --end;
+                if (line == end) continue;
+
+                bool valid = true;
+                if (isKeyword(line, end, "v")) {
+                    Vector3 position;
+                    const char* q = line + 1;
+                    valid = (q = parseNumber(q, end, position.x)) && (q = parseNumber(q, end, position.y)) && (q = parseNumber(q, end, position.z));
+                    chunk.positions.push_back(position);
+                } else if (isKeyword(line, end, "f")) {
+                    valid = parseFace(chunk, line + 1, end);
+                } else if (isKeyword(line, end, "usemtl")) {
+                    chunk.materials.emplace_back(chunk.corners.size(), std::string(skipSpaces(line + 6, end), end));
+                } else if (isKeyword(line, end, "mtllib")) {
+                    // The whole rest of the line, as exporters do not quote names with spaces
+                    chunk.libraries.emplace_back(skipSpaces(line + 6, end), end);
+                }
+
+                if (!valid) {
+                    chunk.error = std::string(line, end);
+                    return;
+                }
+            }
+        }
+
+        void forEachChunk(ThreadPool* jobs, size_t count, const std::function<void(size_t)>& fn) {
+            auto run = [&fn](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) fn(i);
+            };
+            if (jobs) {
+                jobs->parallelFor(0, count, 1, run);
+            } else {
+                run(0, count);
+            }
+        }
+
+    }
+
+    Mesh loadObj(const std::string& path, ThreadPool* jobs) {
+        MappedFile file(path);
+        const char* data = file.data();
+        const char* dataEnd = data + file.size();
+
+        // Whole lines per chunk, a few chunks per thread so uneven ones balance out
+        size_t threads = jobs ? jobs->getConcurrency() : 1;
+        size_t chunkCount = std::max<size_t>(1, std::min(threads * 4, file.size() / MinChunkSize));
+        std::vector<ObjChunk> chunks(chunkCount);
+        const char* begin = data;
+        for (size_t i = 0; i < chunkCount; ++i) {
+            const char* end = dataEnd;
+            if (i + 1 < chunkCount) {
+                end = std::max(begin, data + file.size() * (i + 1) / chunkCount);
+                const char* newline = static_cast<const char*>(std::memchr(end, '\n', dataEnd - end));
+                end = newline ? newline + 1 : dataEnd;
+            }
+            chunks[i].begin = begin;
+            chunks[i].end = end;
+            begin = end;
+        }
+
+        forEachChunk(jobs, chunkCount, [&](size_t i) { parseChunk(chunks[i]); });
+        for (const ObjChunk& chunk : chunks) {
+            if (!chunk.error.empty()) throw std::runtime_error("Malformed line in " + path + ": " + chunk.error);
+        }
+
+        // Positions are numbered across the whole file
+        std::vector<size_t> positionOffsets(chunkCount + 1, 0);
+        size_t cornerCount = 0;
+        for (size_t i = 0; i < chunkCount; ++i) {
+            positionOffsets[i + 1] = positionOffsets[i] + chunks[i].positions.size();
+            cornerCount += chunks[i].corners.size();
+        }
+        std::vector<Vector3> positions(positionOffsets[chunkCount]);
+        forEachChunk(jobs, chunkCount, [&](size_t i) {
+            ObjChunk& chunk = chunks[i];
+            std::copy(chunk.positions.begin(), chunk.positions.end(), positions.begin() + positionOffsets[i]);
+            for (size_t corner : chunk.relativeCorners) {
+                chunk.corners[corner] += static_cast<int64_t>(positionOffsets[i]);
+            }
+        });
+
+        // Libraries are named relative to the file; the first definition of a material wins
+        std::string directory = path.substr(0, path.find_last_of("/\\") + 1);
+        std::unordered_set<std::string> libraries;
+        std::unordered_map<std::string, Vector3> diffuse;
+        for (const ObjChunk& chunk : chunks) {
+            for (const std::string& library : chunk.libraries) {
+                if (!libraries.insert(library).second) continue;
+                std::unordered_map<std::string, Vector3> materials = loadMtl(directory + library);
+                diffuse.insert(materials.begin(), materials.end());
+            }
+        }
+
+        // Corners with the same position and color share a vertex. The vertices of each
+        // position are chained, and a position rarely has more than one.
+        const uint32_t NoVertex = ~0u;
+        std::vector<uint32_t> firstVertex(positions.size(), NoVertex);
+        std::vector<uint32_t> nextVertex;
+        nextVertex.reserve(positions.size());
+
+        Mesh mesh;
+        mesh.vertices.reserve(positions.size());
+        mesh.indices.resize(cornerCount);
+        uint32_t white = packRGBA(1.0f, 1.0f, 1.0f);
+        uint32_t color = white;
+        size_t index = 0;
+        for (const ObjChunk& chunk : chunks) {
+            size_t change = 0;
+            for (size_t corner = 0; corner <= chunk.corners.size(); ++corner) {
+                // Materials apply from the corner they were selected at, into later chunks
+                for (; change < chunk.materials.size() && chunk.materials[change].first == corner; ++change) {
+                    auto found = diffuse.find(chunk.materials[change].second);
+                    color = found != diffuse.end() ? packRGBA(found->second.x, found->second.y, found->second.z) : white;
+                }
+                if (corner == chunk.corners.size()) break;
+
+                int64_t position = chunk.corners[corner];
+                if (position < 0 || position >= static_cast<int64_t>(positions.size())) {
+                    throw std::runtime_error("Face refers to missing vertex " + std::to_string(position + 1) + " in " + path);
+                }
+
+                uint32_t vertex = firstVertex[position];
+                while (vertex != NoVertex && mesh.vertices[vertex].color != color) vertex = nextVertex[vertex];
+                if (vertex == NoVertex) {
+                    vertex = static_cast<uint32_t>(mesh.vertices.size());
+                    mesh.vertices.push_back({positions[position], color});
+                    nextVertex.push_back(firstVertex[position]);
+                    firstVertex[position] = vertex;
+                }
+                mesh.indices[index++] = vertex;
+            }
+        }
+
+        mesh.computeBounds();
+        return mesh;
+    }
+
+    std::unordered_map<std::string, Vector3> loadMtl(const std::string& path) {
+        std::ifstream file(path);
+        if (!file) throw std::runtime_error("Cannot open " + path);
+
+        std::unordered_map<std::string, Vector3> materials;
+        Vector3* current = nullptr;
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream stream(line);
+            std::string keyword;
+            stream >> keyword;
+            if (keyword == "newmtl") {
+                std::string name;
+                std::getline(stream >> std::ws, name);
+                while (!name.empty() && (name.back() == '\r' || isSpace(name.back()))) name.pop_back();
+                current = &materials[name];
+                *current = Vector3(1.0f, 1.0f, 1.0f);
+            } else if (keyword == "Kd" && current) {
+                stream >> current->x >> current->y >> current->z;
+            }
+        }
+        return materials;
+    }
+
+}
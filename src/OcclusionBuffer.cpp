@@ -0,0 +1,239 @@
+#include "OcclusionBuffer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Mesh.hpp"
+#include "jobs/ThreadPool.hpp"
+
+namespace ParteeEngine {
+
+    void OcclusionBuffer::resize(int newWidth, int newHeight) {
+        tilesX = std::max(1, (newWidth + TileSize - 1) / TileSize);
+        tilesY = std::max(1, (newHeight + TileSize - 1) / TileSize);
+        width = tilesX * TileSize;
+        height = tilesY * TileSize;
+        depth.assign(static_cast<size_t>(width) * height, 0.0f);
+        tileFarthest.assign(static_cast<size_t>(tilesX) * tilesY, 0.0f);
+        tileNearest.assign(static_cast<size_t>(tilesX) * tilesY, 0.0f);
+    }
+
+    void OcclusionBuffer::clear(const Matrix4& matrix) {
+        viewProjection = matrix;
+        std::fill(depth.begin(), depth.end(), 0.0f);
+        std::fill(tileFarthest.begin(), tileFarthest.end(), 0.0f);
+        std::fill(tileNearest.begin(), tileNearest.end(), 0.0f);
+        triangles.clear();
+    }
+
+    void OcclusionBuffer::addOccluder(const Mesh& mesh, const Matrix4& model) {
+        Matrix4 modelViewProjection = viewProjection * model;
+
+        for (size_t first = 0; first + 2 < mesh.getCornerCount(); first += 3) {
+            Triangle triangle;
+            bool clipped = false;
+            for (int k = 0; k < 3; ++k) {
+                Vector4 clip = modelViewProjection * Vector4(mesh.getCorner(first + k).position, 1.0f);
+                if (clip.w <= 0.0f || clip.z < -clip.w) {
+                    clipped = true;
+                    break;
+                }
+                float inverseW = 1.0f / clip.w;
+                triangle.x[k] = (clip.x * inverseW * 0.5f + 0.5f) * width;
+                triangle.y[k] = (clip.y * inverseW * 0.5f + 0.5f) * height;
+                triangle.z[k] = inverseW;
+            }
+            if (clipped) continue;
+
+            // Counter-clockwise on screen, so every edge function is positive inside
+            float area = (triangle.x[1] - triangle.x[0]) * (triangle.y[2] - triangle.y[0])
+                       - (triangle.y[1] - triangle.y[0]) * (triangle.x[2] - triangle.x[0]);
+            if (std::fabs(area) < 1e-6f) continue;
+            if (area < 0.0f) {
+                std::swap(triangle.x[1], triangle.x[2]);
+                std::swap(triangle.y[1], triangle.y[2]);
+                std::swap(triangle.z[1], triangle.z[2]);
+            }
+
+            // Rows whose pixel centers the triangle spans
+            float minY = std::min({triangle.y[0], triangle.y[1], triangle.y[2]});
+            float maxY = std::max({triangle.y[0], triangle.y[1], triangle.y[2]});
+            float minX = std::min({triangle.x[0], triangle.x[1], triangle.x[2]});
+            float maxX = std::max({triangle.x[0], triangle.x[1], triangle.x[2]});
+            if (maxX < 0.5f || minX > width - 0.5f) continue;
+            triangle.minY = std::max(0, static_cast<int>(std::ceil(minY - 0.5f)));
+            triangle.maxY = std::min(height - 1, static_cast<int>(std::floor(maxY - 0.5f)));
+            if (triangle.minY > triangle.maxY) continue;
+
+            triangles.push_back(triangle);
+        }
+    }
+
+    void OcclusionBuffer::rasterize(ThreadPool& jobs) {
+        // Bands of tile rows are independent: every band walks the triangles crossing it
+        jobs.parallelFor(0, static_cast<size_t>(tilesY), 1, [&](size_t begin, size_t end) {
+            int rowBegin = static_cast<int>(begin) * TileSize;
+            int rowEnd = static_cast<int>(end) * TileSize;
+            for (const Triangle& triangle : triangles) {
+                if (triangle.maxY >= rowBegin && triangle.minY < rowEnd) {
+                    rasterizeTriangle(triangle, rowBegin, rowEnd);
+                }
+            }
+            for (size_t tileRow = begin; tileRow < end; ++tileRow) {
+                updateTiles(static_cast<int>(tileRow));
+            }
+        });
+    }
+
+    void OcclusionBuffer::rasterizeTriangle(const Triangle& t, int rowBegin, int rowEnd) {
+        // Edge k runs from vertex k to vertex k + 1: E(p) = a * p.x + b * p.y + c
+        float a[3], b[3], c[3];
+        for (int k = 0; k < 3; ++k) {
+            int next = (k + 1) % 3;
+            a[k] = t.y[k] - t.y[next];
+            b[k] = t.x[next] - t.x[k];
+            c[k] = -(a[k] * t.x[k] + b[k] * t.y[k]);
+        }
+
+        // Depth plane from the barycentric weights, each the opposite edge over the area
+        float area = a[0] * t.x[2] + b[0] * t.y[2] + c[0];
+        float inverseArea = 1.0f / area;
+        float zA = (a[1] * t.z[0] + a[2] * t.z[1] + a[0] * t.z[2]) * inverseArea;
+        float zB = (b[1] * t.z[0] + b[2] * t.z[1] + b[0] * t.z[2]) * inverseArea;
+        float zC = (c[1] * t.z[0] + c[2] * t.z[1] + c[0] * t.z[2]) * inverseArea;
+
+        float minX = std::min({t.x[0], t.x[1], t.x[2]});
+        float maxX = std::max({t.x[0], t.x[1], t.x[2]});
+        int x0 = std::max(0, static_cast<int>(std::ceil(minX - 0.5f))) & ~3;
+        int x1 = std::min(width - 1, static_cast<int>(std::floor(maxX - 0.5f)));
+        int y0 = std::max(t.minY, rowBegin);
+        int y1 = std::min(t.maxY, rowEnd - 1);
+
+        alignas(16) const float centers[4] = {0.5f, 1.5f, 2.5f, 3.5f};
+        const Float4 laneCenters = Float4::load(centers);
+        const Float4 zero(0.0f);
+
+        for (int y = y0; y <= y1; ++y) {
+            float py = y + 0.5f;
+            Float4 row0(b[0] * py + c[0]);
+            Float4 row1(b[1] * py + c[1]);
+            Float4 row2(b[2] * py + c[2]);
+            Float4 rowZ(zB * py + zC);
+            float* pixels = depth.data() + static_cast<size_t>(y) * width;
+
+            for (int x = x0; x <= x1; x += 4) {
+                Float4 px = Float4(static_cast<float>(x)) + laneCenters;
+                Float4 inside = (Float4(a[0]) * px + row0 >= zero) & (Float4(a[1]) * px + row1 >= zero)
+                              & (Float4(a[2]) * px + row2 >= zero);
+                if (!inside.any()) continue;
+
+                Float4 z = Float4(zA) * px + rowZ;
+                Float4 previous = Float4::load(pixels + x);
+                select(inside, max(previous, z), previous).store(pixels + x);
+            }
+        }
+    }
+
+    void OcclusionBuffer::updateTiles(int tileRow) {
+        for (int tileX = 0; tileX < tilesX; ++tileX) {
+            Float4 lowest(std::numeric_limits<float>::max());
+            Float4 highest(0.0f);
+            for (int y = 0; y < TileSize; ++y) {
+                const float* pixels = depth.data() + static_cast<size_t>(tileRow * TileSize + y) * width + tileX * TileSize;
+                for (int x = 0; x < TileSize; x += 4) {
+                    Float4 values = Float4::load(pixels + x);
+                    lowest = min(lowest, values);
+                    highest = max(highest, values);
+                }
+            }
+
+            alignas(16) float low[4], high[4];
+            lowest.store(low);
+            highest.store(high);
+            size_t tile = static_cast<size_t>(tileRow) * tilesX + tileX;
+            tileFarthest[tile] = std::min(std::min(low[0], low[1]), std::min(low[2], low[3]));
+            tileNearest[tile] = std::max(std::max(high[0], high[1]), std::max(high[2], high[3]));
+        }
+    }
+
+    bool OcclusionBuffer::isVisible(const Vector3& center, const Vector3& halfExtents) const {
+        Vector3x4 centers(Float4(center.x), Float4(center.y), Float4(center.z));
+        Vector3x4 extents(Float4(halfExtents.x), Float4(halfExtents.y), Float4(halfExtents.z));
+        return (testVisible(centers, extents) & 1) != 0;
+    }
+
+    int OcclusionBuffer::testVisible(const Vector3x4& centers, const Vector3x4& halfExtents) const {
+        const Matrix4& m = viewProjection;
+        auto clipCenter = [&](int row) {
+            return Float4(m(row, 0)) * centers.x + Float4(m(row, 1)) * centers.y + Float4(m(row, 2)) * centers.z + Float4(m(row, 3));
+        };
+        auto clipExtent = [&](int row) {
+            return Float4(std::fabs(m(row, 0))) * halfExtents.x + Float4(std::fabs(m(row, 1))) * halfExtents.y
+                 + Float4(std::fabs(m(row, 2))) * halfExtents.z;
+        };
+
+        // Clip coordinates of every corner lie within center +- extent; bounding x / w and
+        // y / w with each range taken separately is conservative
+        Float4 cw = clipCenter(3), ew = clipExtent(3);
+        Float4 minW = cw - ew;
+        Float4 maxW = cw + ew;
+        int crossesEye = (minW <= Float4(1e-6f)).mask();
+        minW = max(minW, Float4(1e-6f));
+
+        auto lowest = [&](const Float4& value) { return select(value < Float4(0.0f), value / minW, value / maxW); };
+        auto highest = [&](const Float4& value) { return select(value < Float4(0.0f), value / maxW, value / minW); };
+
+        Float4 cx = clipCenter(0), ex = clipExtent(0);
+        Float4 cy = clipCenter(1), ey = clipExtent(1);
+        Float4 halfWidth(0.5f * width), halfHeight(0.5f * height);
+
+        alignas(16) float minX[4], maxX[4], minY[4], maxY[4], nearest[4];
+        ((lowest(cx - ex) + Float4(1.0f)) * halfWidth).store(minX);
+        ((highest(cx + ex) + Float4(1.0f)) * halfWidth).store(maxX);
+        ((lowest(cy - ey) + Float4(1.0f)) * halfHeight).store(minY);
+        ((highest(cy + ey) + Float4(1.0f)) * halfHeight).store(maxY);
+        (Float4(1.0f) / minW).store(nearest);
+
+        int visible = 0;
+        for (int lane = 0; lane < 4; ++lane) {
+            if ((crossesEye & (1 << lane)) || isRectVisible(minX[lane], minY[lane], maxX[lane], maxY[lane], nearest[lane])) {
+                visible |= 1 << lane;
+            }
+        }
+        return visible;
+    }
+
+    bool OcclusionBuffer::isRectVisible(float minX, float minY, float maxX, float maxY, float nearest) const {
+        if (maxX < 0.0f || maxY < 0.0f || minX >= width || minY >= height) return true;
+
+        // One pixel of margin: an occluder covering a pixel's center may not cover all of it
+        int x0 = std::max(0, static_cast<int>(minX) - 1);
+        int y0 = std::max(0, static_cast<int>(minY) - 1);
+        int x1 = std::min(width - 1, static_cast<int>(maxX) + 1);
+        int y1 = std::min(height - 1, static_cast<int>(maxY) + 1);
+
+        int tileX0 = x0 / TileSize, tileX1 = x1 / TileSize;
+        int tileY0 = y0 / TileSize, tileY1 = y1 / TileSize;
+
+        for (int tileY = tileY0; tileY <= tileY1; ++tileY) {
+            for (int tileX = tileX0; tileX <= tileX1; ++tileX) {
+                size_t tile = static_cast<size_t>(tileY) * tilesX + tileX;
+                if (nearest < tileFarthest[tile]) continue;
+                if (nearest >= tileNearest[tile]) return true;
+
+                // Straddles the tile's depths: check the covered pixels
+                int rowEnd = std::min(y1, tileY * TileSize + TileSize - 1);
+                int columnEnd = std::min(x1, tileX * TileSize + TileSize - 1);
+                for (int y = std::max(y0, tileY * TileSize); y <= rowEnd; ++y) {
+                    const float* pixels = depth.data() + static_cast<size_t>(y) * width;
+                    for (int x = std::max(x0, tileX * TileSize); x <= columnEnd; ++x) {
+                        if (nearest >= pixels[x]) return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+}
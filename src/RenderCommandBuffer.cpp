@@ -0,0 +1,84 @@
+#include "RenderCommandBuffer.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Mesh.hpp"
+
+namespace ParteeEngine {
+
+    uint64_t RenderCommandBuffer::makeSortKey(RenderPass pass, uint32_t material, float depth) {
+        // Non-negative IEEE floats compare like their bit patterns
+        uint32_t depthBits = 0;
+        if (depth > 0.0f) {
+            std::memcpy(&depthBits, &depth, sizeof(depthBits));
+        }
+        if (pass == RenderPass::Transparent) {
+            depthBits = ~depthBits;
+        }
+        return (static_cast<uint64_t>(pass) << 56)
+             | (static_cast<uint64_t>(std::min(material, MaxMaterial)) << 32)
+             | depthBits;
+    }
+
+    RenderVertex* RenderCommandBuffer::record(RenderPass pass, uint32_t material, float depth, uint32_t vertexCount) {
+        uint32_t first = static_cast<uint32_t>(vertices.size());
+        commands.push_back({makeSortKey(pass, material, depth), first, vertexCount});
+        vertices.resize(vertices.size() + vertexCount);
+        return vertices.data() + first;
+    }
+
+    void RenderCommandBuffer::recordInstanced(RenderPass pass, uint32_t material, float depth,
+                                              const Mesh& mesh, const InstanceData* instances, uint32_t instanceCount) {
+        if (instanceCount == 0) return;
+
+        RenderCommand command{makeSortKey(pass, material, depth), 0, 0};
+        command.mesh = &mesh;
+        command.instances = instances;
+        command.instanceCount = instanceCount;
+        commands.push_back(command);
+    }
+
+    void RenderCommandBuffer::flush(RenderContext& context) {
+        // Ties keep submission order so equal keys draw deterministically
+        std::stable_sort(commands.begin(), commands.end(), [](const RenderCommand& a, const RenderCommand& b) {
+            return a.sortKey < b.sortKey;
+        });
+
+        stats = RenderStats();
+        stats.commands = commands.size();
+        stats.vertices = vertices.size();
+
+        size_t i = 0;
+        while (i < commands.size()) {
+            if (commands[i].mesh) {
+                const RenderCommand& command = commands[i++];
+                context.drawInstanced(*command.mesh, command.instances, command.instanceCount);
+                stats.instances += command.instanceCount;
+                stats.vertices += command.mesh->getCornerCount() * command.instanceCount;
+                stats.batches++;
+                continue;
+            }
+
+            uint64_t batchKey = commands[i].sortKey & BatchKeyMask;
+
+            // Gather the run of compatible commands into one contiguous vertex array
+            batch.clear();
+            for (; i < commands.size() && !commands[i].mesh && (commands[i].sortKey & BatchKeyMask) == batchKey; ++i) {
+                const RenderVertex* first = vertices.data() + commands[i].firstVertex;
+                batch.insert(batch.end(), first, first + commands[i].vertexCount);
+            }
+
+            context.drawTriangles(batch.data(), batch.size());
+            stats.batches++;
+        }
+
+        clear();
+    }
+
+    void RenderCommandBuffer::clear() {
+        commands.clear();
+        vertices.clear();
+    }
+
+}
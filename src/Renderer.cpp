@@ -1,9 +1,10 @@
 #include "Renderer.hpp"
+#include "math/Matrix4.hpp"
 #include <iostream>
 
 namespace ParteeEngine {
 
-    Renderer::Renderer() : renderContext(std::make_unique<RenderContext>()) {
+    Renderer::Renderer(std::unique_ptr<RenderContext> context) : renderContext(std::move(context)) {
         std::cout << "Renderer created" << std::endl;
     }
     
@@ -18,84 +19,54 @@ namespace ParteeEngine {
     
     void Renderer::clear() {
         renderContext->clear();
+        commandBuffer.clear();
     }
     
     void Renderer::present() {
+        commandBuffer.flush(*renderContext);
         renderContext->present();
     }
 
     void Renderer::drawSquare(const Vector3& position, float size) {
-        float halfSize = size * 0.5f;
-        
-        // Draw two triangles to form a square
-        renderContext->drawTriangle(
-            Vector3(position.x - halfSize, position.y - halfSize, position.z),
-            Vector3(position.x + halfSize, position.y - halfSize, position.z),
-            Vector3(position.x - halfSize, position.y + halfSize, position.z)
-        );
-        renderContext->drawTriangle(
-            Vector3(position.x + halfSize, position.y - halfSize, position.z),
-            Vector3(position.x + halfSize, position.y + halfSize, position.z),
-            Vector3(position.x - halfSize, position.y + halfSize, position.z)
-        );
+        const std::vector<RenderVertex>& mesh = Mesh::unitSquare().vertices;
+
+        RenderVertex* v = commandBuffer.record(RenderPass::Opaque, 0, depthOf(position), static_cast<uint32_t>(mesh.size()));
+        for (const RenderVertex& local : mesh) {
+            *v++ = {position + local.position * size, local.color};
+        }
     }
 
     void Renderer::drawTriangle(const Vector3& v1, const Vector3& v2, const Vector3& v3) {
-        renderContext->drawTriangle(v1, v2, v3);
+        uint32_t white = packRGBA(1.0f, 1.0f, 1.0f);
+
+        RenderVertex* v = commandBuffer.record(RenderPass::Opaque, 0, depthOf((v1 + v2 + v3) * (1.0f / 3.0f)), 3);
+        v[0] = {v1, white};
+        v[1] = {v2, white};
+        v[2] = {v3, white};
+    }
+
+    void Renderer::drawMesh(const Mesh& mesh, const Vector3& position) {
+        // Expanded to a triangle list so it batches with the other immediate draws
+        RenderVertex* v = commandBuffer.record(RenderPass::Opaque, 0, depthOf(position), static_cast<uint32_t>(mesh.getCornerCount()));
+        for (size_t corner = 0; corner < mesh.getCornerCount(); ++corner) {
+            const RenderVertex& local = mesh.getCorner(corner);
+            *v++ = {position + local.position, local.color};
+        }
     }
 
     void Renderer::drawCube(const Vector3& position, const Vector3& size) {
-        renderContext->pushMatrix();
-        renderContext->translate(position);
-        renderContext->scale(size);
-        
-        // Draw cube using RenderContext
-        renderContext->beginQuads();
-        
-        // Front face
-        renderContext->color(1.0f, 0.0f, 0.0f);
-        renderContext->vertex(Vector3(-0.5f, -0.5f,  0.5f));
-        renderContext->vertex(Vector3( 0.5f, -0.5f,  0.5f));
-        renderContext->vertex(Vector3( 0.5f,  0.5f,  0.5f));
-        renderContext->vertex(Vector3(-0.5f,  0.5f,  0.5f));
-        
-        // Back face
-        renderContext->color(0.0f, 1.0f, 0.0f);
-        renderContext->vertex(Vector3(-0.5f, -0.5f, -0.5f));
-        renderContext->vertex(Vector3(-0.5f,  0.5f, -0.5f));
-        renderContext->vertex(Vector3( 0.5f,  0.5f, -0.5f));
-        renderContext->vertex(Vector3( 0.5f, -0.5f, -0.5f));
-        
-        // Top face
-        renderContext->color(0.0f, 0.0f, 1.0f);
-        renderContext->vertex(Vector3(-0.5f,  0.5f, -0.5f));
-        renderContext->vertex(Vector3(-0.5f,  0.5f,  0.5f));
-        renderContext->vertex(Vector3( 0.5f,  0.5f,  0.5f));
-        renderContext->vertex(Vector3( 0.5f,  0.5f, -0.5f));
-        
-        // Bottom face
-        renderContext->color(1.0f, 1.0f, 0.0f);
-        renderContext->vertex(Vector3(-0.5f, -0.5f, -0.5f));
-        renderContext->vertex(Vector3( 0.5f, -0.5f, -0.5f));
-        renderContext->vertex(Vector3( 0.5f, -0.5f,  0.5f));
-        renderContext->vertex(Vector3(-0.5f, -0.5f,  0.5f));
-        
-        // Right face
-        renderContext->color(1.0f, 0.0f, 1.0f);
-        renderContext->vertex(Vector3( 0.5f, -0.5f, -0.5f));
-        renderContext->vertex(Vector3( 0.5f,  0.5f, -0.5f));
-        renderContext->vertex(Vector3( 0.5f,  0.5f,  0.5f));
-        renderContext->vertex(Vector3( 0.5f, -0.5f,  0.5f));
-        
-        // Left face
-        renderContext->color(0.0f, 1.0f, 1.0f);
-        renderContext->vertex(Vector3(-0.5f, -0.5f, -0.5f));
-        renderContext->vertex(Vector3(-0.5f, -0.5f,  0.5f));
-        renderContext->vertex(Vector3(-0.5f,  0.5f,  0.5f));
-        renderContext->vertex(Vector3(-0.5f,  0.5f, -0.5f));
-        
-        renderContext->end();
-        renderContext->popMatrix();
+        const std::vector<RenderVertex>& mesh = Mesh::unitCube().vertices;
+
+        // Transform on the CPU so every cube can share one batch
+        RenderVertex* v = commandBuffer.record(RenderPass::Opaque, 0, depthOf(position), static_cast<uint32_t>(mesh.size()));
+        for (const RenderVertex& local : mesh) {
+            const Vector3& p = local.position;
+            *v++ = {Vector3(position.x + p.x * size.x, position.y + p.y * size.y, position.z + p.z * size.z), local.color};
+        }
+    }
+
+    void Renderer::drawInstanced(const Mesh& mesh, const InstanceData* instances, size_t count) {
+        commandBuffer.recordInstanced(RenderPass::Opaque, 0, 0.0f, mesh, instances, static_cast<uint32_t>(count));
     }
     
     void Renderer::setCamera(const Vector3& position, const Vector3& target, const Vector3& up) {
@@ -105,5 +76,15 @@ namespace ParteeEngine {
     void Renderer::setPerspective(float fov, float aspect, float nearPlane, float farPlane) {
         renderContext->setPerspective(fov, aspect, nearPlane, farPlane);
     }
+
+    void Renderer::loadMatrix(const Matrix4& matrix) {
+        renderContext->loadIdentity();
+        renderContext->multMatrix(matrix);
+    }
+
+    float Renderer::depthOf(const Vector3& position) const {
+        Vector3 offset = position - renderContext->getCameraPosition();
+        return offset.dot(offset);
+    }
     
 }
\ No newline at end of file
@@ -3,32 +3,81 @@
 
 #include "components/PhysicsComponent.hpp"
 #include "events/Event.hpp"
+#include "events/EventBus.hpp"
+#include "physics/PhysicsWorld.hpp"
+
+#include <stdexcept>
 
 namespace ParteeEngine
 {
     void PhysicsComponent::requireDependencies(Entity &owner) {
         owner.ensureComponent<TransformComponent>();
     }
-    
-    void PhysicsComponent::update(Entity& owner, float dt)
-    {
-        velocity += acceleration * dt;
-        owner.getComponent<TransformComponent>()->translate(velocity * dt);
+
+    void PhysicsComponent::onAttach(Entity &owner) {
+        world = owner.getWorld().getResource<PhysicsWorld>();
+        if (!world) {
+            throw std::runtime_error("PhysicsComponent requires a World with a PhysicsWorld resource");
+        }
+        body = world->createBody(owner.getID());
+        entity = owner.getID();
+        events = owner.getWorld().getResource<EventBus>();
+    }
+
+    void PhysicsComponent::onDetach(Entity &) {
+        setCollisionCallback(nullptr);
+        if (world && body != PhysicsWorld::NoBody) {
+            world->destroyBody(body);
+            body = PhysicsWorld::NoBody;
+        }
     }
 
     void PhysicsComponent::applyForce(const Vector3 &force) {
-        acceleration += force;
+        world->addForce(body, force);
     }
 
     void PhysicsComponent::applyImpulse(const Vector3 &impulse) {
-        velocity += impulse;
+        world->addVelocity(body, impulse * world->getInverseMass(body));
     }
 
     void PhysicsComponent::resetAcceleration() {
-        acceleration = Vector3(0.0f, 0.0f, 0.0f);
+        world->clearForce(body);
+    }
+
+    void PhysicsComponent::setCollisionCallback(std::function<void(const CollisionEvent &)> callback) {
+        if (events) {
+            events->unsubscribe<CollisionEvent>(collisionSubscription);
+            collisionSubscription = EventBus::Subscription();
+        }
+        if (!callback) return;
+        if (!events) {
+            throw std::runtime_error("Collision callbacks require a World with an EventBus resource");
+        }
+        collisionSubscription = events->subscribe<CollisionEvent>(entity, std::move(callback));
+    }
+
+    Vector3 PhysicsComponent::getVelocity() const {
+        return world->getVelocity(body);
+    }
+
+    void PhysicsComponent::setVelocity(const Vector3 &velocity) {
+        world->setVelocity(body, velocity);
+    }
+
+    void PhysicsComponent::setMass(float mass) {
+        world->setInverseMass(body, mass > 0.0f ? 1.0f / mass : 0.0f);
+    }
+
+    float PhysicsComponent::getMass() const {
+        float inverseMass = world->getInverseMass(body);
+        return inverseMass > 0.0f ? 1.0f / inverseMass : 0.0f;
+    }
+
+    void PhysicsComponent::setContinuous(bool continuous) {
+        world->setContinuous(body, continuous);
     }
 
-    void PhysicsComponent::onCollide(CollisionEvent e) {
-        acceleration *= -1;
+    bool PhysicsComponent::isContinuous() const {
+        return world->isContinuous(body);
     }
 }
\ No newline at end of file
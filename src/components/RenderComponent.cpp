@@ -12,14 +12,14 @@ namespace ParteeEngine {
         owner.ensureComponent<TransformComponent>();
     }
 
-    void RenderComponent::render(Entity& owner, Renderer& renderer) 
+    void RenderComponent::render(Entity& owner, Renderer& renderer, float alpha) 
     {
         if (!visible) return;
         
         auto transform = owner.getComponent<TransformComponent>();
         if (!transform) return;
         
-        const Vector3& pos = transform->getPosition();
+        const Vector3 pos = transform->getInterpolatedPosition(alpha);
         
         // Use high-level renderer API
         switch (type) {
@@ -29,6 +29,9 @@ namespace ParteeEngine {
             case CUBE:
                 renderer.drawCube(pos, Vector3(1.0f, 1.0f, 1.0f));
                 break;
+            case MESH:
+                if (mesh) renderer.drawMesh(*mesh, pos);
+                break;
         }
     }
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "components/ColliderComponent.hpp"
 
+#include <algorithm>
+
 #include "Entity.hpp"
 #include "components/TransformComponent.hpp"
 #include "events/EventBus.hpp"
@@ -11,8 +13,31 @@ namespace ParteeEngine
         owner.ensureComponent<TransformComponent>();
     }
 
-    // ColliderComponent::ColliderType ColliderComponent::getColliderType() const 
-    // {
-    //     return ColliderType::SQUARE;
-    // }
-}
\ No newline at end of file
+    ColliderShape ColliderComponent::computeShape(const Matrix4 &world) const
+    {
+        const float *m = world.data();
+
+        // Lengths of the basis columns are the scale along each local axis
+        Vector3 columns[3] = {Vector3(m[0], m[1], m[2]), Vector3(m[4], m[5], m[6]), Vector3(m[8], m[9], m[10])};
+        Vector3 axisScale(columns[0].length(), columns[1].length(), columns[2].length());
+
+        ColliderShape result;
+        result.type = shape;
+        result.center = world.transformPoint(offset);
+        switch (shape) {
+            case Shape::AABB:
+                result.halfExtents = Vector3(halfExtents.x * axisScale.x, halfExtents.y * axisScale.y, halfExtents.z * axisScale.z);
+                break;
+            case Shape::Box:
+                for (int i = 0; i < 3; ++i) {
+                    result.axes[i] = columns[i].normalize();
+                }
+                result.halfExtents = Vector3(halfExtents.x * axisScale.x, halfExtents.y * axisScale.y, halfExtents.z * axisScale.z);
+                break;
+            case Shape::Sphere:
+                result.radius = radius * std::max(axisScale.x, std::max(axisScale.y, axisScale.z));
+                break;
+        }
+        return result;
+    }
+}
@@ -0,0 +1,56 @@
+#include "ecs/Archetype.hpp"
+
+#include <stdexcept>
+
+namespace ParteeEngine {
+
+    Archetype::Archetype(const ComponentMask &mask) : mask_(mask)
+    {
+        columnIndex_.fill(-1);
+        for (ComponentTypeId type = 0; type < MaxComponentTypes; ++type) {
+            if (mask_.test(type)) {
+                columnIndex_[type] = static_cast<int16_t>(types_.size());
+                types_.push_back(type);
+            }
+        }
+        columns_.resize(types_.size());
+    }
+
+    void Archetype::setColumn(ComponentTypeId type, std::unique_ptr<IComponentColumn> column)
+    {
+        if (!has(type)) {
+            throw std::runtime_error("Component type is not part of this archetype");
+        }
+        columns_[columnIndex_[type]] = std::move(column);
+    }
+
+    void Archetype::moveFrom(Archetype &src, size_t srcRow)
+    {
+        for (size_t i = 0; i < types_.size(); ++i) {
+            IComponentColumn *srcColumn = src.getColumn(types_[i]);
+            if (srcColumn) {
+                srcColumn->moveTo(srcRow, *columns_[i]);
+            }
+        }
+    }
+
+    size_t Archetype::addEntity(EntityHandle entity)
+    {
+        entities_.push_back(entity);
+        return entities_.size() - 1;
+    }
+
+    EntityHandle Archetype::removeRow(size_t row)
+    {
+        for (auto &column : columns_) {
+            column->swapRemove(row);
+        }
+
+        EntityHandle moved = entities_.back();
+        entities_[row] = moved;
+        entities_.pop_back();
+
+        return row < entities_.size() ? moved : EntityHandle();
+    }
+
+} // namespace ParteeEngine
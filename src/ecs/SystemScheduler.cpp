@@ -0,0 +1,74 @@
+#include "ecs/SystemScheduler.hpp"
+
+#include "jobs/ThreadPool.hpp"
+
+namespace ParteeEngine {
+
+    System &SystemScheduler::addSystem(std::string name, System::UpdateFn update)
+    {
+        systems_.push_back(std::make_unique<System>(std::move(name), std::move(update)));
+        dirty_ = true;
+        return *systems_.back();
+    }
+
+    const std::vector<size_t> &SystemScheduler::getDependents(size_t i)
+    {
+        if (dirty_) {
+            buildGraph();
+        }
+        return dependents_[i];
+    }
+
+    void SystemScheduler::buildGraph()
+    {
+        size_t count = systems_.size();
+        dependents_.assign(count, {});
+        dependencyCounts_.assign(count, 0);
+        remaining_ = std::make_unique<std::atomic<int>[]>(count);
+
+        for (size_t later = 0; later < count; ++later) {
+            for (size_t earlier = 0; earlier < later; ++earlier) {
+                if (systems_[earlier]->conflictsWith(*systems_[later])) {
+                    dependents_[earlier].push_back(later);
+                    dependencyCounts_[later]++;
+                }
+            }
+        }
+
+        dirty_ = false;
+    }
+
+    void SystemScheduler::run(World &world, ThreadPool &jobs, float dt)
+    {
+        if (dirty_) {
+            buildGraph();
+        }
+
+        for (size_t i = 0; i < systems_.size(); ++i) {
+            remaining_[i].store(dependencyCounts_[i], std::memory_order_relaxed);
+        }
+
+        SystemContext context{world, jobs, dt};
+        JobCounter counter;
+        for (size_t i = 0; i < systems_.size(); ++i) {
+            if (dependencyCounts_[i] == 0) {
+                launch(i, context, counter);
+            }
+        }
+        jobs.wait(counter);
+    }
+
+    void SystemScheduler::launch(size_t index, SystemContext &context, JobCounter &counter)
+    {
+        context.jobs.submit([this, index, &context, &counter]() {
+            systems_[index]->run(context);
+
+            for (size_t next : dependents_[index]) {
+                if (remaining_[next].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    launch(next, context, counter);
+                }
+            }
+        }, counter);
+    }
+
+} // namespace ParteeEngine
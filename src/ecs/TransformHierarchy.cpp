@@ -0,0 +1,473 @@
+#include "ecs/TransformHierarchy.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "jobs/ThreadPool.hpp"
+#include "math/MathBatch.hpp"
+
+namespace ParteeEngine {
+
+    namespace {
+        // Nodes per job when a level is split across threads
+        constexpr size_t LevelGrainSize = 4096;
+
+        // Node swaps a move may take in place before a full relayout becomes cheaper
+        constexpr size_t MinRelayoutSwaps = 1024;
+    }
+
+    void TransformHierarchy::setParent(EntityHandle child, EntityHandle parent)
+    {
+        if (!child.isValid() || child == parent) {
+            throw std::runtime_error("TransformHierarchy::setParent: invalid child");
+        }
+
+        // Grow the link table before taking references into it
+        linkFor(child);
+        if (parent.isValid()) {
+            linkFor(parent);
+            for (uint32_t index = parent.index; index != None; index = links_[index].parent) {
+                if (index == child.index) {
+                    throw std::runtime_error("TransformHierarchy::setParent: would create a cycle");
+                }
+            }
+        }
+
+        uint32_t oldParent = links_[child.index].parent;
+        unlink(child.index);
+
+        Link &childLink = links_[child.index];
+        if (parent.isValid()) {
+            Link &parentLink = links_[parent.index];
+            childLink.parent = parent.index;
+            childLink.nextSibling = parentLink.firstChild;
+            if (parentLink.firstChild != None) {
+                links_[parentLink.firstChild].previousSibling = child.index;
+            }
+            parentLink.firstChild = child.index;
+        }
+
+        childLink.reparented = true;
+
+        if (parent.isValid()) {
+            updateMembership(parent.index);
+        }
+        updateMembership(child.index);
+        placeSubtree(child.index);
+        if (oldParent != None) {
+            updateMembership(oldParent);
+        }
+    }
+
+    void TransformHierarchy::remove(EntityHandle entity)
+    {
+        Link *link = findLink(entity);
+        if (!link) {
+            return;
+        }
+
+        // Children become roots
+        std::vector<uint32_t> children;
+        uint32_t child = link->firstChild;
+        while (child != None) {
+            Link &childLink = links_[child];
+            uint32_t next = childLink.nextSibling;
+            children.push_back(child);
+            childLink.parent = None;
+            childLink.nextSibling = None;
+            childLink.previousSibling = None;
+            childLink.reparented = true;
+            child = next;
+        }
+        link->firstChild = None;
+
+        uint32_t oldParent = link->parent;
+        unlink(entity.index);
+        for (uint32_t orphan : children) {
+            updateMembership(orphan);
+            placeSubtree(orphan);
+        }
+        if (!topologyDirty_ && links_[entity.index].node >= 0) {
+            eraseNode(entity.index);
+        }
+        if (oldParent != None) {
+            updateMembership(oldParent);
+        }
+        links_[entity.index] = Link();
+    }
+
+    EntityHandle TransformHierarchy::getParent(EntityHandle entity) const
+    {
+        const Link *link = findLink(entity);
+        if (!link || link->parent == None) {
+            return EntityHandle();
+        }
+        return links_[link->parent].entity;
+    }
+
+    std::vector<EntityHandle> TransformHierarchy::getChildren(EntityHandle entity) const
+    {
+        std::vector<EntityHandle> children;
+        const Link *link = findLink(entity);
+        if (link) {
+            for (uint32_t child = link->firstChild; child != None; child = links_[child].nextSibling) {
+                children.push_back(links_[child].entity);
+            }
+        }
+        return children;
+    }
+
+    int32_t TransformHierarchy::getNode(EntityHandle entity) const
+    {
+        const Link *link = findLink(entity);
+        return link && isMember(*link) ? link->node : -1;
+    }
+
+    void TransformHierarchy::rebuild()
+    {
+        if (!topologyDirty_) {
+            return;
+        }
+        topologyDirty_ = false;
+
+        std::vector<uint32_t> nodeEntity;
+        std::vector<int32_t> nodeParent;
+        std::vector<Matrix4> local;
+        std::vector<Matrix4> world;
+        std::vector<uint8_t> dirty;
+        std::vector<size_t> levelStart;
+
+        std::vector<uint32_t> level;
+        std::vector<uint32_t> nextLevel;
+        size_t memberCount = 0;
+        for (uint32_t index = 0; index < links_.size(); ++index) {
+            Link &link = links_[index];
+            if (!isMember(link)) {
+                link.node = -1;
+                link.reparented = false;
+                continue;
+            }
+            memberCount++;
+            if (link.parent == None) {
+                level.push_back(index);
+            }
+        }
+
+        nodeEntity.reserve(memberCount);
+        nodeParent.reserve(memberCount);
+        local.reserve(memberCount);
+        world.reserve(memberCount);
+        dirty.reserve(memberCount);
+
+        bool anyDirty = false;
+        while (!level.empty()) {
+            levelStart.push_back(nodeEntity.size());
+            nextLevel.clear();
+
+            for (uint32_t index : level) {
+                Link &link = links_[index];
+                int32_t node = static_cast<int32_t>(nodeEntity.size());
+                nodeEntity.push_back(index);
+                nodeParent.push_back(link.parent == None ? -1 : links_[link.parent].node);
+
+                // Carry over matrices from the previous layout; new nodes wait for a local matrix
+                int32_t old = link.node;
+                if (old >= 0 && static_cast<size_t>(old) < nodeEntity_.size() && nodeEntity_[old] == index) {
+                    local.push_back(local_[old]);
+                    world.push_back(world_[old]);
+                    dirty.push_back(dirty_[old] || link.reparented);
+                } else {
+                    local.push_back(Matrix4::identity());
+                    world.push_back(Matrix4::identity());
+                    dirty.push_back(1);
+                }
+                anyDirty = anyDirty || dirty.back();
+
+                link.node = node;
+                link.reparented = false;
+                for (uint32_t child = link.firstChild; child != None; child = links_[child].nextSibling) {
+                    nextLevel.push_back(child);
+                }
+            }
+            level.swap(nextLevel);
+        }
+        levelStart.push_back(nodeEntity.size());
+
+        nodeEntity_.swap(nodeEntity);
+        nodeParent_.swap(nodeParent);
+        local_.swap(local);
+        world_.swap(world);
+        dirty_.swap(dirty);
+        levelStart_.swap(levelStart);
+        if (anyDirty) {
+            anyDirty_.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    void TransformHierarchy::setLocalMatrix(int32_t node, const Matrix4 &local)
+    {
+        local_[node] = local;
+        dirty_[node] = 1;
+        anyDirty_.store(true, std::memory_order_relaxed);
+    }
+
+    void TransformHierarchy::update(ThreadPool *jobs)
+    {
+        updatedNodes_ = 0;
+        if (!anyDirty_.exchange(false) || levelStart_.size() < 2) {
+            return;
+        }
+
+        // Roots: the world matrix is the local one
+        size_t updated = 0;
+        for (size_t i = 0; i < levelStart_[1]; ++i) {
+            if (dirty_[i]) {
+                world_[i] = local_[i];
+                updated++;
+            }
+        }
+
+        // Every parent sits in an earlier level, so each level only reads finished results
+        std::atomic<size_t> levelUpdated{0};
+        auto sweep = [this, &levelUpdated](size_t begin, size_t end) {
+            size_t count = 0;
+            for (size_t i = begin; i < end;) {
+                // Siblings are mostly adjacent: below a dirty parent the whole run is one batch
+                int32_t parent = nodeParent_[i];
+                size_t runEnd = i + 1;
+                while (runEnd < end && nodeParent_[runEnd] == parent) {
+                    runEnd++;
+                }
+                if (dirty_[parent]) {
+                    std::fill(dirty_.begin() + i, dirty_.begin() + runEnd, 1);
+                    multiplyMatrices(world_[parent], &local_[i], &world_[i], runEnd - i);
+                    count += runEnd - i;
+                } else {
+                    for (size_t node = i; node < runEnd; ++node) {
+                        if (dirty_[node]) {
+                            world_[node] = world_[parent] * local_[node];
+                            count++;
+                        }
+                    }
+                }
+                i = runEnd;
+            }
+            levelUpdated.fetch_add(count, std::memory_order_relaxed);
+        };
+
+        for (size_t d = 1; d + 1 < levelStart_.size(); ++d) {
+            if (jobs) {
+                jobs->parallelFor(levelStart_[d], levelStart_[d + 1], LevelGrainSize, sweep);
+            } else {
+                sweep(levelStart_[d], levelStart_[d + 1]);
+            }
+        }
+
+        updatedNodes_ = updated + levelUpdated.load();
+        std::fill(dirty_.begin(), dirty_.end(), 0);
+    }
+
+    size_t TransformHierarchy::getLevel(int32_t node) const
+    {
+        return std::upper_bound(levelStart_.begin(), levelStart_.end(), static_cast<size_t>(node)) - levelStart_.begin() - 1;
+    }
+
+    void TransformHierarchy::swapNodes(int32_t a, int32_t b)
+    {
+        if (a == b) {
+            return;
+        }
+
+        std::swap(nodeEntity_[a], nodeEntity_[b]);
+        std::swap(nodeParent_[a], nodeParent_[b]);
+        std::swap(local_[a], local_[b]);
+        std::swap(world_[a], world_[b]);
+        std::swap(dirty_[a], dirty_[b]);
+
+        // Both links first: while a node changes level it can share one with its parent
+        links_[nodeEntity_[a]].node = a;
+        links_[nodeEntity_[b]].node = b;
+        for (int32_t node : {a, b}) {
+            const Link &link = links_[nodeEntity_[node]];
+            for (uint32_t child = link.firstChild; child != None; child = links_[child].nextSibling) {
+                if (links_[child].node >= 0) {
+                    nodeParent_[links_[child].node] = node;
+                }
+            }
+        }
+    }
+
+    int32_t TransformHierarchy::moveToLevel(int32_t node, size_t level)
+    {
+        // Each level crossed hands its boundary slot over to the next one
+        size_t current = getLevel(node);
+        while (current > level) {
+            int32_t first = static_cast<int32_t>(levelStart_[current]);
+            swapNodes(node, first);
+            node = first;
+            levelStart_[current]++;
+            current--;
+        }
+        while (current < level) {
+            if (current + 2 == levelStart_.size()) {
+                levelStart_.push_back(levelStart_.back());
+            }
+            int32_t last = static_cast<int32_t>(levelStart_[current + 1]) - 1;
+            swapNodes(node, last);
+            node = last;
+            levelStart_[current + 1]--;
+            current++;
+        }
+
+        while (levelStart_.size() > 1 && levelStart_[levelStart_.size() - 1] == levelStart_[levelStart_.size() - 2]) {
+            levelStart_.pop_back();
+        }
+        return node;
+    }
+
+    void TransformHierarchy::insertNode(uint32_t index)
+    {
+        // Appended to the last level; placeSubtree() moves it where it belongs
+        while (levelStart_.size() < 2) {
+            levelStart_.push_back(0);
+        }
+        links_[index].node = static_cast<int32_t>(nodeEntity_.size());
+        nodeEntity_.push_back(index);
+        nodeParent_.push_back(-1);
+        local_.push_back(Matrix4::identity());
+        world_.push_back(Matrix4::identity());
+        dirty_.push_back(1);
+        levelStart_.back()++;
+        anyDirty_.store(true, std::memory_order_relaxed);
+    }
+
+    void TransformHierarchy::eraseNode(uint32_t index)
+    {
+        int32_t node = moveToLevel(links_[index].node, getLevelCount() - 1);
+        swapNodes(node, static_cast<int32_t>(nodeEntity_.size()) - 1);
+
+        nodeEntity_.pop_back();
+        nodeParent_.pop_back();
+        local_.pop_back();
+        world_.pop_back();
+        dirty_.pop_back();
+        levelStart_.back()--;
+        while (levelStart_.size() > 1 && levelStart_[levelStart_.size() - 1] == levelStart_[levelStart_.size() - 2]) {
+            levelStart_.pop_back();
+        }
+        links_[index].node = -1;
+    }
+
+    void TransformHierarchy::placeSubtree(uint32_t index)
+    {
+        if (topologyDirty_ || links_[index].node < 0) {
+            return;
+        }
+
+        Link &root = links_[index];
+        int32_t parentNode = root.parent == None ? -1 : links_[root.parent].node;
+        size_t level = parentNode < 0 ? 0 : getLevel(parentNode) + 1;
+        size_t current = getLevel(root.node);
+        nodeParent_[root.node] = parentNode;
+        dirty_[root.node] = 1;
+        anyDirty_.store(true, std::memory_order_relaxed);
+        if (level == current) {
+            return;
+        }
+
+        // Parents first, so each node's level follows from its parent's new one. A child that
+        // just joined has no node yet and is placed when it gets one.
+        std::vector<uint32_t> subtree{index};
+        for (size_t i = 0; i < subtree.size(); ++i) {
+            for (uint32_t child = links_[subtree[i]].firstChild; child != None; child = links_[child].nextSibling) {
+                if (links_[child].node >= 0) {
+                    subtree.push_back(child);
+                }
+            }
+        }
+
+        size_t crossed = level > current ? level - current : current - level;
+        if (subtree.size() * crossed > std::max(nodeEntity_.size() / 4, MinRelayoutSwaps)) {
+            topologyDirty_ = true;
+            return;
+        }
+
+        for (uint32_t entity : subtree) {
+            // Moving down can swap the parent itself, so its node is read again afterwards
+            Link &link = links_[entity];
+            size_t target = link.parent == None ? 0 : getLevel(links_[link.parent].node) + 1;
+            int32_t node = moveToLevel(link.node, target);
+            nodeParent_[node] = link.parent == None ? -1 : links_[link.parent].node;
+        }
+    }
+
+    void TransformHierarchy::updateMembership(uint32_t index)
+    {
+        if (topologyDirty_) {
+            return;
+        }
+
+        Link &link = links_[index];
+        if (isMember(link) && link.node < 0) {
+            insertNode(index);
+            placeSubtree(index);
+        } else if (!isMember(link) && link.node >= 0) {
+            eraseNode(index);
+        }
+    }
+
+    TransformHierarchy::Link *TransformHierarchy::findLink(EntityHandle entity)
+    {
+        if (entity.index >= links_.size() || links_[entity.index].entity != entity) {
+            return nullptr;
+        }
+        return &links_[entity.index];
+    }
+
+    const TransformHierarchy::Link *TransformHierarchy::findLink(EntityHandle entity) const
+    {
+        if (entity.index >= links_.size() || links_[entity.index].entity != entity) {
+            return nullptr;
+        }
+        return &links_[entity.index];
+    }
+
+    TransformHierarchy::Link &TransformHierarchy::linkFor(EntityHandle entity)
+    {
+        if (entity.index >= links_.size()) {
+            links_.resize(entity.index + 1);
+        }
+
+        Link &link = links_[entity.index];
+        if (link.entity != entity) {
+            // The slot belonged to a destroyed entity that was never removed
+            if (link.entity.isValid()) {
+                remove(link.entity);
+            }
+            links_[entity.index].entity = entity;
+        }
+        return links_[entity.index];
+    }
+
+    void TransformHierarchy::unlink(uint32_t child)
+    {
+        Link &link = links_[child];
+        if (link.parent == None) {
+            return;
+        }
+
+        if (link.previousSibling != None) {
+            links_[link.previousSibling].nextSibling = link.nextSibling;
+        } else {
+            links_[link.parent].firstChild = link.nextSibling;
+        }
+        if (link.nextSibling != None) {
+            links_[link.nextSibling].previousSibling = link.previousSibling;
+        }
+
+        link.parent = None;
+        link.nextSibling = None;
+        link.previousSibling = None;
+    }
+
+} // namespace ParteeEngine
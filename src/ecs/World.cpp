@@ -0,0 +1,182 @@
+#include "ecs/World.hpp"
+
+namespace ParteeEngine {
+
+    World::World()
+    {
+        auto empty = std::make_unique<Archetype>(ComponentMask{});
+        emptyArchetype_ = empty.get();
+        archetypeIndex_.emplace(ComponentMask{}, emptyArchetype_);
+        archetypes_.push_back(std::move(empty));
+    }
+
+    EntityHandle World::createEntity()
+    {
+        uint32_t index;
+        if (!freeList_.empty()) {
+            index = freeList_.back();
+            freeList_.pop_back();
+        } else {
+            index = static_cast<uint32_t>(records_.size());
+            records_.push_back({nullptr, 0, 0});
+        }
+
+        EntityRecord &record = records_[index];
+        EntityHandle handle(index, record.generation);
+        record.archetype = emptyArchetype_;
+        record.row = emptyArchetype_->addEntity(handle);
+        return handle;
+    }
+
+    bool World::destroyEntity(EntityHandle entity)
+    {
+        EntityRecord *record = findRecord(entity);
+        if (!record) {
+            return false;
+        }
+
+        EntityHandle moved = record->archetype->removeRow(record->row);
+        if (moved.isValid()) {
+            records_[moved.index].row = record->row;
+        }
+
+        record->archetype = nullptr;
+        record->row = 0;
+        record->generation++;
+        freeList_.push_back(entity.index);
+        return true;
+    }
+
+    bool World::isAlive(EntityHandle entity) const
+    {
+        return findRecord(entity) != nullptr;
+    }
+
+    Component *World::getComponent(EntityHandle entity, ComponentTypeId type)
+    {
+        EntityRecord *record = findRecord(entity);
+        if (!record) {
+            return nullptr;
+        }
+        IComponentColumn *column = record->archetype->getColumn(type);
+        return column ? column->get(record->row) : nullptr;
+    }
+
+    std::vector<Component *> World::getComponents(EntityHandle entity) const
+    {
+        std::vector<Component *> comps;
+        const EntityRecord *record = findRecord(entity);
+        if (!record) {
+            return comps;
+        }
+        for (ComponentTypeId type : record->archetype->getTypes()) {
+            comps.push_back(record->archetype->getColumn(type)->get(record->row));
+        }
+        return comps;
+    }
+
+    Query &World::getQuery(const ComponentMask &include, const ComponentMask &exclude)
+    {
+        for (auto &query : queries_) {
+            if (query->include == include && query->exclude == exclude) {
+                return *query;
+            }
+        }
+
+        auto query = std::make_unique<Query>();
+        query->include = include;
+        query->exclude = exclude;
+        for (auto &archetype : archetypes_) {
+            if (query->matches(archetype->getMask())) {
+                query->archetypes.push_back(archetype.get());
+            }
+        }
+
+        queries_.push_back(std::move(query));
+        return *queries_.back();
+    }
+
+    World::EntityRecord *World::findRecord(EntityHandle entity)
+    {
+        if (entity.index >= records_.size() || records_[entity.index].generation != entity.generation) {
+            return nullptr;
+        }
+        return &records_[entity.index];
+    }
+
+    const World::EntityRecord *World::findRecord(EntityHandle entity) const
+    {
+        if (entity.index >= records_.size() || records_[entity.index].generation != entity.generation) {
+            return nullptr;
+        }
+        return &records_[entity.index];
+    }
+
+    World::EntityRecord &World::getRecord(EntityHandle entity)
+    {
+        EntityRecord *record = findRecord(entity);
+        if (!record) {
+            throw std::runtime_error("Entity not registered.");
+        }
+        return *record;
+    }
+
+    Archetype *World::getOrCreateArchetype(const ComponentMask &mask, Archetype &src,
+                                           ComponentTypeId extraType, std::unique_ptr<IComponentColumn> extraColumn)
+    {
+        auto it = archetypeIndex_.find(mask);
+        if (it != archetypeIndex_.end()) {
+            return it->second;
+        }
+
+        auto archetype = std::make_unique<Archetype>(mask);
+        for (ComponentTypeId type : archetype->getTypes()) {
+            if (type == extraType) {
+                archetype->setColumn(type, std::move(extraColumn));
+            } else {
+                archetype->setColumn(type, src.getColumn(type)->createEmpty());
+            }
+        }
+
+        Archetype *result = archetype.get();
+        archetypeIndex_.emplace(mask, result);
+        archetypes_.push_back(std::move(archetype));
+
+        for (auto &query : queries_) {
+            if (query->matches(mask)) {
+                query->archetypes.push_back(result);
+            }
+        }
+        return result;
+    }
+
+    Archetype *World::getRemoveTarget(Archetype &src, ComponentTypeId type)
+    {
+        if (src.removeEdges[type]) {
+            return src.removeEdges[type];
+        }
+
+        ComponentMask mask = src.getMask();
+        mask.reset(type);
+
+        Archetype *target = getOrCreateArchetype(mask, src, type, nullptr);
+        src.removeEdges[type] = target;
+        target->addEdges[type] = &src;
+        return target;
+    }
+
+    void World::relocate(EntityHandle entity, Archetype &dst)
+    {
+        EntityRecord &record = records_[entity.index];
+        size_t newRow = dst.addEntity(entity);
+
+        EntityHandle moved = record.archetype->removeRow(record.row);
+        if (moved.isValid()) {
+            records_[moved.index].row = record.row;
+        }
+
+        record.archetype = &dst;
+        record.row = newRow;
+    }
+
+} // namespace ParteeEngine
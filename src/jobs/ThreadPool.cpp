@@ -0,0 +1,170 @@
+#include "jobs/ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace ParteeEngine {
+
+    namespace {
+        thread_local const ThreadPool *currentPool = nullptr;
+        thread_local size_t currentIndex = 0;
+    }
+
+    ThreadPool::ThreadPool(size_t workerCount)
+    {
+        if (workerCount == 0) {
+            unsigned int hardware = std::thread::hardware_concurrency();
+            workerCount = hardware > 1 ? hardware - 1 : 0;
+        }
+
+        for (size_t i = 0; i < workerCount + 1; ++i) {
+            queues_.push_back(std::make_unique<Queue>());
+        }
+        for (size_t i = 0; i < workerCount; ++i) {
+            workers_.emplace_back(&ThreadPool::workerLoop, this, i + 1);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            stopping_ = true;
+        }
+        wakeup_.notify_all();
+
+        for (auto &worker : workers_) {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::submit(std::function<void()> job, JobCounter &counter)
+    {
+        counter.pending.fetch_add(1, std::memory_order_relaxed);
+
+        Queue &queue = *queues_[currentQueue()];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.jobs.push_back({std::move(job), &counter});
+        }
+        queued_.fetch_add(1, std::memory_order_release);
+
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+        }
+        wakeup_.notify_one();
+    }
+
+    void ThreadPool::wait(JobCounter &counter)
+    {
+        size_t home = currentQueue();
+        while (!counter.done()) {
+            if (!tryRunJob(home)) {
+                std::this_thread::yield();
+            }
+        }
+
+        if (counter.error) {
+            std::exception_ptr error;
+            std::swap(error, counter.error);
+            std::rethrow_exception(error);
+        }
+    }
+
+    void ThreadPool::parallelFor(size_t begin, size_t end, size_t grainSize, const std::function<void(size_t, size_t)> &fn)
+    {
+        if (begin >= end) {
+            return;
+        }
+
+        grainSize = std::max<size_t>(grainSize, 1);
+        if (end - begin <= grainSize || workers_.empty()) {
+            fn(begin, end);
+            return;
+        }
+
+        JobCounter counter;
+        for (size_t chunk = begin; chunk < end; chunk += grainSize) {
+            size_t chunkEnd = std::min(chunk + grainSize, end);
+            submit([&fn, chunk, chunkEnd]() { fn(chunk, chunkEnd); }, counter);
+        }
+        wait(counter);
+    }
+
+    void ThreadPool::workerLoop(size_t index)
+    {
+        currentPool = this;
+        currentIndex = index;
+
+        while (true) {
+            if (tryRunJob(index)) {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            wakeup_.wait(lock, [this]() { return stopping_ || queued_.load(std::memory_order_acquire) > 0; });
+            if (stopping_ && queued_.load(std::memory_order_acquire) == 0) {
+                return;
+            }
+        }
+    }
+
+    bool ThreadPool::tryRunJob(size_t home)
+    {
+        Job job;
+        if (popLocal(home, job) || steal(home, job)) {
+            execute(job);
+            return true;
+        }
+        return false;
+    }
+
+    bool ThreadPool::popLocal(size_t index, Job &job)
+    {
+        Queue &queue = *queues_[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty()) {
+            return false;
+        }
+
+        job = std::move(queue.jobs.back());
+        queue.jobs.pop_back();
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool ThreadPool::steal(size_t thief, Job &job)
+    {
+        for (size_t offset = 1; offset < queues_.size(); ++offset) {
+            Queue &queue = *queues_[(thief + offset) % queues_.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.jobs.empty()) {
+                continue;
+            }
+
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    void ThreadPool::execute(Job &job)
+    {
+        try {
+            job.fn();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(job.counter->errorMutex);
+            if (!job.counter->error) {
+                job.counter->error = std::current_exception();
+            }
+        }
+        job.counter->pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    size_t ThreadPool::currentQueue() const
+    {
+        return currentPool == this ? currentIndex : 0;
+    }
+
+} // namespace ParteeEngine
@@ -1,16 +1,35 @@
 #include "Engine.hpp"
 #include "Entity.hpp"
+#include "Renderer.hpp"
 #include "components/RenderComponent.hpp"
 #include "components/PhysicsComponent.hpp"
 #include "components/TransformComponent.hpp"
 #include "events/EventBus.hpp"
+#include "platform/SoftwareRenderContext.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
 #include <utility>
 
-int main() 
+int main(int argc, char** argv) 
 {   
-    ParteeEngine::Engine engine(800, 600);
+    // Usage: main [--headless [ticks] | --software [ticks]]
+    // --software renders every tick offscreen and writes the last frame to frame.ppm.
+    bool headless = argc > 1 && std::strcmp(argv[1], "--headless") == 0;
+    bool software = argc > 1 && std::strcmp(argv[1], "--software") == 0;
+    uint64_t ticks = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 600;
 
-    ParteeEngine::Entity& thingy = engine.createEntity();
+    ParteeEngine::PlatformBackend backend = ParteeEngine::PlatformBackend::Native;
+    if (headless) backend = ParteeEngine::PlatformBackend::Headless;
+    if (software) backend = ParteeEngine::PlatformBackend::Software;
+
+    ParteeEngine::Engine engine(800, 600, backend);
+
+    // Forces only last one tick, so the constant upward pull is set as gravity
+    engine.getPhysicsWorld().setGravity(ParteeEngine::Vector3(0.0f, 30.0f, 0.0f));
+
+    ParteeEngine::Entity thingy = engine.createEntity();
 
     thingy.addComponent<ParteeEngine::RenderComponent>();
 
@@ -18,9 +37,32 @@ int main()
     thingy.getComponent<ParteeEngine::TransformComponent>()->setPosition(-3, -2, 0);
 
     thingy.getComponent<ParteeEngine::PhysicsComponent>()->applyImpulse(ParteeEngine::Vector3(5.0f, 0.0f, 0.0f));
-    thingy.getComponent<ParteeEngine::PhysicsComponent>()->applyForce(ParteeEngine::Vector3(0.0f, 30.0f, 0.0f));
+
+    if (engine.isHeadless()) {
+        auto begin = std::chrono::steady_clock::now();
+        engine.run(ticks);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+        const ParteeEngine::Vector3& pos = thingy.getComponent<ParteeEngine::TransformComponent>()->getPosition();
+        std::cout << engine.getTickCount() << " ticks in " << seconds << "s, thingy at ("
+                  << pos.x << ", " << pos.y << ", " << pos.z << ")" << std::endl;
+
+        if (software) {
+            auto& context = static_cast<ParteeEngine::SoftwareRenderContext&>(engine.getRenderer().getRenderContext());
+            context.savePPM("frame.ppm");
+
+            const ParteeEngine::RenderStats& stats = engine.getRenderer().getFrameStats();
+            std::cout << "last frame: " << stats.commands << " commands, " << stats.batches << " batches, "
+                      << stats.vertices << " vertices, " << stats.instances << " instances" << std::endl;
+
+            const ParteeEngine::CullStats& culling = engine.getCullStats();
+            std::cout << "culling: " << culling.visible << "/" << culling.total << " visible, "
+                      << culling.occluded << " occluded, " << culling.triangles << " triangles" << std::endl;
+        }
+        return 0;
+    }
 
     engine.start();
 
     return 0;
-}
\ No newline at end of file
+}
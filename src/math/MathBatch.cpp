@@ -0,0 +1,162 @@
+#include "math/MathBatch.hpp"
+
+#include <cmath>
+
+namespace ParteeEngine {
+
+    namespace {
+        // Shared body of transformPoints/transformVectors; w is 1 for points and 0 for directions.
+        template <bool Point>
+        void transform(const Matrix4& matrix, const float* x, const float* y, const float* z,
+                       float* outX, float* outY, float* outZ, size_t count) {
+            const float* m = matrix.m;
+            size_t i = 0;
+
+#ifdef PARTEE_MATH_AVX
+            for (; i + 8 <= count; i += 8) {
+                __m256 vx = _mm256_loadu_ps(x + i);
+                __m256 vy = _mm256_loadu_ps(y + i);
+                __m256 vz = _mm256_loadu_ps(z + i);
+                __m256 r[3];
+                for (int row = 0; row < 3; ++row) {
+                    r[row] = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vx, _mm256_set1_ps(m[row])),
+                                                         _mm256_mul_ps(vy, _mm256_set1_ps(m[4 + row]))),
+                                           _mm256_mul_ps(vz, _mm256_set1_ps(m[8 + row])));
+                    if (Point) {
+                        r[row] = _mm256_add_ps(r[row], _mm256_set1_ps(m[12 + row]));
+                    }
+                }
+                _mm256_storeu_ps(outX + i, r[0]);
+                _mm256_storeu_ps(outY + i, r[1]);
+                _mm256_storeu_ps(outZ + i, r[2]);
+            }
+#endif
+
+#ifdef PARTEE_MATH_SSE
+            for (; i + 4 <= count; i += 4) {
+                __m128 vx = _mm_loadu_ps(x + i);
+                __m128 vy = _mm_loadu_ps(y + i);
+                __m128 vz = _mm_loadu_ps(z + i);
+                __m128 r[3];
+                for (int row = 0; row < 3; ++row) {
+                    r[row] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, _mm_set1_ps(m[row])),
+                                                   _mm_mul_ps(vy, _mm_set1_ps(m[4 + row]))),
+                                        _mm_mul_ps(vz, _mm_set1_ps(m[8 + row])));
+                    if (Point) {
+                        r[row] = _mm_add_ps(r[row], _mm_set1_ps(m[12 + row]));
+                    }
+                }
+                _mm_storeu_ps(outX + i, r[0]);
+                _mm_storeu_ps(outY + i, r[1]);
+                _mm_storeu_ps(outZ + i, r[2]);
+            }
+#endif
+
+            for (; i < count; ++i) {
+                float px = x[i], py = y[i], pz = z[i];
+                float w = Point ? 1.0f : 0.0f;
+                outX[i] = m[0] * px + m[4] * py + m[8] * pz + m[12] * w;
+                outY[i] = m[1] * px + m[5] * py + m[9] * pz + m[13] * w;
+                outZ[i] = m[2] * px + m[6] * py + m[10] * pz + m[14] * w;
+            }
+        }
+    }
+
+    void transformPoints(const Matrix4& m, const float* x, const float* y, const float* z,
+                         float* outX, float* outY, float* outZ, size_t count) {
+        transform<true>(m, x, y, z, outX, outY, outZ, count);
+    }
+
+    void transformVectors(const Matrix4& m, const float* x, const float* y, const float* z,
+                          float* outX, float* outY, float* outZ, size_t count) {
+        transform<false>(m, x, y, z, outX, outY, outZ, count);
+    }
+
+    void normalizeVectors(float* x, float* y, float* z, size_t count) {
+        size_t i = 0;
+
+#ifdef PARTEE_MATH_AVX
+        for (; i + 8 <= count; i += 8) {
+            __m256 vx = _mm256_loadu_ps(x + i);
+            __m256 vy = _mm256_loadu_ps(y + i);
+            __m256 vz = _mm256_loadu_ps(z + i);
+            __m256 lengthSq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy)), _mm256_mul_ps(vz, vz));
+
+            // Approximate 1/sqrt refined by one Newton-Raphson step; zero-length lanes are masked to zero
+            __m256 estimate = _mm256_rsqrt_ps(lengthSq);
+            __m256 halfLengthSq = _mm256_mul_ps(lengthSq, _mm256_set1_ps(0.5f));
+            estimate = _mm256_mul_ps(estimate, _mm256_sub_ps(_mm256_set1_ps(1.5f),
+                                     _mm256_mul_ps(halfLengthSq, _mm256_mul_ps(estimate, estimate))));
+            estimate = _mm256_and_ps(estimate, _mm256_cmp_ps(lengthSq, _mm256_setzero_ps(), _CMP_GT_OQ));
+
+            _mm256_storeu_ps(x + i, _mm256_mul_ps(vx, estimate));
+            _mm256_storeu_ps(y + i, _mm256_mul_ps(vy, estimate));
+            _mm256_storeu_ps(z + i, _mm256_mul_ps(vz, estimate));
+        }
+#endif
+
+#ifdef PARTEE_MATH_SSE
+        for (; i + 4 <= count; i += 4) {
+            __m128 vx = _mm_loadu_ps(x + i);
+            __m128 vy = _mm_loadu_ps(y + i);
+            __m128 vz = _mm_loadu_ps(z + i);
+            __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz));
+
+            __m128 estimate = _mm_rsqrt_ps(lengthSq);
+            __m128 halfLengthSq = _mm_mul_ps(lengthSq, _mm_set1_ps(0.5f));
+            estimate = _mm_mul_ps(estimate, _mm_sub_ps(_mm_set1_ps(1.5f),
+                                  _mm_mul_ps(halfLengthSq, _mm_mul_ps(estimate, estimate))));
+            estimate = _mm_and_ps(estimate, _mm_cmpgt_ps(lengthSq, _mm_setzero_ps()));
+
+            _mm_storeu_ps(x + i, _mm_mul_ps(vx, estimate));
+            _mm_storeu_ps(y + i, _mm_mul_ps(vy, estimate));
+            _mm_storeu_ps(z + i, _mm_mul_ps(vz, estimate));
+        }
+#endif
+
+        for (; i < count; ++i) {
+            float lengthSq = x[i] * x[i] + y[i] * y[i] + z[i] * z[i];
+            float inv = lengthSq > 0.0f ? 1.0f / std::sqrt(lengthSq) : 0.0f;
+            x[i] *= inv;
+            y[i] *= inv;
+            z[i] *= inv;
+        }
+    }
+
+    void multiplyMatrices(const Matrix4* a, const Matrix4* b, Matrix4* out, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = a[i] * b[i];
+        }
+    }
+
+    void multiplyMatrices(const Matrix4& parent, const Matrix4* b, Matrix4* out, size_t count) {
+#ifdef PARTEE_MATH_SSE
+        // Keep the parent's columns in registers across the whole batch
+        __m128 c0 = _mm_load_ps(parent.m);
+        __m128 c1 = _mm_load_ps(parent.m + 4);
+        __m128 c2 = _mm_load_ps(parent.m + 8);
+        __m128 c3 = _mm_load_ps(parent.m + 12);
+        for (size_t i = 0; i < count; ++i) {
+            // Load each child column once and broadcast its lanes with shuffles;
+            // scalar set1 loads were half the cost of this loop
+            const float* child = b[i].m;
+            __m128 r[4];
+            for (int j = 0; j < 4; ++j) {
+                __m128 column = _mm_load_ps(child + j * 4);
+                r[j] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_shuffle_ps(column, column, _MM_SHUFFLE(0, 0, 0, 0))),
+                                             _mm_mul_ps(c1, _mm_shuffle_ps(column, column, _MM_SHUFFLE(1, 1, 1, 1)))),
+                                  _mm_add_ps(_mm_mul_ps(c2, _mm_shuffle_ps(column, column, _MM_SHUFFLE(2, 2, 2, 2))),
+                                             _mm_mul_ps(c3, _mm_shuffle_ps(column, column, _MM_SHUFFLE(3, 3, 3, 3)))));
+            }
+            for (int j = 0; j < 4; ++j) {
+                _mm_store_ps(out[i].m + j * 4, r[j]);
+            }
+        }
+#else
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = parent * b[i];
+        }
+#endif
+    }
+
+}
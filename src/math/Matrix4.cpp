@@ -0,0 +1,213 @@
+#include "math/Matrix4.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace ParteeEngine {
+
+    Matrix4::Matrix4() : m{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1} {
+    }
+
+    Matrix4::Matrix4(const float* columnMajor) {
+        std::memcpy(m, columnMajor, sizeof(m));
+    }
+
+    Matrix4 Matrix4::translation(const Vector3& t) {
+        Matrix4 result;
+        result.m[12] = t.x;
+        result.m[13] = t.y;
+        result.m[14] = t.z;
+        return result;
+    }
+
+    Matrix4 Matrix4::scale(const Vector3& s) {
+        Matrix4 result;
+        result.m[0] = s.x;
+        result.m[5] = s.y;
+        result.m[10] = s.z;
+        return result;
+    }
+
+    Matrix4 Matrix4::rotation(const Vector3& eulerDegrees) {
+        return compose(Vector3(0, 0, 0), eulerDegrees, Vector3(1, 1, 1));
+    }
+
+    Matrix4 Matrix4::rotation(const Quaternion& q) {
+        return compose(Vector3(0, 0, 0), q, Vector3(1, 1, 1));
+    }
+
+    Matrix4 Matrix4::compose(const Vector3& position, const Vector3& eulerDegrees, const Vector3& s) {
+        float cx = std::cos(eulerDegrees.x * DegreesToRadians), sx = std::sin(eulerDegrees.x * DegreesToRadians);
+        float cy = std::cos(eulerDegrees.y * DegreesToRadians), sy = std::sin(eulerDegrees.y * DegreesToRadians);
+        float cz = std::cos(eulerDegrees.z * DegreesToRadians), sz = std::sin(eulerDegrees.z * DegreesToRadians);
+
+        // Columns of Ry * Rx * Rz, each scaled by its axis
+        Matrix4 result;
+        result.m[0] = (cy * cz + sy * sx * sz) * s.x;
+        result.m[1] = (cx * sz) * s.x;
+        result.m[2] = (-sy * cz + cy * sx * sz) * s.x;
+
+        result.m[4] = (-cy * sz + sy * sx * cz) * s.y;
+        result.m[5] = (cx * cz) * s.y;
+        result.m[6] = (sy * sz + cy * sx * cz) * s.y;
+
+        result.m[8] = (sy * cx) * s.z;
+        result.m[9] = (-sx) * s.z;
+        result.m[10] = (cy * cx) * s.z;
+
+        result.m[12] = position.x;
+        result.m[13] = position.y;
+        result.m[14] = position.z;
+        return result;
+    }
+
+    Matrix4 Matrix4::compose(const Vector3& position, const Quaternion& q, const Vector3& s) {
+        float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+        float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+        float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+        Matrix4 result;
+        result.m[0] = (1.0f - 2.0f * (yy + zz)) * s.x;
+        result.m[1] = 2.0f * (xy + wz) * s.x;
+        result.m[2] = 2.0f * (xz - wy) * s.x;
+
+        result.m[4] = 2.0f * (xy - wz) * s.y;
+        result.m[5] = (1.0f - 2.0f * (xx + zz)) * s.y;
+        result.m[6] = 2.0f * (yz + wx) * s.y;
+
+        result.m[8] = 2.0f * (xz + wy) * s.z;
+        result.m[9] = 2.0f * (yz - wx) * s.z;
+        result.m[10] = (1.0f - 2.0f * (xx + yy)) * s.z;
+
+        result.m[12] = position.x;
+        result.m[13] = position.y;
+        result.m[14] = position.z;
+        return result;
+    }
+
+    Matrix4 Matrix4::perspective(float fovDegrees, float aspect, float nearDistance, float farDistance) {
+        float ymax = nearDistance * std::tan(fovDegrees * DegreesToRadians / 2.0f);
+        float xmax = ymax * aspect;
+
+        Matrix4 result;
+        result.m[0] = nearDistance / xmax;
+        result.m[5] = nearDistance / ymax;
+        result.m[10] = -(farDistance + nearDistance) / (farDistance - nearDistance);
+        result.m[11] = -1.0f;
+        result.m[14] = -2.0f * farDistance * nearDistance / (farDistance - nearDistance);
+        result.m[15] = 0.0f;
+        return result;
+    }
+
+    Matrix4 Matrix4::lookAt(const Vector3& eye, const Vector3& target, const Vector3& up) {
+        Vector3 forward = (target - eye).normalize();
+        Vector3 right = forward.cross(up).normalize();
+        Vector3 trueUp = right.cross(forward);
+
+        const float columns[16] = {
+            right.x, trueUp.x, -forward.x, 0,
+            right.y, trueUp.y, -forward.y, 0,
+            right.z, trueUp.z, -forward.z, 0,
+            -right.dot(eye), -trueUp.dot(eye), forward.dot(eye), 1
+        };
+        return Matrix4(columns);
+    }
+
+    Vector3 Matrix4::transformPoint(const Vector3& p) const {
+        return Vector3(m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12],
+                       m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13],
+                       m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14]);
+    }
+
+    Vector3 Matrix4::transformVector(const Vector3& v) const {
+        return Vector3(m[0] * v.x + m[4] * v.y + m[8] * v.z,
+                       m[1] * v.x + m[5] * v.y + m[9] * v.z,
+                       m[2] * v.x + m[6] * v.y + m[10] * v.z);
+    }
+
+    Matrix4 Matrix4::transposed() const {
+        Matrix4 result;
+#ifdef PARTEE_MATH_SSE
+        __m128 c0 = _mm_load_ps(m);
+        __m128 c1 = _mm_load_ps(m + 4);
+        __m128 c2 = _mm_load_ps(m + 8);
+        __m128 c3 = _mm_load_ps(m + 12);
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        _mm_store_ps(result.m, c0);
+        _mm_store_ps(result.m + 4, c1);
+        _mm_store_ps(result.m + 8, c2);
+        _mm_store_ps(result.m + 12, c3);
+#else
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                result.m[i * 4 + j] = m[j * 4 + i];
+            }
+        }
+#endif
+        return result;
+    }
+
+    Matrix4 Matrix4::inverse() const {
+        // Cofactor expansion (as in the MESA GLU implementation)
+        float inv[16];
+        inv[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+        inv[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+        inv[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+        inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+        inv[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+        inv[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+        inv[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+        inv[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+        inv[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+        inv[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+        inv[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+        inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+        inv[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+        inv[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+        inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+        inv[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+        float det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+        if (det == 0.0f) {
+            return Matrix4();
+        }
+
+        float invDet = 1.0f / det;
+        for (float& value : inv) {
+            value *= invDet;
+        }
+        return Matrix4(inv);
+    }
+
+    Matrix4 Matrix4::affineInverse() const {
+        // Invert the upper 3x3 by cofactors, then move the translation into the new frame
+        float a = m[0], b = m[4], c = m[8];
+        float d = m[1], e = m[5], f = m[9];
+        float g = m[2], h = m[6], i = m[10];
+
+        float A = e * i - f * h, B = -(d * i - f * g), C = d * h - e * g;
+        float det = a * A + b * B + c * C;
+        if (det == 0.0f) {
+            return Matrix4();
+        }
+        float invDet = 1.0f / det;
+
+        Matrix4 result;
+        result(0, 0) = A * invDet;
+        result(0, 1) = -(b * i - c * h) * invDet;
+        result(0, 2) = (b * f - c * e) * invDet;
+        result(1, 0) = B * invDet;
+        result(1, 1) = (a * i - c * g) * invDet;
+        result(1, 2) = -(a * f - c * d) * invDet;
+        result(2, 0) = C * invDet;
+        result(2, 1) = -(a * h - b * g) * invDet;
+        result(2, 2) = (a * e - b * d) * invDet;
+
+        Vector3 t = result.transformVector(getTranslation());
+        result.m[12] = -t.x;
+        result.m[13] = -t.y;
+        result.m[14] = -t.z;
+        return result;
+    }
+
+}
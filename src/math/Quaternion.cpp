@@ -0,0 +1,90 @@
+#include "math/Quaternion.hpp"
+
+#include <cmath>
+
+namespace ParteeEngine {
+
+    Quaternion Quaternion::fromAxisAngle(const Vector3& axis, float degrees) {
+        Vector3 n = axis.normalize();
+        float half = degrees * DegreesToRadians * 0.5f;
+        float s = std::sin(half);
+        return Quaternion(n.x * s, n.y * s, n.z * s, std::cos(half));
+    }
+
+    Quaternion Quaternion::fromEuler(const Vector3& degrees) {
+        return fromAxisAngle(Vector3(0, 1, 0), degrees.y)
+             * fromAxisAngle(Vector3(1, 0, 0), degrees.x)
+             * fromAxisAngle(Vector3(0, 0, 1), degrees.z);
+    }
+
+    Quaternion Quaternion::operator*(const Quaternion& o) const {
+#ifdef PARTEE_MATH_SSE
+        // Each output lane is a signed sum of four lane-shuffled products
+        __m128 a = _mm_load_ps(&x);
+        __m128 b = _mm_load_ps(&o.x);
+        __m128 aw = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3));
+        __m128 ax = _mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0));
+        __m128 ay = _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1));
+        __m128 az = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2));
+
+        __m128 r = _mm_mul_ps(aw, b);
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(ax, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3))), _mm_setr_ps(1, -1, 1, -1)));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(ay, _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))), _mm_setr_ps(1, 1, -1, -1)));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(az, _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1))), _mm_setr_ps(-1, 1, 1, -1)));
+
+        Quaternion result;
+        _mm_store_ps(&result.x, r);
+        return result;
+#else
+        return Quaternion(w * o.x + x * o.w + y * o.z - z * o.y,
+                          w * o.y - x * o.z + y * o.w + z * o.x,
+                          w * o.z + x * o.y - y * o.x + z * o.w,
+                          w * o.w - x * o.x - y * o.y - z * o.z);
+#endif
+    }
+
+    Quaternion Quaternion::normalize() const {
+        float len = std::sqrt(dot(*this));
+        if (len > 0.0f) {
+            float inv = 1.0f / len;
+            return Quaternion(x * inv, y * inv, z * inv, w * inv);
+        }
+        return identity();
+    }
+
+    Vector3 Quaternion::rotate(const Vector3& v) const {
+        // v + 2w(q x v) + 2q x (q x v), without building the full product
+        Vector3 q(x, y, z);
+        Vector3 t = q.cross(v) * 2.0f;
+        return v + t * w + q.cross(t);
+    }
+
+    Quaternion Quaternion::nlerp(const Quaternion& a, const Quaternion& b, float t) {
+        float sign = a.dot(b) < 0.0f ? -1.0f : 1.0f;
+        return Quaternion(a.x + (b.x * sign - a.x) * t,
+                          a.y + (b.y * sign - a.y) * t,
+                          a.z + (b.z * sign - a.z) * t,
+                          a.w + (b.w * sign - a.w) * t).normalize();
+    }
+
+    Quaternion Quaternion::slerp(const Quaternion& a, const Quaternion& b, float t) {
+        float cosTheta = a.dot(b);
+        float sign = 1.0f;
+        if (cosTheta < 0.0f) {
+            cosTheta = -cosTheta;
+            sign = -1.0f;
+        }
+
+        // Nearly parallel: the sine below would vanish
+        if (cosTheta > 0.9995f) {
+            return nlerp(a, b, t);
+        }
+
+        float theta = std::acos(cosTheta);
+        float invSin = 1.0f / std::sin(theta);
+        float wa = std::sin((1.0f - t) * theta) * invSin;
+        float wb = std::sin(t * theta) * invSin * sign;
+        return Quaternion(a.x * wa + b.x * wb, a.y * wa + b.y * wb, a.z * wa + b.z * wb, a.w * wa + b.w * wb);
+    }
+
+}
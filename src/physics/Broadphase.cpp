@@ -0,0 +1,55 @@
+#include "physics/Broadphase.hpp"
+
+#include <algorithm>
+
+#include "jobs/ThreadPool.hpp"
+#include "physics/SpatialHashBroadphase.hpp"
+#include "physics/SweepAndPruneBroadphase.hpp"
+
+namespace ParteeEngine {
+
+    void Broadphase::forEachChunk(ThreadPool *jobs, size_t count, size_t grainSize,
+                                  const std::function<void(size_t, size_t, size_t)> &fn)
+    {
+        // Keep the per-chunk lists (and their capacity) across steps
+        size_t chunkCount = (count + grainSize - 1) / grainSize;
+        if (chunkPairs_.size() < chunkCount) {
+            chunkPairs_.resize(chunkCount);
+        }
+        for (std::vector<BroadphasePair> &pairs : chunkPairs_) {
+            pairs.clear();
+        }
+
+        if (!jobs) {
+            for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+                fn(chunk, chunk * grainSize, std::min(count, (chunk + 1) * grainSize));
+            }
+            return;
+        }
+        jobs->parallelFor(0, count, grainSize, [&](size_t begin, size_t end) {
+            fn(begin / grainSize, begin, end);
+        });
+    }
+
+    void Broadphase::gatherPairs()
+    {
+        size_t total = 0;
+        for (const std::vector<BroadphasePair> &pairs : chunkPairs_) {
+            total += pairs.size();
+        }
+
+        pairs_.reserve(pairs_.size() + total);
+        for (const std::vector<BroadphasePair> &pairs : chunkPairs_) {
+            pairs_.insert(pairs_.end(), pairs.begin(), pairs.end());
+        }
+    }
+
+    std::unique_ptr<Broadphase> createBroadphase(BroadphaseType type)
+    {
+        if (type == BroadphaseType::SpatialHash) {
+            return std::make_unique<SpatialHashBroadphase>();
+        }
+        return std::make_unique<SweepAndPruneBroadphase>();
+    }
+
+} // namespace ParteeEngine
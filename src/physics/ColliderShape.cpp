@@ -0,0 +1,123 @@
+#include "physics/ColliderShape.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ParteeEngine {
+
+    Aabb ColliderShape::getBounds() const
+    {
+        if (type == ShapeType::Sphere) {
+            return Aabb::fromCenter(center, Vector3(radius, radius, radius));
+        }
+
+        // Project the box onto the world axes
+        Vector3 extents;
+        for (int i = 0; i < 3; ++i) {
+            const Vector3 &axis = axes[i];
+            float h = i == 0 ? halfExtents.x : (i == 1 ? halfExtents.y : halfExtents.z);
+            extents += Vector3(std::fabs(axis.x) * h, std::fabs(axis.y) * h, std::fabs(axis.z) * h);
+        }
+        return Aabb::fromCenter(center, extents);
+    }
+
+    bool ColliderShape::raycast(const Vector3 &origin, const Vector3 &direction, float maxDistance, float &distance, Vector3 &normal) const
+    {
+        Vector3 offset = origin - center;
+
+        if (type == ShapeType::Sphere) {
+            float b = offset.dot(direction);
+            float c = offset.dot(offset) - radius * radius;
+            if (c <= 0.0f) {
+                distance = 0.0f;
+                normal = Vector3();
+                return true;
+            }
+            float discriminant = b * b - c;
+            if (b > 0.0f || discriminant < 0.0f) {
+                return false;
+            }
+            float t = -b - std::sqrt(discriminant);
+            if (t > maxDistance) {
+                return false;
+            }
+            distance = t;
+            normal = (offset + direction * t).normalize();
+            return true;
+        }
+
+        // Slab test in the box frame
+        float tEnter = 0.0f;
+        float tExit = maxDistance;
+        int enterAxis = -1;
+        float enterSign = 0.0f;
+        for (int i = 0; i < 3; ++i) {
+            float h = i == 0 ? halfExtents.x : (i == 1 ? halfExtents.y : halfExtents.z);
+            float start = offset.dot(axes[i]);
+            float speed = direction.dot(axes[i]);
+            if (std::fabs(speed) < 1e-8f) {
+                if (start < -h || start > h) {
+                    return false;
+                }
+                continue;
+            }
+            float inverse = 1.0f / speed;
+            float t0 = (-h - start) * inverse;
+            float t1 = (h - start) * inverse;
+            float sign = -1.0f;
+            if (t0 > t1) {
+                std::swap(t0, t1);
+                sign = 1.0f;
+            }
+            if (t0 > tEnter) {
+                tEnter = t0;
+                enterAxis = i;
+                enterSign = sign;
+            }
+            tExit = std::min(tExit, t1);
+            if (tEnter > tExit) {
+                return false;
+            }
+        }
+
+        distance = tEnter;
+        normal = enterAxis >= 0 ? axes[enterAxis] * enterSign : Vector3();
+        return true;
+    }
+
+    float ColliderShape::distanceTo(const Vector3 &point) const
+    {
+        Vector3 offset = point - center;
+        if (type == ShapeType::Sphere) {
+            return std::max(0.0f, offset.length() - radius);
+        }
+
+        Vector3 outside;
+        for (int i = 0; i < 3; ++i) {
+            float h = i == 0 ? halfExtents.x : (i == 1 ? halfExtents.y : halfExtents.z);
+            float excess = std::max(0.0f, std::fabs(offset.dot(axes[i])) - h);
+            if (i == 0) outside.x = excess;
+            if (i == 1) outside.y = excess;
+            if (i == 2) outside.z = excess;
+        }
+        return outside.length();
+    }
+
+    Vector3 ColliderShape::closestPoint(const Vector3 &point) const
+    {
+        Vector3 offset = point - center;
+        if (type == ShapeType::Sphere) {
+            float distance = offset.length();
+            return distance > radius ? center + offset * (radius / distance) : point;
+        }
+
+        Vector3 result = center;
+        for (int i = 0; i < 3; ++i) {
+            float h = i == 0 ? halfExtents.x : (i == 1 ? halfExtents.y : halfExtents.z);
+            result += axes[i] * std::max(-h, std::min(h, offset.dot(axes[i])));
+        }
+        return result;
+    }
+
+} // namespace ParteeEngine
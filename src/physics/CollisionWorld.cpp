@@ -0,0 +1,290 @@
+#include "physics/CollisionWorld.hpp"
+
+#include "Entity.hpp"
+#include "components/ColliderComponent.hpp"
+#include "components/TransformComponent.hpp"
+#include "ecs/TransformHierarchy.hpp"
+#include "ecs/View.hpp"
+#include "events/Event.hpp"
+#include "events/EventBus.hpp"
+#include "jobs/ThreadPool.hpp"
+#include "physics/PhysicsWorld.hpp"
+
+namespace ParteeEngine {
+
+    namespace {
+        constexpr size_t BoundsGrainSize = 4096;
+        constexpr size_t RayGrainSize = 256;
+        constexpr size_t MinRebuildProxies = 64;
+
+        // Conservative advancement stops this close to the surface
+        constexpr float SweepTolerance = 0.005f;
+        constexpr int MaxSweepIterations = 32;
+    }
+
+    CollisionWorld::CollisionWorld(BroadphaseType type) : broadphase_(createBroadphase(type))
+    {
+    }
+
+    void CollisionWorld::setBroadphase(BroadphaseType type)
+    {
+        if (broadphase_->getType() != type) {
+            broadphase_ = createBroadphase(type);
+        }
+    }
+
+    void CollisionWorld::step(World &world, ThreadPool &jobs, const TransformHierarchy &hierarchy)
+    {
+        entities_.clear();
+        colliders_.clear();
+        transforms_.clear();
+        makeView<ColliderComponent, TransformComponent>(world).each(
+            [this](Entity e, ColliderComponent &collider, TransformComponent &transform) {
+                entities_.push_back(e.getID());
+                colliders_.push_back(&collider);
+                transforms_.push_back(&transform);
+            });
+
+        const PhysicsWorld *physics = world.getResource<PhysicsWorld>();
+        previousShapes_.swap(shapes_);
+        previousBounds_.swap(bounds_);
+        shapes_.resize(entities_.size());
+        bounds_.resize(entities_.size());
+        resting_.assign(entities_.size(), 0);
+        jobs.parallelFor(0, entities_.size(), BoundsGrainSize, [this, physics, &hierarchy](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (isResting(i, physics, hierarchy)) {
+                    uint32_t previous = slots_[entities_[i].index].proxy;
+                    shapes_[i] = previousShapes_[previous];
+                    bounds_[i] = previousBounds_[previous];
+                    resting_[i] = 1;
+                    continue;
+                }
+
+                Matrix4 matrix = transforms_[i]->computeMatrix();
+                int32_t node = hierarchy.getNode(entities_[i]);
+                if (node >= 0 && hierarchy.getParentNode(node) >= 0) {
+                    matrix = hierarchy.getWorldMatrix(hierarchy.getParentNode(node)) * matrix;
+                }
+                shapes_[i] = colliders_[i]->computeShape(matrix);
+                bounds_[i] = shapes_[i].getBounds();
+            }
+        });
+
+        updateTree();
+        broadphase_->update(bounds_.data(), bounds_.size(), &jobs, resting_.data());
+        narrowphase_.collide(shapes_.data(), entities_.data(), broadphase_->getPairs(), &jobs, resting_.data(), proxyOfPrevious_.data());
+        if (EventBus *events = world.getResource<EventBus>()) {
+            dispatch(*events);
+        }
+    }
+
+    bool CollisionWorld::isResting(size_t proxy, const PhysicsWorld *physics, const TransformHierarchy &hierarchy) const
+    {
+        // Only colliders seen last step have a shape to keep
+        EntityHandle entity = entities_[proxy];
+        if (entity.index >= slots_.size()) {
+            return false;
+        }
+        const TreeSlot &slot = slots_[entity.index];
+        if (slot.entity != entity || slot.leaf == DynamicAabbTree::Null || slot.lastStep != stepCount_) {
+            return false;
+        }
+
+        const ColliderComponent &collider = *colliders_[proxy];
+        if (slot.transformVersion != transforms_[proxy]->getVersion() || slot.colliderVersion != collider.getVersion() ||
+            slot.offset.x != collider.offset.x || slot.offset.y != collider.offset.y || slot.offset.z != collider.offset.z) {
+            return false;
+        }
+
+        // A parent may have moved it without touching its own transform
+        int32_t node = hierarchy.getNode(entity);
+        if (node >= 0 && hierarchy.getParentNode(node) >= 0) {
+            return false;
+        }
+
+        uint32_t body = physics ? physics->getBody(entity) : PhysicsWorld::NoBody;
+        return body == PhysicsWorld::NoBody || !physics->isAwake(body);
+    }
+
+    void CollisionWorld::updateTree()
+    {
+        stepCount_++;
+        size_t created = 0;
+        proxyOfPrevious_.assign(previousBounds_.size(), Narrowphase::NoProxy);
+        for (size_t i = 0; i < entities_.size(); ++i) {
+            EntityHandle entity = entities_[i];
+            if (entity.index >= slots_.size()) {
+                slots_.resize(entity.index + 1);
+            }
+
+            TreeSlot &slot = slots_[entity.index];
+            if (slot.entity != entity && slot.leaf != DynamicAabbTree::Null) {
+                // The slot still holds a destroyed entity
+                tree_.destroyProxy(slot.leaf);
+                slot.leaf = DynamicAabbTree::Null;
+            }
+
+            if (slot.leaf == DynamicAabbTree::Null) {
+                slot.leaf = tree_.createProxy(bounds_[i], entity.index);
+                created++;
+            } else {
+                if (slot.lastStep + 1 == stepCount_) {
+                    proxyOfPrevious_[slot.proxy] = static_cast<uint32_t>(i);
+                }
+                if (!resting_[i]) {
+                    tree_.moveProxy(slot.leaf, bounds_[i], bounds_[i].getCenter() - slot.center);
+                }
+            }
+            slot.entity = entity;
+            slot.proxy = static_cast<uint32_t>(i);
+            slot.lastStep = stepCount_;
+            slot.center = bounds_[i].getCenter();
+            slot.transformVersion = transforms_[i]->getVersion();
+            slot.colliderVersion = colliders_[i]->getVersion();
+            slot.offset = colliders_[i]->offset;
+        }
+
+        // Colliders that were not seen this step are gone
+        for (TreeSlot &slot : slots_) {
+            if (slot.leaf != DynamicAabbTree::Null && slot.lastStep != stepCount_) {
+                tree_.destroyProxy(slot.leaf);
+                slot = TreeSlot();
+            }
+        }
+
+        // Trees built by insertion are noticeably worse than SAH-built ones, so rebuild after
+        // a wave of spawns (including the very first step)
+        if (created > MinRebuildProxies && created * 2 > tree_.getProxyCount()) {
+            tree_.rebuild();
+        }
+    }
+
+    bool CollisionWorld::raycast(const Ray &ray, RaycastHit &hit) const
+    {
+        Vector3 direction = ray.direction.normalize();
+        hit = RaycastHit();
+        tree_.raycast(ray.origin, direction, ray.maxDistance, [&](int32_t leaf, float maxDistance) {
+            float distance;
+            Vector3 normal;
+            if (!shapeOfLeaf(leaf).raycast(ray.origin, direction, maxDistance, distance, normal)) {
+                return maxDistance;
+            }
+            hit.entity = slots_[tree_.getUserData(leaf)].entity;
+            hit.distance = distance;
+            hit.normal = normal;
+            return distance;
+        });
+
+        if (!hit.entity.isValid()) {
+            return false;
+        }
+        hit.point = ray.origin + direction * hit.distance;
+        return true;
+    }
+
+    void CollisionWorld::raycastBatch(const Ray *rays, size_t count, RaycastHit *hits, ThreadPool &jobs) const
+    {
+        jobs.parallelFor(0, count, RayGrainSize, [this, rays, hits](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                raycast(rays[i], hits[i]);
+            }
+        });
+    }
+
+    void CollisionWorld::overlapBox(const Aabb &box, std::vector<EntityHandle> &out) const
+    {
+        out.clear();
+        tree_.query(box, [&](int32_t leaf) {
+            if (shapeOfLeaf(leaf).getBounds().overlaps(box)) {
+                out.push_back(slots_[tree_.getUserData(leaf)].entity);
+            }
+            return true;
+        });
+    }
+
+    void CollisionWorld::overlapSphere(const Vector3 &center, float radius, std::vector<EntityHandle> &out) const
+    {
+        out.clear();
+        tree_.query(Aabb::fromCenter(center, Vector3(radius, radius, radius)), [&](int32_t leaf) {
+            if (shapeOfLeaf(leaf).distanceTo(center) <= radius) {
+                out.push_back(slots_[tree_.getUserData(leaf)].entity);
+            }
+            return true;
+        });
+    }
+
+    void CollisionWorld::nearest(const Vector3 &point, size_t k, std::vector<EntityHandle> &out) const
+    {
+        std::vector<DynamicAabbTree::Neighbor> neighbors;
+        tree_.nearest(point, k, [&](int32_t leaf) { return shapeOfLeaf(leaf).distanceTo(point); }, neighbors);
+
+        out.clear();
+        for (const DynamicAabbTree::Neighbor &neighbor : neighbors) {
+            out.push_back(slots_[tree_.getUserData(neighbor.proxy)].entity);
+        }
+    }
+
+    bool CollisionWorld::sweepSphere(const Vector3 &center, float radius, const Vector3 &displacement, EntityHandle ignore,
+                                     SweepHit &hit) const
+    {
+        hit = SweepHit();
+        float length = displacement.length();
+        if (length <= 0.0f) {
+            return false;
+        }
+
+        Vector3 extents(radius, radius, radius);
+        Aabb swept = Aabb::fromCenter(center, extents).merged(Aabb::fromCenter(center + displacement, extents));
+        tree_.query(swept, [&](int32_t leaf) {
+            const TreeSlot &slot = slots_[tree_.getUserData(leaf)];
+            if (slot.entity == ignore) {
+                return true;
+            }
+
+            // Advance by the distance to the shape, which the sphere cannot cover without touching it
+            const ColliderShape &shape = shapes_[slot.proxy];
+            float fraction = 0.0f;
+            for (int iteration = 0; iteration < MaxSweepIterations; ++iteration) {
+                Vector3 position = center + displacement * fraction;
+                float gap = shape.distanceTo(position) - radius;
+                if (gap <= SweepTolerance) {
+                    if (fraction > 0.0f && fraction < hit.fraction) {
+                        Vector3 point = shape.closestPoint(position);
+                        hit.entity = slot.entity;
+                        hit.fraction = fraction;
+                        hit.point = point;
+                        hit.normal = (position - point).normalize();
+                    }
+                    break;
+                }
+                fraction += gap / length;
+                if (fraction >= hit.fraction) {
+                    break;
+                }
+            }
+            return true;
+        });
+        return hit.entity.isValid();
+    }
+
+    const ColliderShape *CollisionWorld::findShape(EntityHandle entity) const
+    {
+        if (entity.index >= slots_.size() || slots_[entity.index].entity != entity || slots_[entity.index].leaf == DynamicAabbTree::Null) {
+            return nullptr;
+        }
+        return &shapes_[slots_[entity.index].proxy];
+    }
+
+    void CollisionWorld::dispatch(EventBus &bus)
+    {
+        for (const ContactManifold &manifold : narrowphase_.getManifolds()) {
+            // Carried-over contacts were delivered when they were last computed
+            if (manifold.resting) {
+                continue;
+            }
+            bus.emit(CollisionEvent(manifold));
+        }
+    }
+
+} // namespace ParteeEngine
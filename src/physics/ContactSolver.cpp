@@ -0,0 +1,368 @@
+#include "physics/ContactSolver.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <numeric>
+
+#include "jobs/ThreadPool.hpp"
+#include "physics/PhysicsWorld.hpp"
+
+namespace ParteeEngine {
+
+    namespace {
+        constexpr uint32_t NoIsland = UINT32_MAX;
+
+        // Position correction: a fraction of the penetration beyond the slop is removed per step
+        constexpr float BaumgarteFactor = 0.2f;
+        constexpr float PenetrationSlop = 0.01f;
+        constexpr float MaxBiasVelocity = 4.0f;
+
+        // Islands with more contacts are colored and solved in parallel internally
+        constexpr size_t LargeIslandContacts = 256;
+        constexpr size_t IslandGrainSize = 16;
+        constexpr size_t ContactGrainSize = 64;
+
+        // Contacts beyond the 64 colors one body can hold are solved serially
+        constexpr int OverflowColor = 64;
+        constexpr int ColorCount = 65;
+    }
+
+    uint32_t ContactSolver::find(uint32_t body)
+    {
+        while (parent_[body] != body) {
+            parent_[body] = parent_[parent_[body]];
+            body = parent_[body];
+        }
+        return body;
+    }
+
+    void ContactSolver::unite(uint32_t a, uint32_t b)
+    {
+        a = find(a);
+        b = find(b);
+        if (a != b) {
+            parent_[std::max(a, b)] = std::min(a, b);
+        }
+    }
+
+    void ContactSolver::solve(PhysicsWorld &world, std::vector<ContactManifold> &manifolds, float dt, ThreadPool *jobs)
+    {
+        buildIslands(world, manifolds);
+
+        bool colorLargeIslands = jobs && jobs->getConcurrency() > 1;
+        auto isLarge = [&](const Island &island) {
+            return colorLargeIslands && island.contactEnd - island.contactBegin > LargeIslandContacts;
+        };
+
+        // Islands share no dynamic body, so they are solved independently
+        auto solveRange = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (!isLarge(islands_[i])) {
+                    solveIsland(world, islands_[i], dt);
+                }
+            }
+        };
+        if (jobs) {
+            jobs->parallelFor(0, islands_.size(), IslandGrainSize, solveRange);
+        } else {
+            solveRange(0, islands_.size());
+        }
+
+        for (const Island &island : islands_) {
+            if (isLarge(island)) {
+                solveLargeIsland(world, island, dt, *jobs);
+            }
+        }
+    }
+
+    void ContactSolver::buildIslands(PhysicsWorld &world, std::vector<ContactManifold> &manifolds)
+    {
+        size_t slots = world.getSlotCount();
+        parent_.resize(slots);
+        std::iota(parent_.begin(), parent_.end(), 0u);
+        islandOf_.assign(slots, NoIsland);
+        islands_.clear();
+
+        // Free slots have zero inverse mass, so they never count as dynamic
+        auto isDynamic = [&world](uint32_t body) { return body != PhysicsWorld::NoBody && world.inverseMass_[body] > 0.0f; };
+
+        // Connect the bodies touching each other; a moving kinematic body wakes what it touches
+        contactIslands_.assign(manifolds.size(), NoIsland);
+        for (const ContactManifold &manifold : manifolds) {
+            uint32_t a = world.getBody(manifold.first);
+            uint32_t b = world.getBody(manifold.second);
+            bool dynamicA = isDynamic(a), dynamicB = isDynamic(b);
+            if (dynamicA && dynamicB) {
+                unite(a, b);
+            } else if (dynamicA != dynamicB) {
+                uint32_t other = dynamicA ? b : a;
+                if (other != PhysicsWorld::NoBody && world.getVelocity(other).dot(world.getVelocity(other)) > 0.0f) {
+                    world.wake(dynamicA ? a : b);
+                }
+            }
+        }
+
+        // An island is simulated if any of its bodies is awake
+        for (uint32_t body = 0; body < slots; ++body) {
+            if (isDynamic(body) && world.isAwake(body)) {
+                uint32_t root = find(body);
+                if (islandOf_[root] == NoIsland) {
+                    islandOf_[root] = static_cast<uint32_t>(islands_.size());
+                    islands_.push_back(Island{0, 0, 0, 0});
+                }
+            }
+        }
+
+        // Counting sort of the bodies and contacts by island; bodyEnd and contactEnd count first
+        for (uint32_t body = 0; body < slots; ++body) {
+            if (isDynamic(body) && islandOf_[find(body)] != NoIsland) {
+                islands_[islandOf_[find(body)]].bodyEnd++;
+            }
+        }
+        for (size_t i = 0; i < manifolds.size(); ++i) {
+            uint32_t a = world.getBody(manifolds[i].first);
+            uint32_t b = world.getBody(manifolds[i].second);
+            if (isDynamic(a) || isDynamic(b)) {
+                contactIslands_[i] = islandOf_[find(isDynamic(a) ? a : b)];
+                if (contactIslands_[i] != NoIsland) {
+                    islands_[contactIslands_[i]].contactEnd++;
+                }
+            }
+        }
+
+        size_t bodyCount = 0, contactCount = 0;
+        for (Island &island : islands_) {
+            island.bodyBegin = bodyCount;
+            bodyCount += island.bodyEnd;
+            island.bodyEnd = island.bodyBegin;
+            island.contactBegin = contactCount;
+            contactCount += island.contactEnd;
+            island.contactEnd = island.contactBegin;
+        }
+
+        islandBodies_.resize(bodyCount);
+        for (uint32_t body = 0; body < slots; ++body) {
+            if (isDynamic(body) && islandOf_[find(body)] != NoIsland) {
+                islandBodies_[islands_[islandOf_[find(body)]].bodyEnd++] = body;
+                world.wake(body);
+            }
+        }
+
+        constraints_.resize(contactCount);
+        for (size_t i = 0; i < manifolds.size(); ++i) {
+            if (contactIslands_[i] == NoIsland) {
+                continue;
+            }
+            ContactConstraint &constraint = constraints_[islands_[contactIslands_[i]].contactEnd++];
+            constraint.manifold = &manifolds[i];
+            constraint.bodyA = world.getBody(manifolds[i].first);
+            constraint.bodyB = world.getBody(manifolds[i].second);
+            constraint.inverseMassA = constraint.bodyA != PhysicsWorld::NoBody ? world.inverseMass_[constraint.bodyA] : 0.0f;
+            constraint.inverseMassB = constraint.bodyB != PhysicsWorld::NoBody ? world.inverseMass_[constraint.bodyB] : 0.0f;
+        }
+    }
+
+    void ContactSolver::solveIsland(PhysicsWorld &world, const Island &island, float dt)
+    {
+        for (size_t i = island.contactBegin; i < island.contactEnd; ++i) {
+            prepare(constraints_[i], dt);
+            warmStart(world, constraints_[i]);
+        }
+        for (int iteration = 0; iteration < iterations_; ++iteration) {
+            for (size_t i = island.contactBegin; i < island.contactEnd; ++i) {
+                solveContact(world, constraints_[i]);
+            }
+        }
+        updateSleep(world, island);
+    }
+
+    void ContactSolver::solveLargeIsland(PhysicsWorld &world, const Island &island, float dt, ThreadPool &jobs)
+    {
+        colorContacts(island);
+
+        jobs.parallelFor(island.contactBegin, island.contactEnd, ContactGrainSize, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                prepare(constraints_[i], dt);
+            }
+        });
+
+        // Contacts of one color touch disjoint bodies and can be solved concurrently
+        auto eachColor = [&](auto &&fn) {
+            for (int color = 0; color < ColorCount; ++color) {
+                size_t begin = colorOffsets_[color], end = colorOffsets_[color + 1];
+                auto run = [&](size_t b, size_t e) {
+                    for (size_t i = b; i < e; ++i) {
+                        fn(constraints_[i]);
+                    }
+                };
+                if (color == OverflowColor) {
+                    run(begin, end);
+                } else if (begin < end) {
+                    jobs.parallelFor(begin, end, ContactGrainSize, run);
+                }
+            }
+        };
+        eachColor([&](ContactConstraint &constraint) { warmStart(world, constraint); });
+        for (int iteration = 0; iteration < iterations_; ++iteration) {
+            eachColor([&](ContactConstraint &constraint) { solveContact(world, constraint); });
+        }
+        updateSleep(world, island);
+    }
+
+    void ContactSolver::colorContacts(const Island &island)
+    {
+        if (bodyColors_.size() < parent_.size()) {
+            bodyColors_.resize(parent_.size());
+        }
+        for (size_t i = island.bodyBegin; i < island.bodyEnd; ++i) {
+            bodyColors_[islandBodies_[i]] = 0;
+        }
+
+        // Greedy: the lowest color neither body uses yet. Static sides are only read, so they don't count.
+        size_t count = island.contactEnd - island.contactBegin;
+        contactColors_.resize(count);
+        colorOffsets_.assign(ColorCount + 1, 0);
+        for (size_t i = 0; i < count; ++i) {
+            const ContactConstraint &constraint = constraints_[island.contactBegin + i];
+            bool dynamicA = constraint.inverseMassA > 0.0f, dynamicB = constraint.inverseMassB > 0.0f;
+            uint64_t used = (dynamicA ? bodyColors_[constraint.bodyA] : 0) | (dynamicB ? bodyColors_[constraint.bodyB] : 0);
+
+            int color = OverflowColor;
+            if (used != ~0ull) {
+                color = __builtin_ctzll(~used);
+                if (dynamicA) {
+                    bodyColors_[constraint.bodyA] |= 1ull << color;
+                }
+                if (dynamicB) {
+                    bodyColors_[constraint.bodyB] |= 1ull << color;
+                }
+            }
+            contactColors_[i] = static_cast<uint8_t>(color);
+            colorOffsets_[color + 1]++;
+        }
+
+        colorOffsets_[0] = island.contactBegin;
+        for (int color = 0; color < ColorCount; ++color) {
+            colorOffsets_[color + 1] += colorOffsets_[color];
+        }
+
+        std::vector<size_t> cursor(colorOffsets_.begin(), colorOffsets_.end() - 1);
+        scratch_.resize(constraints_.size());
+        for (size_t i = 0; i < count; ++i) {
+            scratch_[cursor[contactColors_[i]]++] = constraints_[island.contactBegin + i];
+        }
+        std::copy(scratch_.begin() + island.contactBegin, scratch_.begin() + island.contactEnd,
+                  constraints_.begin() + island.contactBegin);
+    }
+
+    void ContactSolver::setVelocity(PhysicsWorld &world, uint32_t body, const Vector3 &velocity)
+    {
+        // Unlike PhysicsWorld::setVelocity, leaves the rest counter alone
+        world.velocityX_[body] = velocity.x;
+        world.velocityY_[body] = velocity.y;
+        world.velocityZ_[body] = velocity.z;
+    }
+
+    void ContactSolver::updateSleep(PhysicsWorld &world, const Island &island)
+    {
+        float thresholdSquared = world.sleepVelocity_ * world.sleepVelocity_;
+        int stepsAtRest = INT_MAX;
+        for (size_t i = island.bodyBegin; i < island.bodyEnd; ++i) {
+            uint32_t body = islandBodies_[i];
+            Vector3 velocity = world.getVelocity(body);
+            if (velocity.dot(velocity) > thresholdSquared) {
+                world.stepsAtRest_[body] = 0;
+            } else {
+                world.stepsAtRest_[body]++;
+            }
+            stepsAtRest = std::min(stepsAtRest, world.stepsAtRest_[body]);
+        }
+
+        // The island sleeps as a whole, so nothing rests on a body that keeps moving
+        if (world.sleepEnabled_ && stepsAtRest >= world.sleepSteps_) {
+            for (size_t i = island.bodyBegin; i < island.bodyEnd; ++i) {
+                uint32_t body = islandBodies_[i];
+                world.awake_[body] = 0.0f;
+                setVelocity(world, body, Vector3());
+            }
+        }
+    }
+
+    void ContactSolver::prepare(ContactConstraint &constraint, float dt) const
+    {
+        const ContactManifold &manifold = *constraint.manifold;
+        float inverseMass = constraint.inverseMassA + constraint.inverseMassB;
+        constraint.mass = inverseMass > 0.0f ? 1.0f / inverseMass : 0.0f;
+
+        // Friction directions derived from the normal alone, so warm-started tangent impulses keep their meaning
+        const Vector3 &n = manifold.normal;
+        if (std::fabs(n.x) >= 0.57735f) {
+            constraint.tangents[0] = Vector3(n.y, -n.x, 0.0f).normalize();
+        } else {
+            constraint.tangents[0] = Vector3(0.0f, n.z, -n.y).normalize();
+        }
+        constraint.tangents[1] = n.cross(constraint.tangents[0]);
+
+        for (int i = 0; i < manifold.pointCount; ++i) {
+            float error = std::max(manifold.points[i].depth - PenetrationSlop, 0.0f);
+            constraint.bias[i] = std::min(BaumgarteFactor * error / dt, MaxBiasVelocity);
+        }
+    }
+
+    void ContactSolver::warmStart(PhysicsWorld &world, const ContactConstraint &constraint) const
+    {
+        const ContactManifold &manifold = *constraint.manifold;
+        Vector3 impulse;
+        for (int i = 0; i < manifold.pointCount; ++i) {
+            const ContactPoint &point = manifold.points[i];
+            impulse += manifold.normal * point.normalImpulse + constraint.tangents[0] * point.tangentImpulse[0] +
+                       constraint.tangents[1] * point.tangentImpulse[1];
+        }
+        if (constraint.inverseMassA > 0.0f) {
+            setVelocity(world, constraint.bodyA, world.getVelocity(constraint.bodyA) - impulse * constraint.inverseMassA);
+        }
+        if (constraint.inverseMassB > 0.0f) {
+            setVelocity(world, constraint.bodyB, world.getVelocity(constraint.bodyB) + impulse * constraint.inverseMassB);
+        }
+    }
+
+    void ContactSolver::solveContact(PhysicsWorld &world, ContactConstraint &constraint) const
+    {
+        ContactManifold &manifold = *constraint.manifold;
+        Vector3 velocityA = constraint.bodyA != PhysicsWorld::NoBody ? world.getVelocity(constraint.bodyA) : Vector3();
+        Vector3 velocityB = constraint.bodyB != PhysicsWorld::NoBody ? world.getVelocity(constraint.bodyB) : Vector3();
+
+        auto apply = [&](const Vector3 &direction, float impulse) {
+            velocityA -= direction * (impulse * constraint.inverseMassA);
+            velocityB += direction * (impulse * constraint.inverseMassB);
+        };
+
+        for (int i = 0; i < manifold.pointCount; ++i) {
+            ContactPoint &point = manifold.points[i];
+
+            // Friction first, bounded by the normal impulse of the last iteration
+            float maxFriction = friction_ * point.normalImpulse;
+            for (int k = 0; k < 2; ++k) {
+                float speed = (velocityB - velocityA).dot(constraint.tangents[k]);
+                float accumulated = std::max(-maxFriction, std::min(maxFriction, point.tangentImpulse[k] - speed * constraint.mass));
+                apply(constraint.tangents[k], accumulated - point.tangentImpulse[k]);
+                point.tangentImpulse[k] = accumulated;
+            }
+
+            // Non-penetration: push apart until the bodies separate at the bias speed
+            float speed = (velocityB - velocityA).dot(manifold.normal);
+            float accumulated = std::max(0.0f, point.normalImpulse + (constraint.bias[i] - speed) * constraint.mass);
+            apply(manifold.normal, accumulated - point.normalImpulse);
+            point.normalImpulse = accumulated;
+        }
+
+        if (constraint.inverseMassA > 0.0f) {
+            setVelocity(world, constraint.bodyA, velocityA);
+        }
+        if (constraint.inverseMassB > 0.0f) {
+            setVelocity(world, constraint.bodyB, velocityB);
+        }
+    }
+
+} // namespace ParteeEngine
@@ -0,0 +1,401 @@
+#include "physics/DynamicAabbTree.hpp"
+
+#include <cassert>
+
+namespace ParteeEngine {
+
+    namespace {
+        // Displacement is extrapolated this many steps ahead when fattening a moved proxy
+        constexpr float DisplacementMultiplier = 2.0f;
+
+        constexpr int SahBinCount = 12;
+
+        float component(const Vector3 &v, int axis)
+        {
+            return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+        }
+
+        Aabb fatten(const Aabb &bounds, float margin, const Vector3 &displacement)
+        {
+            Aabb fat(bounds.min - Vector3(margin, margin, margin), bounds.max + Vector3(margin, margin, margin));
+            Vector3 d = displacement * DisplacementMultiplier;
+            (d.x < 0.0f ? fat.min.x : fat.max.x) += d.x;
+            (d.y < 0.0f ? fat.min.y : fat.max.y) += d.y;
+            (d.z < 0.0f ? fat.min.z : fat.max.z) += d.z;
+            return fat;
+        }
+    }
+
+    int32_t DynamicAabbTree::createProxy(const Aabb &bounds, uint32_t userData)
+    {
+        int32_t proxy = allocateNode();
+        nodes_[proxy].bounds = fatten(bounds, margin_, Vector3());
+        nodes_[proxy].userData = userData;
+        nodes_[proxy].height = 0;
+        insertLeaf(proxy);
+        proxyCount_++;
+        return proxy;
+    }
+
+    void DynamicAabbTree::destroyProxy(int32_t proxy)
+    {
+        assert(nodes_[proxy].isLeaf());
+        removeLeaf(proxy);
+        freeNode(proxy);
+        proxyCount_--;
+    }
+
+    bool DynamicAabbTree::moveProxy(int32_t proxy, const Aabb &bounds, const Vector3 &displacement)
+    {
+        if (nodes_[proxy].bounds.contains(bounds)) {
+            return false;
+        }
+
+        removeLeaf(proxy);
+        nodes_[proxy].bounds = fatten(bounds, margin_, displacement);
+        insertLeaf(proxy);
+        return true;
+    }
+
+    int32_t DynamicAabbTree::allocateNode()
+    {
+        if (freeList_ == Null) {
+            nodes_.emplace_back();
+            return static_cast<int32_t>(nodes_.size() - 1);
+        }
+
+        int32_t node = freeList_;
+        freeList_ = nodes_[node].parent;
+        nodes_[node] = Node();
+        return node;
+    }
+
+    void DynamicAabbTree::freeNode(int32_t node)
+    {
+        nodes_[node].parent = freeList_;
+        nodes_[node].child1 = Null;
+        nodes_[node].child2 = Null;
+        nodes_[node].height = -1;
+        freeList_ = node;
+    }
+
+    void DynamicAabbTree::insertLeaf(int32_t leaf)
+    {
+        if (root_ == Null) {
+            root_ = leaf;
+            nodes_[leaf].parent = Null;
+            return;
+        }
+
+        // Descend towards the sibling that minimizes the added surface area, counting the
+        // area every ancestor would grow by
+        const Aabb leafBounds = nodes_[leaf].bounds;
+        int32_t index = root_;
+        while (!nodes_[index].isLeaf()) {
+            const Node &node = nodes_[index];
+            float area = surfaceArea(node.bounds);
+            float combinedArea = surfaceArea(node.bounds.merged(leafBounds));
+
+            // Cost of making a new parent for this node and the leaf, and the inherited
+            // cost of pushing the leaf further down
+            float cost = 2.0f * combinedArea;
+            float inheritanceCost = 2.0f * (combinedArea - area);
+
+            auto descendCost = [&](int32_t child) {
+                const Aabb merged = nodes_[child].bounds.merged(leafBounds);
+                if (nodes_[child].isLeaf()) {
+                    return surfaceArea(merged) + inheritanceCost;
+                }
+                return surfaceArea(merged) - surfaceArea(nodes_[child].bounds) + inheritanceCost;
+            };
+            float cost1 = descendCost(node.child1);
+            float cost2 = descendCost(node.child2);
+
+            if (cost < cost1 && cost < cost2) {
+                break;
+            }
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        // Replace the sibling with a new parent of both
+        int32_t sibling = index;
+        int32_t oldParent = nodes_[sibling].parent;
+        int32_t newParent = allocateNode();
+        nodes_[newParent].parent = oldParent;
+        nodes_[newParent].bounds = leafBounds.merged(nodes_[sibling].bounds);
+        nodes_[newParent].height = nodes_[sibling].height + 1;
+        nodes_[newParent].child1 = sibling;
+        nodes_[newParent].child2 = leaf;
+        nodes_[sibling].parent = newParent;
+        nodes_[leaf].parent = newParent;
+
+        if (oldParent == Null) {
+            root_ = newParent;
+        } else if (nodes_[oldParent].child1 == sibling) {
+            nodes_[oldParent].child1 = newParent;
+        } else {
+            nodes_[oldParent].child2 = newParent;
+        }
+
+        refitUpwards(nodes_[leaf].parent);
+    }
+
+    void DynamicAabbTree::removeLeaf(int32_t leaf)
+    {
+        if (leaf == root_) {
+            root_ = Null;
+            return;
+        }
+
+        // The sibling takes the parent's place
+        int32_t parent = nodes_[leaf].parent;
+        int32_t grandParent = nodes_[parent].parent;
+        int32_t sibling = nodes_[parent].child1 == leaf ? nodes_[parent].child2 : nodes_[parent].child1;
+
+        if (grandParent == Null) {
+            root_ = sibling;
+            nodes_[sibling].parent = Null;
+            freeNode(parent);
+            return;
+        }
+
+        if (nodes_[grandParent].child1 == parent) {
+            nodes_[grandParent].child1 = sibling;
+        } else {
+            nodes_[grandParent].child2 = sibling;
+        }
+        nodes_[sibling].parent = grandParent;
+        freeNode(parent);
+
+        refitUpwards(grandParent);
+    }
+
+    void DynamicAabbTree::refitUpwards(int32_t index)
+    {
+        while (index != Null) {
+            index = balance(index);
+
+            Node &node = nodes_[index];
+            const Node &child1 = nodes_[node.child1];
+            const Node &child2 = nodes_[node.child2];
+            node.height = 1 + std::max(child1.height, child2.height);
+            node.bounds = child1.bounds.merged(child2.bounds);
+
+            index = node.parent;
+        }
+    }
+
+    int32_t DynamicAabbTree::balance(int32_t iA)
+    {
+        // Rotates the taller grandchild up when the subtrees of A differ in height by more than one
+        Node &A = nodes_[iA];
+        if (A.isLeaf() || A.height < 2) {
+            return iA;
+        }
+
+        int32_t iB = A.child1;
+        int32_t iC = A.child2;
+        int32_t heightDifference = nodes_[iC].height - nodes_[iB].height;
+        if (heightDifference >= -1 && heightDifference <= 1) {
+            return iA;
+        }
+
+        // Rotate the taller child (iUp) above A; its taller child stays below it, the other moves to A
+        int32_t iUp = heightDifference > 1 ? iC : iB;
+        int32_t iStay = heightDifference > 1 ? iB : iC;
+        Node &up = nodes_[iUp];
+        int32_t iF = up.child1;
+        int32_t iG = up.child2;
+
+        up.child1 = iA;
+        up.parent = A.parent;
+        A.parent = iUp;
+
+        if (up.parent == Null) {
+            root_ = iUp;
+        } else if (nodes_[up.parent].child1 == iA) {
+            nodes_[up.parent].child1 = iUp;
+        } else {
+            nodes_[up.parent].child2 = iUp;
+        }
+
+        int32_t iTaller = nodes_[iF].height > nodes_[iG].height ? iF : iG;
+        int32_t iShorter = iTaller == iF ? iG : iF;
+        up.child2 = iTaller;
+        if (heightDifference > 1) {
+            A.child2 = iShorter;
+        } else {
+            A.child1 = iShorter;
+        }
+        nodes_[iShorter].parent = iA;
+
+        A.bounds = nodes_[iStay].bounds.merged(nodes_[iShorter].bounds);
+        A.height = 1 + std::max(nodes_[iStay].height, nodes_[iShorter].height);
+        up.bounds = A.bounds.merged(nodes_[iTaller].bounds);
+        up.height = 1 + std::max(A.height, nodes_[iTaller].height);
+        return iUp;
+    }
+
+    void DynamicAabbTree::rebuild()
+    {
+        if (root_ == Null) {
+            return;
+        }
+
+        // Keep the leaves, recycle every internal node
+        std::vector<int32_t> leaves;
+        leaves.reserve(proxyCount_);
+        for (size_t i = 0; i < nodes_.size(); ++i) {
+            Node &node = nodes_[i];
+            if (node.height < 0) {
+                continue;
+            }
+            if (node.isLeaf()) {
+                node.parent = Null;
+                leaves.push_back(static_cast<int32_t>(i));
+            } else {
+                freeNode(static_cast<int32_t>(i));
+            }
+        }
+
+        root_ = buildTopDown(leaves.data(), leaves.size());
+        nodes_[root_].parent = Null;
+    }
+
+    int32_t DynamicAabbTree::buildTopDown(int32_t *leaves, size_t count)
+    {
+        if (count == 1) {
+            return leaves[0];
+        }
+
+        Aabb centroidBounds(nodes_[leaves[0]].bounds.getCenter(), nodes_[leaves[0]].bounds.getCenter());
+        for (size_t i = 1; i < count; ++i) {
+            Vector3 center = nodes_[leaves[i]].bounds.getCenter();
+            centroidBounds = centroidBounds.merged(Aabb(center, center));
+        }
+
+        Vector3 spread = centroidBounds.max - centroidBounds.min;
+        int axis = spread.x >= spread.y && spread.x >= spread.z ? 0 : (spread.y >= spread.z ? 1 : 2);
+        float axisMin = component(centroidBounds.min, axis);
+        float axisSpread = component(spread, axis);
+
+        size_t split = count / 2;
+        if (axisSpread > 0.0f) {
+            // Bin the centroids and pick the bin boundary with the lowest SAH cost
+            struct Bin {
+                Aabb bounds;
+                size_t count = 0;
+            };
+            Bin bins[SahBinCount];
+            float binScale = SahBinCount / axisSpread;
+            auto binOf = [&](int32_t leaf) {
+                int bin = static_cast<int>((component(nodes_[leaf].bounds.getCenter(), axis) - axisMin) * binScale);
+                return std::min(bin, SahBinCount - 1);
+            };
+            for (size_t i = 0; i < count; ++i) {
+                Bin &bin = bins[binOf(leaves[i])];
+                bin.bounds = bin.count == 0 ? nodes_[leaves[i]].bounds : bin.bounds.merged(nodes_[leaves[i]].bounds);
+                bin.count++;
+            }
+
+            float rightArea[SahBinCount];
+            size_t rightCount[SahBinCount];
+            Aabb accumulated;
+            size_t accumulatedCount = 0;
+            for (int b = SahBinCount - 1; b > 0; --b) {
+                if (bins[b].count > 0) {
+                    accumulated = accumulatedCount == 0 ? bins[b].bounds : accumulated.merged(bins[b].bounds);
+                    accumulatedCount += bins[b].count;
+                }
+                rightArea[b] = accumulatedCount > 0 ? surfaceArea(accumulated) : 0.0f;
+                rightCount[b] = accumulatedCount;
+            }
+
+            float bestCost = std::numeric_limits<float>::max();
+            int bestBin = -1;
+            accumulatedCount = 0;
+            for (int b = 0; b < SahBinCount - 1; ++b) {
+                if (bins[b].count > 0) {
+                    accumulated = accumulatedCount == 0 ? bins[b].bounds : accumulated.merged(bins[b].bounds);
+                    accumulatedCount += bins[b].count;
+                }
+                if (accumulatedCount == 0 || rightCount[b + 1] == 0) {
+                    continue;
+                }
+                float cost = surfaceArea(accumulated) * accumulatedCount + rightArea[b + 1] * rightCount[b + 1];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestBin = b;
+                }
+            }
+
+            if (bestBin >= 0) {
+                int32_t *middle = std::partition(leaves, leaves + count, [&](int32_t leaf) { return binOf(leaf) <= bestBin; });
+                split = static_cast<size_t>(middle - leaves);
+            }
+        }
+
+        if (split == 0 || split == count) {
+            // Coincident centroids: any even split will do
+            split = count / 2;
+            std::nth_element(leaves, leaves + split, leaves + count, [&](int32_t a, int32_t b) {
+                return component(nodes_[a].bounds.getCenter(), axis) < component(nodes_[b].bounds.getCenter(), axis);
+            });
+        }
+
+        int32_t child1 = buildTopDown(leaves, split);
+        int32_t child2 = buildTopDown(leaves + split, count - split);
+
+        int32_t parent = allocateNode();
+        Node &node = nodes_[parent];
+        node.child1 = child1;
+        node.child2 = child2;
+        node.bounds = nodes_[child1].bounds.merged(nodes_[child2].bounds);
+        node.height = 1 + std::max(nodes_[child1].height, nodes_[child2].height);
+        nodes_[child1].parent = parent;
+        nodes_[child2].parent = parent;
+        return parent;
+    }
+
+    float DynamicAabbTree::getAreaRatio() const
+    {
+        if (root_ == Null) {
+            return 0.0f;
+        }
+
+        float rootArea = surfaceArea(nodes_[root_].bounds);
+        float totalArea = 0.0f;
+        for (const Node &node : nodes_) {
+            if (node.height > 0) {
+                totalArea += surfaceArea(node.bounds);
+            }
+        }
+        return rootArea > 0.0f ? totalArea / rootArea : 0.0f;
+    }
+
+    float DynamicAabbTree::surfaceArea(const Aabb &bounds)
+    {
+        Vector3 size = bounds.max - bounds.min;
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    float DynamicAabbTree::rayDistance(const Aabb &bounds, const Vector3 &origin, const Vector3 &inverseDirection, float maxDistance)
+    {
+        float tx0 = (bounds.min.x - origin.x) * inverseDirection.x, tx1 = (bounds.max.x - origin.x) * inverseDirection.x;
+        float ty0 = (bounds.min.y - origin.y) * inverseDirection.y, ty1 = (bounds.max.y - origin.y) * inverseDirection.y;
+        float tz0 = (bounds.min.z - origin.z) * inverseDirection.z, tz1 = (bounds.max.z - origin.z) * inverseDirection.z;
+
+        float tEnter = std::max(std::max(std::min(tx0, tx1), std::min(ty0, ty1)), std::max(std::min(tz0, tz1), 0.0f));
+        float tExit = std::min(std::min(std::max(tx0, tx1), std::max(ty0, ty1)), std::min(std::max(tz0, tz1), maxDistance));
+        return tEnter <= tExit ? tEnter : -1.0f;
+    }
+
+    float DynamicAabbTree::pointDistance(const Aabb &bounds, const Vector3 &point)
+    {
+        float dx = std::max(0.0f, std::max(bounds.min.x - point.x, point.x - bounds.max.x));
+        float dy = std::max(0.0f, std::max(bounds.min.y - point.y, point.y - bounds.max.y));
+        float dz = std::max(0.0f, std::max(bounds.min.z - point.z, point.z - bounds.max.z));
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+
+} // namespace ParteeEngine
@@ -0,0 +1,602 @@
+#include "physics/Narrowphase.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+#include "jobs/ThreadPool.hpp"
+#include "math/Float4.hpp"
+
+namespace ParteeEngine {
+
+    namespace {
+        constexpr size_t TaskSize = 256;
+
+        enum Batch { SphereSphere, SphereBox, BoxBox, BatchCount };
+
+        // Edge axes must beat the best face axis by this much to be chosen, which keeps
+        // resting boxes on stable face contacts
+        constexpr float EdgeRelativeTolerance = 0.95f;
+        constexpr float EdgeAbsoluteTolerance = 0.01f;
+
+        float halfExtent(const ColliderShape &shape, int axis)
+        {
+            return axis == 0 ? shape.halfExtents.x : (axis == 1 ? shape.halfExtents.y : shape.halfExtents.z);
+        }
+
+        float signOf(float value)
+        {
+            return value < 0.0f ? -1.0f : 1.0f;
+        }
+
+        ContactManifold makeManifold(const BroadphasePair &pair, const EntityHandle *entities, const Vector3 &normal)
+        {
+            ContactManifold manifold;
+            manifold.first = entities[pair.first];
+            manifold.second = entities[pair.second];
+            manifold.firstProxy = pair.first;
+            manifold.secondProxy = pair.second;
+            manifold.normal = normal;
+            return manifold;
+        }
+
+        void addPoint(ContactManifold &manifold, const Vector3 &position, float depth)
+        {
+            ContactPoint &point = manifold.points[manifold.pointCount++];
+            point.position = position;
+            point.depth = depth;
+        }
+
+        // Lanes past count repeat the last pair; their results are masked off
+        template <typename Fill>
+        void gatherLanes(size_t base, size_t count, Fill &&fill)
+        {
+            for (int lane = 0; lane < 4; ++lane) {
+                fill(lane, base + std::min<size_t>(lane, count - base - 1));
+            }
+        }
+
+        int laneMask(size_t base, size_t count)
+        {
+            size_t lanes = std::min<size_t>(4, count - base);
+            return (1 << lanes) - 1;
+        }
+
+        Vector3x4 loadVectors(const float (&x)[4], const float (&y)[4], const float (&z)[4])
+        {
+            return Vector3x4(Float4::load(x), Float4::load(y), Float4::load(z));
+        }
+
+        void sphereSphere(const ColliderShape *shapes, const EntityHandle *entities, const BroadphasePair *pairs,
+                          const uint32_t *batch, size_t count, std::vector<ContactManifold> &out)
+        {
+            for (size_t base = 0; base < count; base += 4) {
+                float ax[4], ay[4], az[4], ar[4], bx[4], by[4], bz[4], br[4];
+                gatherLanes(base, count, [&](int lane, size_t i) {
+                    const ColliderShape &a = shapes[pairs[batch[i]].first];
+                    const ColliderShape &b = shapes[pairs[batch[i]].second];
+                    ax[lane] = a.center.x, ay[lane] = a.center.y, az[lane] = a.center.z, ar[lane] = a.radius;
+                    bx[lane] = b.center.x, by[lane] = b.center.y, bz[lane] = b.center.z, br[lane] = b.radius;
+                });
+
+                Vector3x4 centerA = loadVectors(ax, ay, az);
+                Vector3x4 d = loadVectors(bx, by, bz) - centerA;
+                Float4 radiusA = Float4::load(ar);
+                Float4 radiusSum = radiusA + Float4::load(br);
+                Float4 distanceSquared = d.dot(d);
+                int hits = (distanceSquared <= radiusSum * radiusSum).mask() & laneMask(base, count);
+                if (hits == 0) {
+                    continue;
+                }
+
+                // Concentric spheres get an arbitrary up normal
+                Float4 distance = sqrt(distanceSquared);
+                Float4 apart = distance > Float4(1e-6f);
+                Float4 inverse = Float4(1.0f) / select(apart, distance, Float4(1.0f));
+                Vector3x4 normal(select(apart, d.x * inverse, Float4(0.0f)), select(apart, d.y * inverse, Float4(1.0f)),
+                                 select(apart, d.z * inverse, Float4(0.0f)));
+                Float4 depth = radiusSum - distance;
+                Vector3x4 position = centerA + normal * (radiusA - depth * Float4(0.5f));
+
+                for (int lane = 0; lane < 4; ++lane) {
+                    if (hits & (1 << lane)) {
+                        ContactManifold manifold = makeManifold(pairs[batch[base + lane]], entities,
+                                                                Vector3(normal.x.lane(lane), normal.y.lane(lane), normal.z.lane(lane)));
+                        addPoint(manifold, Vector3(position.x.lane(lane), position.y.lane(lane), position.z.lane(lane)), depth.lane(lane));
+                        out.push_back(manifold);
+                    }
+                }
+            }
+        }
+
+        void sphereBox(const ColliderShape *shapes, const EntityHandle *entities, const BroadphasePair *pairs,
+                       const uint32_t *batch, size_t count, std::vector<ContactManifold> &out)
+        {
+            for (size_t base = 0; base < count; base += 4) {
+                float sx[4], sy[4], sz[4], sr[4], bx[4], by[4], bz[4];
+                float ux[3][4], uy[3][4], uz[3][4], e[3][4];
+                gatherLanes(base, count, [&](int lane, size_t i) {
+                    const BroadphasePair &pair = pairs[batch[i]];
+                    bool sphereFirst = shapes[pair.first].type == ShapeType::Sphere;
+                    const ColliderShape &sphere = shapes[sphereFirst ? pair.first : pair.second];
+                    const ColliderShape &box = shapes[sphereFirst ? pair.second : pair.first];
+                    sx[lane] = sphere.center.x, sy[lane] = sphere.center.y, sz[lane] = sphere.center.z, sr[lane] = sphere.radius;
+                    bx[lane] = box.center.x, by[lane] = box.center.y, bz[lane] = box.center.z;
+                    for (int k = 0; k < 3; ++k) {
+                        ux[k][lane] = box.axes[k].x, uy[k][lane] = box.axes[k].y, uz[k][lane] = box.axes[k].z;
+                        e[k][lane] = halfExtent(box, k);
+                    }
+                });
+
+                Vector3x4 sphereCenter = loadVectors(sx, sy, sz);
+                Vector3x4 boxCenter = loadVectors(bx, by, bz);
+                Vector3x4 axes[3] = {loadVectors(ux[0], uy[0], uz[0]), loadVectors(ux[1], uy[1], uz[1]), loadVectors(ux[2], uy[2], uz[2])};
+                Float4 radius = Float4::load(sr);
+                Vector3x4 relative = sphereCenter - boxCenter;
+
+                // Closest point of the box to the sphere center, in box coordinates
+                Float4 local[3], clamped[3], extents[3];
+                Float4 distanceSquared(0.0f);
+                for (int k = 0; k < 3; ++k) {
+                    extents[k] = Float4::load(e[k]);
+                    local[k] = relative.dot(axes[k]);
+                    clamped[k] = max(-extents[k], min(extents[k], local[k]));
+                    Float4 excess = local[k] - clamped[k];
+                    distanceSquared += excess * excess;
+                }
+                int hits = (distanceSquared <= radius * radius).mask() & laneMask(base, count);
+                if (hits == 0) {
+                    continue;
+                }
+
+                // Outside: the normal runs from the closest point to the center
+                Float4 outside = distanceSquared > Float4(1e-12f);
+                Float4 distance = sqrt(distanceSquared);
+                Float4 inverse = Float4(1.0f) / select(outside, distance, Float4(1.0f));
+
+                // Inside: push out through the nearest face
+                Float4 faceDistance[3];
+                for (int k = 0; k < 3; ++k) {
+                    faceDistance[k] = extents[k] - abs(local[k]);
+                }
+                Float4 pick0 = (faceDistance[0] <= faceDistance[1]) & (faceDistance[0] <= faceDistance[2]);
+                Float4 pick1 = select(pick0, Float4(0.0f), faceDistance[1] <= faceDistance[2]);
+                Float4 pick2 = select(pick0 | pick1, Float4(0.0f), Float4(1.0f) > Float4(0.0f));
+                Float4 picks[3] = {pick0, pick1, pick2};
+                Float4 nearestFace = min(faceDistance[0], min(faceDistance[1], faceDistance[2]));
+
+                Float4 normalLocal[3], pointLocal[3];
+                for (int k = 0; k < 3; ++k) {
+                    Float4 side = select(local[k] >= Float4(0.0f), Float4(1.0f), Float4(-1.0f));
+                    Float4 insideNormal = select(picks[k], side, Float4(0.0f));
+                    Float4 insidePoint = select(picks[k], side * extents[k], local[k]);
+                    normalLocal[k] = select(outside, (local[k] - clamped[k]) * inverse, insideNormal);
+                    pointLocal[k] = select(outside, clamped[k], insidePoint);
+                }
+                Float4 depth = select(outside, radius - distance, radius + nearestFace);
+
+                // Back to world space; the normal points from the box to the sphere
+                Vector3x4 normal = axes[0] * normalLocal[0] + axes[1] * normalLocal[1] + axes[2] * normalLocal[2];
+                Vector3x4 boxPoint = boxCenter + axes[0] * pointLocal[0] + axes[1] * pointLocal[1] + axes[2] * pointLocal[2];
+                Vector3x4 position = boxPoint - normal * (depth * Float4(0.5f));
+
+                for (int lane = 0; lane < 4; ++lane) {
+                    if (!(hits & (1 << lane))) {
+                        continue;
+                    }
+                    const BroadphasePair &pair = pairs[batch[base + lane]];
+                    Vector3 boxToSphere(normal.x.lane(lane), normal.y.lane(lane), normal.z.lane(lane));
+                    bool sphereFirst = shapes[pair.first].type == ShapeType::Sphere;
+                    ContactManifold manifold = makeManifold(pair, entities, sphereFirst ? boxToSphere * -1.0f : boxToSphere);
+                    addPoint(manifold, Vector3(position.x.lane(lane), position.y.lane(lane), position.z.lane(lane)), depth.lane(lane));
+                    out.push_back(manifold);
+                }
+            }
+        }
+
+        // Sutherland-Hodgman: keeps the part of the polygon with dot(normal, p) <= offset
+        int clipPolygon(const Vector3 *in, int count, const Vector3 &normal, float offset, Vector3 *out)
+        {
+            int outCount = 0;
+            for (int i = 0; i < count; ++i) {
+                const Vector3 &a = in[i];
+                const Vector3 &b = in[(i + 1) % count];
+                float da = normal.dot(a) - offset;
+                float db = normal.dot(b) - offset;
+                if (da <= 0.0f) {
+                    out[outCount++] = a;
+                }
+                if ((da < 0.0f && db > 0.0f) || (da > 0.0f && db < 0.0f)) {
+                    out[outCount++] = a + (b - a) * (da / (da - db));
+                }
+            }
+            return outCount;
+        }
+
+        // Face contact: clips the incident face of inc against the reference face of ref whose
+        // outward normal (towards inc) is n. Points are added to the manifold, at most eight.
+        int clipFaces(const ColliderShape &ref, int refAxis, const Vector3 &n, const ColliderShape &inc,
+                      Vector3 *points, float *depths)
+        {
+            // The incident face is the one most opposed to the reference normal
+            int incAxis = 0;
+            float best = -1.0f;
+            for (int k = 0; k < 3; ++k) {
+                float alignment = std::fabs(n.dot(inc.axes[k]));
+                if (alignment > best) {
+                    best = alignment;
+                    incAxis = k;
+                }
+            }
+            float incSide = n.dot(inc.axes[incAxis]) > 0.0f ? -1.0f : 1.0f;
+            Vector3 faceCenter = inc.center + inc.axes[incAxis] * (incSide * halfExtent(inc, incAxis));
+            Vector3 du = inc.axes[(incAxis + 1) % 3] * halfExtent(inc, (incAxis + 1) % 3);
+            Vector3 dv = inc.axes[(incAxis + 2) % 3] * halfExtent(inc, (incAxis + 2) % 3);
+
+            Vector3 polygon[8] = {faceCenter + du + dv, faceCenter - du + dv, faceCenter - du - dv, faceCenter + du - dv};
+            Vector3 clipped[8];
+            int count = 4;
+            for (int side = 1; side <= 2; ++side) {
+                int k = (refAxis + side) % 3;
+                for (float sign : {1.0f, -1.0f}) {
+                    Vector3 planeNormal = ref.axes[k] * sign;
+                    count = clipPolygon(polygon, count, planeNormal, planeNormal.dot(ref.center) + halfExtent(ref, k), clipped);
+                    std::copy(clipped, clipped + count, polygon);
+                }
+            }
+
+            float faceOffset = n.dot(ref.center) + halfExtent(ref, refAxis);
+            int kept = 0;
+            for (int i = 0; i < count; ++i) {
+                float depth = faceOffset - n.dot(polygon[i]);
+                if (depth >= 0.0f) {
+                    points[kept] = polygon[i] + n * (depth * 0.5f);
+                    depths[kept] = depth;
+                    kept++;
+                }
+            }
+            return kept;
+        }
+
+        // Keeps the deepest point and the three that span the largest area with it
+        void reducePoints(const Vector3 *points, const float *depths, int count, const Vector3 &normal, ContactManifold &manifold)
+        {
+            if (count <= ContactManifold::MaxPoints) {
+                for (int i = 0; i < count; ++i) {
+                    addPoint(manifold, points[i], depths[i]);
+                }
+                return;
+            }
+
+            int chosen[4] = {0, -1, -1, -1};
+            for (int i = 1; i < count; ++i) {
+                if (depths[i] > depths[chosen[0]]) {
+                    chosen[0] = i;
+                }
+            }
+            float farthest = -1.0f;
+            for (int i = 0; i < count; ++i) {
+                Vector3 d = points[i] - points[chosen[0]];
+                if (d.dot(d) > farthest) {
+                    farthest = d.dot(d);
+                    chosen[1] = i;
+                }
+            }
+            float mostPositive = 0.0f, mostNegative = 0.0f;
+            Vector3 edge = points[chosen[1]] - points[chosen[0]];
+            for (int i = 0; i < count; ++i) {
+                float area = edge.cross(points[i] - points[chosen[0]]).dot(normal);
+                if (area > mostPositive) {
+                    mostPositive = area;
+                    chosen[2] = i;
+                } else if (area < mostNegative) {
+                    mostNegative = area;
+                    chosen[3] = i;
+                }
+            }
+            for (int i : chosen) {
+                if (i >= 0) {
+                    addPoint(manifold, points[i], depths[i]);
+                }
+            }
+        }
+
+        // Manifold for two overlapping boxes given the axis of least penetration found by the
+        // SAT: 0-2 are faces of a, 3-5 faces of b, 6 + 3i + j the edge pair (a.axes[i], b.axes[j]).
+        void boxBoxManifold(const ColliderShape &a, const ColliderShape &b, int axis, float separation, ContactManifold &manifold)
+        {
+            Vector3 t = b.center - a.center;
+            Vector3 points[8];
+            float depths[8];
+
+            if (axis < 3) {
+                Vector3 n = a.axes[axis] * signOf(t.dot(a.axes[axis]));
+                manifold.normal = n;
+                reducePoints(points, depths, clipFaces(a, axis, n, b, points, depths), n, manifold);
+            } else if (axis < 6) {
+                // b is the reference; its face normal points towards a
+                Vector3 n = b.axes[axis - 3] * -signOf(t.dot(b.axes[axis - 3]));
+                manifold.normal = n * -1.0f;
+                reducePoints(points, depths, clipFaces(b, axis - 3, n, a, points, depths), n, manifold);
+            } else {
+                int i = (axis - 6) / 3, j = (axis - 6) % 3;
+                Vector3 n = a.axes[i].cross(b.axes[j]).normalize();
+                if (n.dot(t) < 0.0f) {
+                    n = n * -1.0f;
+                }
+
+                // The edges of a and b that face each other
+                Vector3 edgeA = a.center, edgeB = b.center;
+                for (int k = 0; k < 3; ++k) {
+                    if (k != i) {
+                        edgeA += a.axes[k] * (halfExtent(a, k) * signOf(n.dot(a.axes[k])));
+                    }
+                    if (k != j) {
+                        edgeB -= b.axes[k] * (halfExtent(b, k) * signOf(n.dot(b.axes[k])));
+                    }
+                }
+
+                // Closest points of the two edge lines, clamped to the edges
+                const Vector3 &dirA = a.axes[i];
+                const Vector3 &dirB = b.axes[j];
+                Vector3 r = edgeA - edgeB;
+                float dirDot = dirA.dot(dirB);
+                float c = dirA.dot(r), f = dirB.dot(r);
+                float denominator = std::max(1e-6f, 1.0f - dirDot * dirDot);
+                float s = std::max(-halfExtent(a, i), std::min(halfExtent(a, i), (dirDot * f - c) / denominator));
+                float u = std::max(-halfExtent(b, j), std::min(halfExtent(b, j), (f - dirDot * c) / denominator));
+                Vector3 onA = edgeA + dirA * s;
+                Vector3 onB = edgeB + dirB * u;
+
+                manifold.normal = n;
+                addPoint(manifold, (onA + onB) * 0.5f, -separation);
+            }
+        }
+
+        void boxBox(const ColliderShape *shapes, const EntityHandle *entities, const BroadphasePair *pairs,
+                    const uint32_t *batch, size_t count, std::vector<ContactManifold> &out)
+        {
+            for (size_t base = 0; base < count; base += 4) {
+                float ac[3][4], bc[3][4], ea[3][4], eb[3][4];
+                float au[3][3][4], bu[3][3][4]; // [axis][component][lane]
+                gatherLanes(base, count, [&](int lane, size_t i) {
+                    const ColliderShape &a = shapes[pairs[batch[i]].first];
+                    const ColliderShape &b = shapes[pairs[batch[i]].second];
+                    ac[0][lane] = a.center.x, ac[1][lane] = a.center.y, ac[2][lane] = a.center.z;
+                    bc[0][lane] = b.center.x, bc[1][lane] = b.center.y, bc[2][lane] = b.center.z;
+                    for (int k = 0; k < 3; ++k) {
+                        ea[k][lane] = halfExtent(a, k);
+                        eb[k][lane] = halfExtent(b, k);
+                        au[k][0][lane] = a.axes[k].x, au[k][1][lane] = a.axes[k].y, au[k][2][lane] = a.axes[k].z;
+                        bu[k][0][lane] = b.axes[k].x, bu[k][1][lane] = b.axes[k].y, bu[k][2][lane] = b.axes[k].z;
+                    }
+                });
+
+                Vector3x4 t = loadVectors(bc[0], bc[1], bc[2]) - loadVectors(ac[0], ac[1], ac[2]);
+                Vector3x4 axesA[3], axesB[3];
+                Float4 extentA[3], extentB[3];
+                for (int k = 0; k < 3; ++k) {
+                    axesA[k] = loadVectors(au[k][0], au[k][1], au[k][2]);
+                    axesB[k] = loadVectors(bu[k][0], bu[k][1], bu[k][2]);
+                    extentA[k] = Float4::load(ea[k]);
+                    extentB[k] = Float4::load(eb[k]);
+                }
+
+                // Rotation of b in a's frame; the epsilon guards the edge axes of parallel edges
+                Float4 R[3][3], absR[3][3], tA[3];
+                for (int i = 0; i < 3; ++i) {
+                    tA[i] = t.dot(axesA[i]);
+                    for (int j = 0; j < 3; ++j) {
+                        R[i][j] = axesA[i].dot(axesB[j]);
+                        absR[i][j] = abs(R[i][j]) + Float4(1e-6f);
+                    }
+                }
+
+                Float4 faceSeparation(-1e30f), faceAxis(0.0f);
+                auto testFace = [&](const Float4 &separation, float axis) {
+                    Float4 better = separation > faceSeparation;
+                    faceSeparation = select(better, separation, faceSeparation);
+                    faceAxis = select(better, Float4(axis), faceAxis);
+                };
+                for (int i = 0; i < 3; ++i) {
+                    Float4 rb = extentB[0] * absR[i][0] + extentB[1] * absR[i][1] + extentB[2] * absR[i][2];
+                    testFace(abs(tA[i]) - (extentA[i] + rb), static_cast<float>(i));
+                }
+                for (int j = 0; j < 3; ++j) {
+                    Float4 ra = extentA[0] * absR[0][j] + extentA[1] * absR[1][j] + extentA[2] * absR[2][j];
+                    Float4 tB = tA[0] * R[0][j] + tA[1] * R[1][j] + tA[2] * R[2][j];
+                    testFace(abs(tB) - (ra + extentB[j]), static_cast<float>(3 + j));
+                }
+
+                Float4 edgeSeparation(-1e30f), edgeAxis(0.0f);
+                for (int i = 0; i < 3; ++i) {
+                    int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+                    for (int j = 0; j < 3; ++j) {
+                        int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+                        Float4 ra = extentA[i1] * absR[i2][j] + extentA[i2] * absR[i1][j];
+                        Float4 rb = extentB[j1] * absR[i][j2] + extentB[j2] * absR[i][j1];
+                        Float4 projection = abs(tA[i2] * R[i1][j] - tA[i1] * R[i2][j]);
+
+                        // Normalize by |a_i x b_j| so depths compare with the face axes; skip near-parallel edges
+                        Float4 lengthSquared = Float4(1.0f) - R[i][j] * R[i][j];
+                        Float4 valid = lengthSquared > Float4(1e-6f);
+                        Float4 separation = (projection - (ra + rb)) / sqrt(select(valid, lengthSquared, Float4(1.0f)));
+                        Float4 better = valid & (separation > edgeSeparation);
+                        edgeSeparation = select(better, separation, edgeSeparation);
+                        edgeAxis = select(better, Float4(static_cast<float>(6 + 3 * i + j)), edgeAxis);
+                    }
+                }
+
+                // Any separating axis means no contact
+                Float4 separated = (faceSeparation > Float4(0.0f)) | (edgeSeparation > Float4(0.0f));
+                int hits = ~separated.mask() & laneMask(base, count);
+                if (hits == 0) {
+                    continue;
+                }
+
+                Float4 useEdge = edgeSeparation > faceSeparation * Float4(EdgeRelativeTolerance) + Float4(EdgeAbsoluteTolerance);
+                Float4 axis = select(useEdge, edgeAxis, faceAxis);
+                Float4 separation = select(useEdge, edgeSeparation, faceSeparation);
+
+                for (int lane = 0; lane < 4; ++lane) {
+                    if (!(hits & (1 << lane))) {
+                        continue;
+                    }
+                    const BroadphasePair &pair = pairs[batch[base + lane]];
+                    ContactManifold manifold = makeManifold(pair, entities, Vector3());
+                    boxBoxManifold(shapes[pair.first], shapes[pair.second], static_cast<int>(axis.lane(lane)),
+                                   separation.lane(lane), manifold);
+                    if (manifold.pointCount > 0) {
+                        out.push_back(manifold);
+                    }
+                }
+            }
+        }
+    }
+
+    void Narrowphase::collide(const ColliderShape *shapes, const EntityHandle *entities,
+                              const std::vector<BroadphasePair> &pairs, ThreadPool *jobs, const uint8_t *resting,
+                              const uint32_t *proxyOfPrevious)
+    {
+        previous_.swap(manifolds_);
+        manifolds_.clear();
+
+        sphereSphere_.clear();
+        sphereBox_.clear();
+        boxBox_.clear();
+        for (size_t i = 0; i < pairs.size(); ++i) {
+            // Kept from the last step instead, see keepRestingContacts()
+            if (resting && resting[pairs[i].first] && resting[pairs[i].second]) {
+                continue;
+            }
+            int spheres = (shapes[pairs[i].first].type == ShapeType::Sphere) + (shapes[pairs[i].second].type == ShapeType::Sphere);
+            std::vector<uint32_t> &batch = spheres == 2 ? sphereSphere_ : (spheres == 1 ? sphereBox_ : boxBox_);
+            batch.push_back(static_cast<uint32_t>(i));
+        }
+
+        // Split every batch into tasks that write to their own manifold lists
+        const std::vector<uint32_t> *batches[BatchCount] = {&sphereSphere_, &sphereBox_, &boxBox_};
+        tasks_.clear();
+        for (int batch = 0; batch < BatchCount; ++batch) {
+            for (size_t begin = 0; begin < batches[batch]->size(); begin += TaskSize) {
+                tasks_.push_back(Task{batch, begin, std::min(begin + TaskSize, batches[batch]->size())});
+            }
+        }
+        if (taskManifolds_.size() < tasks_.size()) {
+            taskManifolds_.resize(tasks_.size());
+        }
+
+        auto runTasks = [&](size_t begin, size_t end) {
+            for (size_t t = begin; t < end; ++t) {
+                const Task &task = tasks_[t];
+                std::vector<ContactManifold> &out = taskManifolds_[t];
+                out.clear();
+                const uint32_t *batch = batches[task.batch]->data() + task.begin;
+                size_t count = task.end - task.begin;
+                if (task.batch == SphereSphere) {
+                    sphereSphere(shapes, entities, pairs.data(), batch, count, out);
+                } else if (task.batch == SphereBox) {
+                    sphereBox(shapes, entities, pairs.data(), batch, count, out);
+                } else {
+                    boxBox(shapes, entities, pairs.data(), batch, count, out);
+                }
+            }
+        };
+        if (jobs) {
+            jobs->parallelFor(0, tasks_.size(), 1, runTasks);
+        } else {
+            runTasks(0, tasks_.size());
+        }
+
+        for (size_t t = 0; t < tasks_.size(); ++t) {
+            manifolds_.insert(manifolds_.end(), taskManifolds_[t].begin(), taskManifolds_[t].end());
+        }
+
+        // Orient every manifold by entity index so a pair looks the same every step
+        for (ContactManifold &manifold : manifolds_) {
+            if (manifold.first.index > manifold.second.index) {
+                std::swap(manifold.first, manifold.second);
+                std::swap(manifold.firstProxy, manifold.secondProxy);
+                manifold.normal = manifold.normal * -1.0f;
+            }
+        }
+        std::sort(manifolds_.begin(), manifolds_.end(),
+                  [](const ContactManifold &a, const ContactManifold &b) { return a.key() < b.key(); });
+
+        // Only the fresh manifolds are sorted and warm started; resting ones keep theirs as is
+        warmStart();
+        keepRestingContacts(resting, proxyOfPrevious);
+        mergeKeptContacts();
+    }
+
+    void Narrowphase::keepRestingContacts(const uint8_t *resting, const uint32_t *proxyOfPrevious)
+    {
+        kept_.clear();
+        if (!resting) {
+            return;
+        }
+
+        // previous_ is sorted by key, so the kept manifolds are too
+        for (const ContactManifold &last : previous_) {
+            uint32_t first = proxyOfPrevious[last.firstProxy];
+            uint32_t second = proxyOfPrevious[last.secondProxy];
+            if (first == NoProxy || second == NoProxy || !resting[first] || !resting[second]) {
+                continue;
+            }
+            kept_.push_back(last);
+            kept_.back().firstProxy = first;
+            kept_.back().secondProxy = second;
+            kept_.back().persistent = true;
+            kept_.back().resting = true;
+        }
+    }
+
+    void Narrowphase::mergeKeptContacts()
+    {
+        if (kept_.empty()) {
+            return;
+        }
+        if (manifolds_.empty()) {
+            manifolds_.swap(kept_);
+            return;
+        }
+
+        merged_.clear();
+        std::merge(manifolds_.begin(), manifolds_.end(), kept_.begin(), kept_.end(), std::back_inserter(merged_),
+                   [](const ContactManifold &a, const ContactManifold &b) { return a.key() < b.key(); });
+        manifolds_.swap(merged_);
+    }
+
+    void Narrowphase::warmStart()
+    {
+        // Both lists are sorted by key, so one merge pass finds every surviving pair
+        const float persistentSquared = PersistentDistance * PersistentDistance;
+        size_t old = 0;
+        for (ContactManifold &manifold : manifolds_) {
+            while (old < previous_.size() && previous_[old].key() < manifold.key()) {
+                old++;
+            }
+            if (old == previous_.size() || previous_[old].key() != manifold.key() ||
+                previous_[old].first != manifold.first || previous_[old].second != manifold.second) {
+                continue;
+            }
+
+            const ContactManifold &last = previous_[old];
+            manifold.persistent = true;
+            for (int i = 0; i < manifold.pointCount; ++i) {
+                ContactPoint &point = manifold.points[i];
+                float closest = persistentSquared;
+                for (int j = 0; j < last.pointCount; ++j) {
+                    Vector3 d = last.points[j].position - point.position;
+                    if (d.dot(d) < closest) {
+                        closest = d.dot(d);
+                        point.normalImpulse = last.points[j].normalImpulse;
+                        point.tangentImpulse[0] = last.points[j].tangentImpulse[0];
+                        point.tangentImpulse[1] = last.points[j].tangentImpulse[1];
+                    }
+                }
+            }
+        }
+    }
+
+} // namespace ParteeEngine
@@ -0,0 +1,311 @@
+#include "physics/PhysicsWorld.hpp"
+
+#include "components/PhysicsComponent.hpp"
+#include "components/TransformComponent.hpp"
+#include "ecs/View.hpp"
+#include "jobs/ThreadPool.hpp"
+#include "math/Float4.hpp"
+#include "physics/CollisionWorld.hpp"
+
+#include <algorithm>
+
+namespace ParteeEngine {
+
+    namespace {
+        constexpr size_t IntegrateGrainSize = 16384; // bodies, a multiple of the lane count
+        constexpr size_t ApplyGrainSize = 4096;
+
+        // Times a continuous body may hit something and slide on within one step
+        constexpr int MaxSweepSubsteps = 4;
+
+        struct BodyArrays {
+            float *velocityX, *velocityY, *velocityZ;
+            float *forceX, *forceY, *forceZ;
+            const float *inverseMass;
+            const float *awake;
+            float *displacementX, *displacementY, *displacementZ;
+        };
+
+        // Applies forces and gravity to awake dynamic bodies. Verlet starts the displacement with
+        // the old velocity's half; integratePositionsRange adds the new velocity's.
+        template <bool Verlet>
+        void integrateVelocitiesRange(const BodyArrays &bodies, size_t begin, size_t end, const Vector3 &gravity, float dt)
+        {
+            const Float4 zero(0.0f);
+            const Float4 step(dt);
+            const Float4 halfStep(0.5f * dt);
+            const Float4 gravityX(gravity.x), gravityY(gravity.y), gravityZ(gravity.z);
+
+            for (size_t i = begin; i < end; i += 4) {
+                Float4 inverseMass = Float4::load(bodies.inverseMass + i);
+                Float4 active = (inverseMass > zero) & (Float4::load(bodies.awake + i) > zero);
+                Float4 accelerationX = select(active, gravityX + Float4::load(bodies.forceX + i) * inverseMass, zero);
+                Float4 accelerationY = select(active, gravityY + Float4::load(bodies.forceY + i) * inverseMass, zero);
+                Float4 accelerationZ = select(active, gravityZ + Float4::load(bodies.forceZ + i) * inverseMass, zero);
+
+                Float4 velocityX = Float4::load(bodies.velocityX + i);
+                Float4 velocityY = Float4::load(bodies.velocityY + i);
+                Float4 velocityZ = Float4::load(bodies.velocityZ + i);
+                if (Verlet) {
+                    (velocityX * halfStep).store(bodies.displacementX + i);
+                    (velocityY * halfStep).store(bodies.displacementY + i);
+                    (velocityZ * halfStep).store(bodies.displacementZ + i);
+                } else {
+                    zero.store(bodies.displacementX + i);
+                    zero.store(bodies.displacementY + i);
+                    zero.store(bodies.displacementZ + i);
+                }
+                (velocityX + accelerationX * step).store(bodies.velocityX + i);
+                (velocityY + accelerationY * step).store(bodies.velocityY + i);
+                (velocityZ + accelerationZ * step).store(bodies.velocityZ + i);
+                zero.store(bodies.forceX + i);
+                zero.store(bodies.forceY + i);
+                zero.store(bodies.forceZ + i);
+            }
+        }
+
+        // Semi-implicit Euler moves by the new velocity; Verlet by the mean of the old and new ones,
+        // which is v dt + a dt^2 / 2 when no contact changed the velocity.
+        void integratePositionsRange(const BodyArrays &bodies, size_t begin, size_t end, float scale)
+        {
+            const Float4 step(scale);
+            for (size_t i = begin; i < end; i += 4) {
+                (Float4::load(bodies.displacementX + i) + Float4::load(bodies.velocityX + i) * step).store(bodies.displacementX + i);
+                (Float4::load(bodies.displacementY + i) + Float4::load(bodies.velocityY + i) * step).store(bodies.displacementY + i);
+                (Float4::load(bodies.displacementZ + i) + Float4::load(bodies.velocityZ + i) * step).store(bodies.displacementZ + i);
+            }
+        }
+    }
+
+    uint32_t PhysicsWorld::createBody(EntityHandle entity)
+    {
+        uint32_t body;
+        if (!freeList_.empty()) {
+            body = freeList_.back();
+            freeList_.pop_back();
+        } else {
+            body = static_cast<uint32_t>(entities_.size());
+            entities_.push_back(EntityHandle());
+
+            // Keep every array padded to whole SIMD lanes
+            size_t padded = (entities_.size() + 3) & ~static_cast<size_t>(3);
+            for (std::vector<float> *array : {&velocityX_, &velocityY_, &velocityZ_, &forceX_, &forceY_, &forceZ_,
+                                              &inverseMass_, &awake_, &displacementX_, &displacementY_, &displacementZ_}) {
+                array->resize(padded, 0.0f);
+            }
+            stepsAtRest_.resize(padded, 0);
+            continuous_.resize(padded, 0);
+        }
+
+        resetBody(body);
+        entities_[body] = entity;
+        inverseMass_[body] = 1.0f;
+        awake_[body] = 1.0f;
+
+        if (entity.index >= bodyOfEntity_.size()) {
+            bodyOfEntity_.resize(entity.index + 1, NoBody);
+        }
+        bodyOfEntity_[entity.index] = body;
+        return body;
+    }
+
+    void PhysicsWorld::destroyBody(uint32_t body)
+    {
+        if (bodyOfEntity_[entities_[body].index] == body) {
+            bodyOfEntity_[entities_[body].index] = NoBody;
+        }
+        resetBody(body);
+        entities_[body] = EntityHandle();
+        freeList_.push_back(body);
+    }
+
+    void PhysicsWorld::resetBody(uint32_t body)
+    {
+        velocityX_[body] = velocityY_[body] = velocityZ_[body] = 0.0f;
+        forceX_[body] = forceY_[body] = forceZ_[body] = 0.0f;
+        displacementX_[body] = displacementY_[body] = displacementZ_[body] = 0.0f;
+        inverseMass_[body] = 0.0f;
+        awake_[body] = 0.0f;
+        stepsAtRest_[body] = 0;
+        setContinuous(body, false);
+    }
+
+    uint32_t PhysicsWorld::getBody(EntityHandle entity) const
+    {
+        if (entity.index >= bodyOfEntity_.size()) {
+            return NoBody;
+        }
+        uint32_t body = bodyOfEntity_[entity.index];
+        return body != NoBody && entities_[body] == entity ? body : NoBody;
+    }
+
+    void PhysicsWorld::setSleepThreshold(float velocity, int steps)
+    {
+        sleepVelocity_ = velocity;
+        sleepSteps_ = steps;
+    }
+
+    void PhysicsWorld::setContinuous(uint32_t body, bool continuous)
+    {
+        if (isContinuous(body) != continuous) {
+            continuousCount_ += continuous ? 1 : -1;
+            continuous_[body] = continuous ? 1 : 0;
+        }
+    }
+
+    void PhysicsWorld::wake(uint32_t body)
+    {
+        if (awake_[body] == 0.0f) {
+            awake_[body] = 1.0f;
+            stepsAtRest_[body] = 0;
+        }
+    }
+
+    void PhysicsWorld::setInverseMass(uint32_t body, float inverseMass)
+    {
+        inverseMass_[body] = inverseMass;
+        wake(body);
+    }
+
+    void PhysicsWorld::setVelocity(uint32_t body, const Vector3 &velocity)
+    {
+        wake(body);
+        velocityX_[body] = velocity.x;
+        velocityY_[body] = velocity.y;
+        velocityZ_[body] = velocity.z;
+    }
+
+    void PhysicsWorld::addVelocity(uint32_t body, const Vector3 &delta)
+    {
+        wake(body);
+        velocityX_[body] += delta.x;
+        velocityY_[body] += delta.y;
+        velocityZ_[body] += delta.z;
+    }
+
+    void PhysicsWorld::addForce(uint32_t body, const Vector3 &force)
+    {
+        wake(body);
+        forceX_[body] += force.x;
+        forceY_[body] += force.y;
+        forceZ_[body] += force.z;
+    }
+
+    void PhysicsWorld::clearForce(uint32_t body)
+    {
+        forceX_[body] = forceY_[body] = forceZ_[body] = 0.0f;
+    }
+
+    void PhysicsWorld::integrate(float dt, ThreadPool *jobs)
+    {
+        integrateVelocities(dt, jobs);
+        integratePositions(dt, jobs);
+    }
+
+    void PhysicsWorld::integrateVelocities(float dt, ThreadPool *jobs)
+    {
+        BodyArrays bodies{velocityX_.data(), velocityY_.data(), velocityZ_.data(), forceX_.data(), forceY_.data(), forceZ_.data(),
+                          inverseMass_.data(), awake_.data(), displacementX_.data(), displacementY_.data(), displacementZ_.data()};
+        bool verlet = integrator_ == IntegratorType::Verlet;
+        auto run = [&](size_t begin, size_t end) {
+            if (verlet) {
+                integrateVelocitiesRange<true>(bodies, begin, end, gravity_, dt);
+            } else {
+                integrateVelocitiesRange<false>(bodies, begin, end, gravity_, dt);
+            }
+        };
+
+        if (jobs) {
+            jobs->parallelFor(0, inverseMass_.size(), IntegrateGrainSize, run);
+        } else {
+            run(0, inverseMass_.size());
+        }
+    }
+
+    void PhysicsWorld::integratePositions(float dt, ThreadPool *jobs)
+    {
+        BodyArrays bodies{velocityX_.data(), velocityY_.data(), velocityZ_.data(), forceX_.data(), forceY_.data(), forceZ_.data(),
+                          inverseMass_.data(), awake_.data(), displacementX_.data(), displacementY_.data(), displacementZ_.data()};
+        float scale = integrator_ == IntegratorType::Verlet ? 0.5f * dt : dt;
+        auto run = [&](size_t begin, size_t end) { integratePositionsRange(bodies, begin, end, scale); };
+
+        if (jobs) {
+            jobs->parallelFor(0, inverseMass_.size(), IntegrateGrainSize, run);
+        } else {
+            run(0, inverseMass_.size());
+        }
+    }
+
+    void PhysicsWorld::sweepContinuous(const CollisionWorld &collisions)
+    {
+        for (uint32_t body = 0; body < entities_.size() && continuousCount_ > 0; ++body) {
+            if (!continuous_[body] || !isAwake(body)) {
+                continue;
+            }
+            const ColliderShape *shape = collisions.findShape(entities_[body]);
+            if (!shape) {
+                continue;
+            }
+
+            // Moving less than the inscribed radius per step, consecutive positions overlap and the
+            // discrete contacts cannot miss anything
+            float radius = shape->type == ShapeType::Sphere
+                               ? shape->radius
+                               : std::min(shape->halfExtents.x, std::min(shape->halfExtents.y, shape->halfExtents.z));
+            Vector3 remaining = getDisplacement(body);
+            if (remaining.dot(remaining) <= radius * radius) {
+                continue;
+            }
+
+            Vector3 center = shape->center;
+            Vector3 moved;
+            Vector3 velocity = getVelocity(body);
+            for (int substep = 0; substep < MaxSweepSubsteps; ++substep) {
+                SweepHit hit;
+                if (!collisions.sweepSphere(center, radius, remaining, entities_[body], hit)) {
+                    moved += remaining;
+                    break;
+                }
+
+                // Stop at the time of impact and drop the motion into the surface
+                Vector3 advance = remaining * hit.fraction;
+                moved += advance;
+                center += advance;
+                remaining = remaining * (1.0f - hit.fraction);
+                float into = remaining.dot(hit.normal);
+                if (into < 0.0f) {
+                    remaining -= hit.normal * into;
+                }
+                float approach = velocity.dot(hit.normal);
+                if (approach < 0.0f) {
+                    velocity -= hit.normal * approach;
+                }
+            }
+
+            displacementX_[body] = moved.x;
+            displacementY_[body] = moved.y;
+            displacementZ_[body] = moved.z;
+            velocityX_[body] = velocity.x;
+            velocityY_[body] = velocity.y;
+            velocityZ_[body] = velocity.z;
+        }
+    }
+
+    void PhysicsWorld::step(World &world, ThreadPool &jobs, float dt, CollisionWorld &collisions)
+    {
+        integrateVelocities(dt, &jobs);
+        solver_.solve(*this, collisions.getManifolds(), dt, &jobs);
+        integratePositions(dt, &jobs);
+        sweepContinuous(collisions);
+
+        // Resting bodies leave their transform alone, so its cached matrix stays valid
+        makeView<TransformComponent, PhysicsComponent>(world).parallelEach(jobs, ApplyGrainSize,
+            [this](TransformComponent &transform, PhysicsComponent &physics) {
+                uint32_t body = physics.getBody();
+                if (displacementX_[body] != 0.0f || displacementY_[body] != 0.0f || displacementZ_[body] != 0.0f) {
+                    transform.translate(getDisplacement(body));
+                }
+            });
+    }
+
+} // namespace ParteeEngine
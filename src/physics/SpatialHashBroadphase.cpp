@@ -0,0 +1,185 @@
+#include "physics/SpatialHashBroadphase.hpp"
+
+#include <algorithm>
+
+namespace ParteeEngine {
+
+    namespace {
+        constexpr size_t ProxyGrainSize = 4096;
+        constexpr size_t BucketGrainSize = 8192;
+        constexpr size_t MinBucketCount = 1024;
+
+        // Clamped so far-away proxies cannot overflow the cell coordinates. Truncation plus
+        // a correction for negatives is much cheaper than std::floor without SSE4.1.
+        int32_t cellCoord(float value, float inverseCellSize)
+        {
+            float cell = std::max(-1.0e9f, std::min(1.0e9f, value * inverseCellSize));
+            int32_t truncated = static_cast<int32_t>(cell);
+            return truncated - (cell < static_cast<float>(truncated) ? 1 : 0);
+        }
+
+        uint32_t hashCell(int32_t x, int32_t y, int32_t z)
+        {
+            return (static_cast<uint32_t>(x) * 73856093u) ^ (static_cast<uint32_t>(y) * 19349663u) ^
+                   (static_cast<uint32_t>(z) * 83492791u);
+        }
+
+        struct CellRange {
+            int32_t minX, minY, minZ;
+            int32_t maxX, maxY, maxZ;
+
+            uint64_t size() const
+            {
+                return static_cast<uint64_t>(maxX - minX + 1) * static_cast<uint64_t>(maxY - minY + 1) *
+                       static_cast<uint64_t>(maxZ - minZ + 1);
+            }
+        };
+
+        CellRange cellRange(const Aabb &bounds, float inverseCellSize)
+        {
+            return CellRange{cellCoord(bounds.min.x, inverseCellSize), cellCoord(bounds.min.y, inverseCellSize),
+                             cellCoord(bounds.min.z, inverseCellSize), cellCoord(bounds.max.x, inverseCellSize),
+                             cellCoord(bounds.max.y, inverseCellSize), cellCoord(bounds.max.z, inverseCellSize)};
+        }
+    }
+
+    void SpatialHashBroadphase::update(const Aabb *bounds, size_t count, ThreadPool *jobs, const uint8_t *resting)
+    {
+        pairs_.clear();
+
+        // Default cell: twice the mean of the proxies' largest dimension, so a typical proxy
+        // touches 1-8 cells and each cell holds few proxies
+        float cellSize = cellSize_;
+        if (cellSize <= 0.0f) {
+            double sum = 0.0;
+            for (size_t i = 0; i < count; ++i) {
+                Vector3 size = bounds[i].max - bounds[i].min;
+                sum += std::max(size.x, std::max(size.y, size.z));
+            }
+            cellSize = count > 0 ? static_cast<float>(2.0 * sum / count) : 1.0f;
+            if (!(cellSize > 0.0f)) {
+                cellSize = 1.0f;
+            }
+        }
+        usedCellSize_ = cellSize;
+        const float inverseCellSize = 1.0f / cellSize;
+
+        // Count the cells of every proxy
+        firstEntry_.resize(count + 1);
+        isOversized_.assign(count, 0);
+        forEachChunk(jobs, count, ProxyGrainSize, [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                uint64_t cells = cellRange(bounds[i], inverseCellSize).size();
+                if (cells > MaxCellsPerProxy) {
+                    isOversized_[i] = 1;
+                    cells = 0;
+                }
+                firstEntry_[i + 1] = static_cast<uint32_t>(cells);
+            }
+        });
+
+        firstEntry_[0] = 0;
+        oversized_.clear();
+        for (size_t i = 0; i < count; ++i) {
+            firstEntry_[i + 1] += firstEntry_[i];
+            if (isOversized_[i]) {
+                oversized_.push_back(static_cast<uint32_t>(i));
+            }
+        }
+
+        size_t entryCount = firstEntry_[count];
+        size_t bucketCount = MinBucketCount;
+        while (bucketCount < entryCount) {
+            bucketCount *= 2;
+        }
+        const uint32_t bucketMask = static_cast<uint32_t>(bucketCount - 1);
+
+        // Enter every proxy in its cells
+        entries_.resize(entryCount);
+        entryBucket_.resize(entryCount);
+        forEachChunk(jobs, count, ProxyGrainSize, [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (isOversized_[i]) {
+                    continue;
+                }
+                CellRange range = cellRange(bounds[i], inverseCellSize);
+                uint32_t k = firstEntry_[i];
+                for (int32_t z = range.minZ; z <= range.maxZ; ++z) {
+                    for (int32_t y = range.minY; y <= range.maxY; ++y) {
+                        for (int32_t x = range.minX; x <= range.maxX; ++x) {
+                            entries_[k] = Entry{x, y, z, static_cast<uint32_t>(i)};
+                            entryBucket_[k] = hashCell(x, y, z) & bucketMask;
+                            k++;
+                        }
+                    }
+                }
+            }
+        });
+
+        // Counting sort by bucket
+        bucketStart_.assign(bucketCount + 1, 0);
+        for (size_t k = 0; k < entryCount; ++k) {
+            bucketStart_[entryBucket_[k] + 1]++;
+        }
+        for (size_t b = 0; b < bucketCount; ++b) {
+            bucketStart_[b + 1] += bucketStart_[b];
+        }
+        bucketCursor_.assign(bucketStart_.begin(), bucketStart_.end() - 1);
+        sorted_.resize(entryCount);
+        for (size_t k = 0; k < entryCount; ++k) {
+            sorted_[bucketCursor_[entryBucket_[k]]++] = entries_[k];
+        }
+
+        // Test the proxies sharing a cell. Different cells can share a bucket, so compare
+        // the coordinates, and let only the cell holding the intersection's minimum report.
+        forEachChunk(jobs, bucketCount, BucketGrainSize, [&](size_t chunk, size_t begin, size_t end) {
+            std::vector<BroadphasePair> &out = chunkPairs_[chunk];
+            for (size_t b = begin; b < end; ++b) {
+                uint32_t bucketEnd = bucketStart_[b + 1];
+                for (uint32_t i = bucketStart_[b]; i + 1 < bucketEnd; ++i) {
+                    const Entry &a = sorted_[i];
+                    const Aabb &boundsA = bounds[a.proxy];
+                    for (uint32_t j = i + 1; j < bucketEnd; ++j) {
+                        const Entry &c = sorted_[j];
+                        if (a.x != c.x || a.y != c.y || a.z != c.z || bothResting(resting, a.proxy, c.proxy)) {
+                            continue;
+                        }
+                        const Aabb &boundsC = bounds[c.proxy];
+                        if (!boundsA.overlaps(boundsC)) {
+                            continue;
+                        }
+                        if (cellCoord(std::max(boundsA.min.x, boundsC.min.x), inverseCellSize) != a.x ||
+                            cellCoord(std::max(boundsA.min.y, boundsC.min.y), inverseCellSize) != a.y ||
+                            cellCoord(std::max(boundsA.min.z, boundsC.min.z), inverseCellSize) != a.z) {
+                            continue;
+                        }
+                        out.push_back(BroadphasePair{std::min(a.proxy, c.proxy), std::max(a.proxy, c.proxy)});
+                    }
+                }
+            }
+        });
+        gatherPairs();
+
+        if (oversized_.empty()) {
+            return;
+        }
+
+        // Oversized proxies against everything; pairs of two oversized proxies once
+        forEachChunk(jobs, count, ProxyGrainSize, [&](size_t chunk, size_t begin, size_t end) {
+            std::vector<BroadphasePair> &out = chunkPairs_[chunk];
+            for (size_t i = begin; i < end; ++i) {
+                uint32_t proxy = static_cast<uint32_t>(i);
+                for (uint32_t other : oversized_) {
+                    if (other == proxy || (isOversized_[proxy] && proxy > other) || bothResting(resting, proxy, other)) {
+                        continue;
+                    }
+                    if (bounds[proxy].overlaps(bounds[other])) {
+                        out.push_back(BroadphasePair{std::min(proxy, other), std::max(proxy, other)});
+                    }
+                }
+            }
+        });
+        gatherPairs();
+    }
+
+} // namespace ParteeEngine
@@ -0,0 +1,178 @@
+#include "physics/SweepAndPruneBroadphase.hpp"
+
+#include <algorithm>
+
+#include "math/Simd.hpp"
+
+namespace ParteeEngine {
+
+    namespace {
+        constexpr size_t SweepGrainSize = 2048;
+
+        // Switch axes only for a clearly better one; every switch costs a full sort
+        constexpr double AxisSwitchRatio = 1.5;
+
+        // Insertion sort moves allowed per proxy before falling back to a full sort
+        constexpr size_t MaxMovesPerProxy = 8;
+
+        float component(const Vector3 &v, int axis)
+        {
+            return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+        }
+    }
+
+    void SweepAndPruneBroadphase::update(const Aabb *bounds, size_t count, ThreadPool *jobs, const uint8_t *resting)
+    {
+        pairs_.clear();
+
+        chooseAxis(bounds, count);
+        sortProxies(bounds, count);
+
+        const int axisA = (axis_ + 1) % 3;
+        const int axisB = (axis_ + 2) % 3;
+        sortedMax_.resize(count);
+        sortedMinA_.resize(count);
+        sortedMaxA_.resize(count);
+        sortedMinB_.resize(count);
+        sortedMaxB_.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            const Aabb &proxyBounds = bounds[order_[i]];
+            sortedMax_[i] = component(proxyBounds.max, axis_);
+            sortedMinA_[i] = component(proxyBounds.min, axisA);
+            sortedMaxA_[i] = component(proxyBounds.max, axisA);
+            sortedMinB_[i] = component(proxyBounds.min, axisB);
+            sortedMaxB_[i] = component(proxyBounds.max, axisB);
+        }
+
+        // Each proxy only looks ahead, so every pair is found once
+        forEachChunk(jobs, count, SweepGrainSize, [&](size_t chunk, size_t begin, size_t end) {
+            std::vector<BroadphasePair> &out = chunkPairs_[chunk];
+            auto report = [&](size_t i, size_t j) {
+                uint32_t first = order_[i], second = order_[j];
+                if (bothResting(resting, first, second)) {
+                    return;
+                }
+                out.push_back(BroadphasePair{std::min(first, second), std::max(first, second)});
+            };
+
+            for (size_t i = begin; i < end; ++i) {
+                const float maxMain = sortedMax_[i];
+                const float minA = sortedMinA_[i], maxA = sortedMaxA_[i];
+                const float minB = sortedMinB_[i], maxB = sortedMaxB_[i];
+
+                size_t j = i + 1;
+#ifdef PARTEE_MATH_SSE
+                const __m128 vMaxMain = _mm_set1_ps(maxMain);
+                const __m128 vMinA = _mm_set1_ps(minA), vMaxA = _mm_set1_ps(maxA);
+                const __m128 vMinB = _mm_set1_ps(minB), vMaxB = _mm_set1_ps(maxB);
+                for (; j + 4 <= count; j += 4) {
+                    __m128 inRange = _mm_cmple_ps(_mm_loadu_ps(&keys_[j]), vMaxMain);
+                    __m128 overlap = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&sortedMinA_[j]), vMaxA),
+                                                _mm_cmpge_ps(_mm_loadu_ps(&sortedMaxA_[j]), vMinA));
+                    overlap = _mm_and_ps(overlap, _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&sortedMinB_[j]), vMaxB),
+                                                             _mm_cmpge_ps(_mm_loadu_ps(&sortedMaxB_[j]), vMinB)));
+                    int hits = _mm_movemask_ps(_mm_and_ps(overlap, inRange));
+                    for (int lane = 0; hits != 0; ++lane, hits >>= 1) {
+                        if (hits & 1) {
+                            report(i, j + lane);
+                        }
+                    }
+                    // Keys are sorted, so the first one out of range ends the sweep
+                    if (_mm_movemask_ps(inRange) != 0xF) {
+                        j = count;
+                        break;
+                    }
+                }
+#endif
+                for (; j < count && keys_[j] <= maxMain; ++j) {
+                    if (sortedMinA_[j] <= maxA && sortedMaxA_[j] >= minA && sortedMinB_[j] <= maxB && sortedMaxB_[j] >= minB) {
+                        report(i, j);
+                    }
+                }
+            }
+        });
+        gatherPairs();
+    }
+
+    void SweepAndPruneBroadphase::chooseAxis(const Aabb *bounds, size_t count)
+    {
+        if (count < 2) {
+            return;
+        }
+
+        double sum[3] = {0.0, 0.0, 0.0};
+        double sumSquares[3] = {0.0, 0.0, 0.0};
+        for (size_t i = 0; i < count; ++i) {
+            Vector3 center = bounds[i].getCenter();
+            const float c[3] = {center.x, center.y, center.z};
+            for (int axis = 0; axis < 3; ++axis) {
+                sum[axis] += c[axis];
+                sumSquares[axis] += static_cast<double>(c[axis]) * c[axis];
+            }
+        }
+
+        double variance[3];
+        int best = 0;
+        for (int axis = 0; axis < 3; ++axis) {
+            variance[axis] = sumSquares[axis] / count - (sum[axis] / count) * (sum[axis] / count);
+            if (variance[axis] > variance[best]) {
+                best = axis;
+            }
+        }
+
+        if (variance[best] > variance[axis_] * AxisSwitchRatio) {
+            axis_ = best;
+            keys_.clear(); // forces a full sort
+        }
+    }
+
+    void SweepAndPruneBroadphase::sortProxies(const Aabb *bounds, size_t count)
+    {
+        // The order is always a permutation of the proxies: drop the ones that disappeared,
+        // append new ones for the insertion sort to move into place
+        bool resort = order_.empty() || keys_.size() != order_.size();
+        if (order_.size() != count) {
+            order_.erase(std::remove_if(order_.begin(), order_.end(), [count](uint32_t proxy) { return proxy >= count; }),
+                         order_.end());
+            for (uint32_t proxy = static_cast<uint32_t>(order_.size()); proxy < count; ++proxy) {
+                order_.push_back(proxy);
+            }
+        }
+
+        keys_.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            keys_[i] = component(bounds[order_[i]].min, axis_);
+        }
+
+        // Insertion sort: nearly free when the order barely changed since the last step
+        if (!resort) {
+            size_t budget = count * MaxMovesPerProxy;
+            for (size_t i = 1; i < count && !resort; ++i) {
+                float key = keys_[i];
+                uint32_t proxy = order_[i];
+                size_t j = i;
+                while (j > 0 && keys_[j - 1] > key) {
+                    keys_[j] = keys_[j - 1];
+                    order_[j] = order_[j - 1];
+                    --j;
+                    if (--budget == 0) {
+                        resort = true;
+                        break;
+                    }
+                }
+                keys_[j] = key;
+                order_[j] = proxy;
+            }
+        }
+
+        if (resort) {
+            std::sort(order_.begin(), order_.end(), [&](uint32_t a, uint32_t b) {
+                return component(bounds[a].min, axis_) < component(bounds[b].min, axis_);
+            });
+            for (size_t i = 0; i < count; ++i) {
+                keys_[i] = component(bounds[order_[i]].min, axis_);
+            }
+        }
+    }
+
+} // namespace ParteeEngine
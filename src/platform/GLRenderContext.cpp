@@ -0,0 +1,237 @@
+#ifdef _WIN32
+
+#include "platform/GLRenderContext.hpp"
+#include "Mesh.hpp"
+#include "math/Matrix4.hpp"
+#include <cmath>
+#include <iostream>
+
+namespace ParteeEngine {
+
+    GLRenderContext::GLRenderContext() {
+    }
+
+    GLRenderContext::~GLRenderContext() {
+        // Cleanup handled by Window class
+    }
+
+    void GLRenderContext::initialize(int width, int height) {
+        viewportWidth = width;
+        viewportHeight = height;
+        aspect = static_cast<float>(width) / static_cast<float>(height);
+
+        // Set up OpenGL state
+        glEnable(GL_DEPTH_TEST);
+        glDepthFunc(GL_LESS);
+        glEnable(GL_CULL_FACE);
+        glCullFace(GL_BACK);
+        glFrontFace(GL_CCW);
+
+        // Clear color
+        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+
+        setViewport(0, 0, width, height);
+        setPerspective(fov, aspect, nearPlane, farPlane);
+        
+        initialized = true;
+        std::cout << "RenderContext initialized: " << width << "x" << height << std::endl;
+    }
+
+    void GLRenderContext::clear() {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        
+        // Reset matrices
+        glMatrixMode(GL_PROJECTION);
+        glLoadIdentity();
+        setupPerspective();
+        
+        glMatrixMode(GL_MODELVIEW);
+        glLoadIdentity();
+        setupCamera();
+    }
+
+    void GLRenderContext::present() {
+        glFlush();
+        // Note: SwapBuffers is handled by Window class
+    }
+
+    void GLRenderContext::pushMatrix() {
+        glPushMatrix();
+    }
+
+    void GLRenderContext::popMatrix() {
+        glPopMatrix();
+    }
+
+    void GLRenderContext::loadIdentity() {
+        glLoadIdentity();
+    }
+
+    void GLRenderContext::translate(const Vector3& position) {
+        glTranslatef(position.x, position.y, position.z);
+    }
+
+    void GLRenderContext::rotate(const Vector3& rotation) {
+        // Apply rotations in order: Y, X, Z (commonly used for Euler angles)
+        glRotatef(rotation.y, 0.0f, 1.0f, 0.0f);  // Yaw
+        glRotatef(rotation.x, 1.0f, 0.0f, 0.0f);  // Pitch
+        glRotatef(rotation.z, 0.0f, 0.0f, 1.0f);  // Roll
+    }
+
+    void GLRenderContext::scale(const Vector3& scale) {
+        glScalef(scale.x, scale.y, scale.z);
+    }
+
+    void GLRenderContext::multMatrix(const Matrix4& matrix) {
+        glMultMatrixf(matrix.m);
+    }
+
+    void GLRenderContext::setColor(float r, float g, float b, float a) {
+        glColor4f(r, g, b, a);
+    }
+
+    void GLRenderContext::drawTriangle(const Vector3& v1, const Vector3& v2, const Vector3& v3) {
+        glBegin(GL_TRIANGLES);
+        glVertex3f(v1.x, v1.y, v1.z);
+        glVertex3f(v2.x, v2.y, v2.z);
+        glVertex3f(v3.x, v3.y, v3.z);
+        glEnd();
+    }
+
+    void GLRenderContext::drawQuad(const Vector3& v1, const Vector3& v2, const Vector3& v3, const Vector3& v4) {
+        glBegin(GL_QUADS);
+        glVertex3f(v1.x, v1.y, v1.z);
+        glVertex3f(v2.x, v2.y, v2.z);
+        glVertex3f(v3.x, v3.y, v3.z);
+        glVertex3f(v4.x, v4.y, v4.z);
+        glEnd();
+    }
+
+    void GLRenderContext::beginTriangles() {
+        glBegin(GL_TRIANGLES);
+    }
+
+    void GLRenderContext::beginQuads() {
+        glBegin(GL_QUADS);
+    }
+
+    void GLRenderContext::end() {
+        glEnd();
+    }
+
+    void GLRenderContext::vertex(const Vector3& v) {
+        glVertex3f(v.x, v.y, v.z);
+    }
+
+    void GLRenderContext::color(float r, float g, float b, float a) {
+        glColor4f(r, g, b, a);
+    }
+
+    void GLRenderContext::drawTriangles(const RenderVertex* vertices, size_t count) {
+        if (count == 0) return;
+
+        // Client-side vertex arrays: one call instead of a glVertex per vertex
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glVertexPointer(3, GL_FLOAT, sizeof(RenderVertex), &vertices->position);
+        glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(RenderVertex), &vertices->color);
+        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(count));
+        glDisableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+    }
+
+    void GLRenderContext::drawInstanced(const Mesh& mesh, const InstanceData* instances, size_t count) {
+        if (count == 0 || mesh.vertices.empty()) return;
+
+        // Fixed-function GL has no instancing: bind the mesh once and only change the matrix per instance
+        const RenderVertex* vertices = mesh.vertices.data();
+        GLsizei vertexCount = static_cast<GLsizei>(mesh.vertices.size());
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glVertexPointer(3, GL_FLOAT, sizeof(RenderVertex), &vertices->position);
+
+        const uint32_t white = 0xFFFFFFFFu;
+        for (size_t i = 0; i < count; ++i) {
+            if (instances[i].color == white) {
+                glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(RenderVertex), &vertices->color);
+            } else {
+                tintedColors.resize(mesh.vertices.size());
+                for (size_t j = 0; j < mesh.vertices.size(); ++j) {
+                    tintedColors[j] = modulateRGBA(vertices[j].color, instances[i].color);
+                }
+                glColorPointer(4, GL_UNSIGNED_BYTE, 0, tintedColors.data());
+            }
+
+            glPushMatrix();
+            glMultMatrixf(instances[i].model.m);
+            if (mesh.indices.empty()) {
+                glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+            } else {
+                glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(mesh.indices.size()), GL_UNSIGNED_INT, mesh.indices.data());
+            }
+            glPopMatrix();
+        }
+
+        glDisableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+    }
+
+    void GLRenderContext::enableDepthTest(bool enable) {
+        if (enable) {
+            glEnable(GL_DEPTH_TEST);
+        } else {
+            glDisable(GL_DEPTH_TEST);
+        }
+    }
+
+    void GLRenderContext::setCullFace(bool enable) {
+        if (enable) {
+            glEnable(GL_CULL_FACE);
+        } else {
+            glDisable(GL_CULL_FACE);
+        }
+    }
+
+    void GLRenderContext::setViewport(int x, int y, int width, int height) {
+        glViewport(x, y, width, height);
+        RenderContext::setViewport(x, y, width, height);
+    }
+
+    void GLRenderContext::setPerspective(float fovDegrees, float aspectRatio, float nearDistance, float farDistance) {
+        RenderContext::setPerspective(fovDegrees, aspectRatio, nearDistance, farDistance);
+        
+        glMatrixMode(GL_PROJECTION);
+        glLoadIdentity();
+        setupPerspective();
+        glMatrixMode(GL_MODELVIEW);
+    }
+
+    void GLRenderContext::setCamera(const Vector3& position, const Vector3& target, const Vector3& up) {
+        RenderContext::setCamera(position, target, up);
+        
+        glMatrixMode(GL_MODELVIEW);
+        glLoadIdentity();
+        setupCamera();
+    }
+
+    void GLRenderContext::setupPerspective() {
+        // Manual perspective projection matrix setup
+        float fovRadians = fov * 3.14159265359f / 180.0f;
+        float f = 1.0f / tan(fovRadians / 2.0f);
+        
+        // Set up perspective matrix manually using glFrustum
+        float ymax = nearPlane * tan(fovRadians / 2.0f);
+        float ymin = -ymax;
+        float xmin = ymin * aspect;
+        float xmax = ymax * aspect;
+        
+        glFrustum(xmin, xmax, ymin, ymax, nearPlane, farPlane);
+    }
+
+    void GLRenderContext::setupCamera() {
+        glMultMatrixf(Matrix4::lookAt(cameraPosition, cameraTarget, cameraUp).m);
+    }
+
+}
+
+#endif // _WIN32
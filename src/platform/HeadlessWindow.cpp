@@ -0,0 +1,15 @@
+#include "platform/HeadlessWindow.hpp"
+
+namespace ParteeEngine
+{
+    void HeadlessWindow::show()
+    {
+        while (!closeRequested)
+        {
+            if (renderCallback)
+            {
+                renderCallback();
+            }
+        }
+    }
+} // namespace ParteeEngine
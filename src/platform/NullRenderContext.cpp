@@ -0,0 +1,11 @@
+#include "platform/NullRenderContext.hpp"
+
+namespace ParteeEngine {
+
+    void NullRenderContext::initialize(int width, int height) {
+        setViewport(0, 0, width, height);
+        setPerspective(fov, aspect, nearPlane, farPlane);
+        initialized = true;
+    }
+
+}
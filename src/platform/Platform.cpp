@@ -0,0 +1,50 @@
+#include "platform/Platform.hpp"
+
+#include <iostream>
+
+#include "platform/HeadlessWindow.hpp"
+#include "platform/NullRenderContext.hpp"
+#include "platform/SoftwareRenderContext.hpp"
+#ifdef _WIN32
+#include "platform/Win32Window.hpp"
+#include "platform/GLRenderContext.hpp"
+#endif
+
+namespace ParteeEngine {
+
+    PlatformBackend resolveBackend(PlatformBackend requested) {
+#ifdef _WIN32
+        return requested;
+#else
+        if (requested == PlatformBackend::Native) {
+            std::cout << "No native window backend on this platform, running headless" << std::endl;
+            return PlatformBackend::Headless;
+        }
+        return requested;
+#endif
+    }
+
+    std::unique_ptr<Window> createWindow(PlatformBackend backend, int width, int height) {
+#ifdef _WIN32
+        if (backend == PlatformBackend::Native) {
+            return std::make_unique<Win32Window>(width, height);
+        }
+#else
+        (void)backend;
+#endif
+        return std::make_unique<HeadlessWindow>(width, height);
+    }
+
+    std::unique_ptr<RenderContext> createRenderContext(PlatformBackend backend, ThreadPool* jobs) {
+#ifdef _WIN32
+        if (backend == PlatformBackend::Native) {
+            return std::make_unique<GLRenderContext>();
+        }
+#endif
+        if (backend == PlatformBackend::Software) {
+            return std::make_unique<SoftwareRenderContext>(jobs);
+        }
+        return std::make_unique<NullRenderContext>();
+    }
+
+}
@@ -0,0 +1,449 @@
+#include "platform/SoftwareRenderContext.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+#include "Mesh.hpp"
+#include "jobs/ThreadPool.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARTEE_RASTER_SSE2 1
+#endif
+
+namespace ParteeEngine {
+
+    namespace {
+        // Float to int conversion that stays defined for coordinates far off screen
+        int clampToInt(float v, int lo, int hi) {
+            return static_cast<int>(std::min(std::max(v, static_cast<float>(lo)), static_cast<float>(hi)));
+        }
+
+        // Signed parallelogram area of (a, b, p); positive when p is left of a->b in y-down screen space.
+        float edge(float ax, float ay, float bx, float by, float px, float py) {
+            return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+        }
+    }
+
+    SoftwareRenderContext::SoftwareRenderContext(ThreadPool* jobs)
+        : jobs(jobs), mvpDirty(true), currentColor(0xFFFFFFFFu), depthTest(true), cullFace(true),
+          primitive(Primitive::None), tilesX(0), tilesY(0), stride(0), paddedHeight(0), presentedTriangles(0),
+          clearColor(packRGBA(0.2f, 0.3f, 0.3f, 1.0f)) {
+        matrixStack.push_back(Matrix4::identity());
+        rebuildProjection();
+        rebuildView();
+    }
+
+    void SoftwareRenderContext::initialize(int width, int height) {
+        setViewport(0, 0, width, height);
+        setPerspective(fov, aspect, nearPlane, farPlane);
+
+        initialized = true;
+        std::cout << "SoftwareRenderContext initialized: " << width << "x" << height << std::endl;
+    }
+
+    void SoftwareRenderContext::resizeTargets() {
+        tilesX = (viewportWidth + TileSize - 1) / TileSize;
+        tilesY = (viewportHeight + TileSize - 1) / TileSize;
+
+        // Pad to whole tiles so 4-wide SIMD spans never run past the end of a row
+        stride = tilesX * TileSize;
+        paddedHeight = tilesY * TileSize;
+
+        colorBuffer.assign(static_cast<size_t>(stride) * paddedHeight, clearColor);
+        depthBuffer.assign(static_cast<size_t>(stride) * paddedHeight, 1.0f);
+        bins.assign(static_cast<size_t>(tilesX) * tilesY, {});
+    }
+
+    void SoftwareRenderContext::clear() {
+        std::fill(colorBuffer.begin(), colorBuffer.end(), clearColor);
+        std::fill(depthBuffer.begin(), depthBuffer.end(), 1.0f);
+        triangles.clear();
+
+        // Reset matrices
+        matrixStack.assign(1, view);
+        mvpDirty = true;
+    }
+
+    void SoftwareRenderContext::present() {
+        // Bin every triangle into the tiles its screen bounds touch
+        for (auto& bin : bins) {
+            bin.clear();
+        }
+        for (uint32_t i = 0; i < triangles.size(); ++i) {
+            const ScreenTriangle& tri = triangles[i];
+            float minX = std::min({tri.x[0], tri.x[1], tri.x[2]});
+            float maxX = std::max({tri.x[0], tri.x[1], tri.x[2]});
+            float minY = std::min({tri.y[0], tri.y[1], tri.y[2]});
+            float maxY = std::max({tri.y[0], tri.y[1], tri.y[2]});
+
+            int tx0 = clampToInt(minX, 0, viewportWidth - 1) / TileSize;
+            int tx1 = clampToInt(maxX, 0, viewportWidth - 1) / TileSize;
+            int ty0 = clampToInt(minY, 0, viewportHeight - 1) / TileSize;
+            int ty1 = clampToInt(maxY, 0, viewportHeight - 1) / TileSize;
+            for (int ty = ty0; ty <= ty1; ++ty) {
+                for (int tx = tx0; tx <= tx1; ++tx) {
+                    bins[ty * tilesX + tx].push_back(i);
+                }
+            }
+        }
+
+        // Tiles own disjoint pixels, so they can be rasterized independently
+        size_t tileCount = bins.size();
+        if (jobs) {
+            jobs->parallelFor(0, tileCount, 1, [this](size_t begin, size_t end) {
+                for (size_t tile = begin; tile < end; ++tile) {
+                    rasterizeTile(static_cast<int>(tile));
+                }
+            });
+        } else {
+            for (size_t tile = 0; tile < tileCount; ++tile) {
+                rasterizeTile(static_cast<int>(tile));
+            }
+        }
+
+        presentedTriangles = triangles.size();
+        triangles.clear();
+    }
+
+    void SoftwareRenderContext::rasterizeTile(int tileIndex) {
+        const std::vector<uint32_t>& bin = bins[tileIndex];
+        if (bin.empty()) {
+            return;
+        }
+
+        const int tileX0 = (tileIndex % tilesX) * TileSize;
+        const int tileY0 = (tileIndex / tilesX) * TileSize;
+        const int tileX1 = std::min(tileX0 + TileSize, viewportWidth) - 1;
+        const int tileY1 = std::min(tileY0 + TileSize, viewportHeight) - 1;
+
+        for (uint32_t index : bin) {
+            const ScreenTriangle& tri = triangles[index];
+
+            int minX = clampToInt(std::floor(std::min({tri.x[0], tri.x[1], tri.x[2]})), tileX0, tileX1 + 1);
+            int maxX = clampToInt(std::ceil(std::max({tri.x[0], tri.x[1], tri.x[2]})), tileX0 - 1, tileX1);
+            int minY = clampToInt(std::floor(std::min({tri.y[0], tri.y[1], tri.y[2]})), tileY0, tileY1 + 1);
+            int maxY = clampToInt(std::ceil(std::max({tri.y[0], tri.y[1], tri.y[2]})), tileY0 - 1, tileY1);
+            if (minX > maxX || minY > maxY) {
+                continue;
+            }
+            minX &= ~3; // start spans on a 4-pixel boundary
+
+            // Edge functions w_i = A_i * x + B_i * y + C_i, opposite vertex i
+            float A[3], B[3], C[3];
+            for (int e = 0; e < 3; ++e) {
+                int a = (e + 1) % 3;
+                int b = (e + 2) % 3;
+                A[e] = tri.y[a] - tri.y[b];
+                B[e] = tri.x[b] - tri.x[a];
+                C[e] = -(A[e] * tri.x[a] + B[e] * tri.y[a]);
+            }
+
+            // Depth is affine in screen space: z = z0 + w1 * dz1 + w2 * dz2
+            float area = A[0] * tri.x[0] + B[0] * tri.y[0] + C[0];
+            float dz1 = (tri.z[1] - tri.z[0]) / area;
+            float dz2 = (tri.z[2] - tri.z[0]) / area;
+            float Az = A[1] * dz1 + A[2] * dz2;
+            float Bz = B[1] * dz1 + B[2] * dz2;
+            float Cz = tri.z[0] + C[1] * dz1 + C[2] * dz2;
+
+            for (int y = minY; y <= maxY; ++y) {
+                float py = y + 0.5f;
+                uint32_t* colorRow = &colorBuffer[static_cast<size_t>(y) * stride];
+                float* depthRow = &depthBuffer[static_cast<size_t>(y) * stride];
+
+#ifdef PARTEE_RASTER_SSE2
+                const __m128 laneOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+                const __m128 zero = _mm_setzero_ps();
+                const __m128 rowW0 = _mm_set1_ps(B[0] * py + C[0]);
+                const __m128 rowW1 = _mm_set1_ps(B[1] * py + C[1]);
+                const __m128 rowW2 = _mm_set1_ps(B[2] * py + C[2]);
+                const __m128 rowZ = _mm_set1_ps(Bz * py + Cz);
+                const __m128i color = _mm_set1_epi32(static_cast<int>(tri.color));
+
+                for (int x = minX; x <= maxX; x += 4) {
+                    __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffsets);
+                    __m128 w0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(A[0]), px), rowW0);
+                    __m128 w1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(A[1]), px), rowW1);
+                    __m128 w2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(A[2]), px), rowW2);
+
+                    __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(w0, zero), _mm_cmpge_ps(w1, zero)), _mm_cmpge_ps(w2, zero));
+                    if (_mm_movemask_ps(inside) == 0) {
+                        continue;
+                    }
+
+                    __m128 z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(Az), px), rowZ);
+                    __m128 depth = _mm_loadu_ps(depthRow + x);
+                    if (depthTest) {
+                        inside = _mm_and_ps(inside, _mm_cmplt_ps(z, depth));
+                        if (_mm_movemask_ps(inside) == 0) {
+                            continue;
+                        }
+                    }
+
+                    _mm_storeu_ps(depthRow + x, _mm_or_ps(_mm_and_ps(inside, z), _mm_andnot_ps(inside, depth)));
+
+                    __m128i mask = _mm_castps_si128(inside);
+                    __m128i dst = _mm_loadu_si128(reinterpret_cast<__m128i*>(colorRow + x));
+                    dst = _mm_or_si128(_mm_and_si128(mask, color), _mm_andnot_si128(mask, dst));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(colorRow + x), dst);
+                }
+#else
+                for (int x = minX; x <= maxX; ++x) {
+                    float px = x + 0.5f;
+                    float w0 = A[0] * px + B[0] * py + C[0];
+                    float w1 = A[1] * px + B[1] * py + C[1];
+                    float w2 = A[2] * px + B[2] * py + C[2];
+                    if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) {
+                        continue;
+                    }
+
+                    float z = Az * px + Bz * py + Cz;
+                    if (depthTest && !(z < depthRow[x])) {
+                        continue;
+                    }
+                    depthRow[x] = z;
+                    colorRow[x] = tri.color;
+                }
+#endif
+            }
+        }
+    }
+
+    void SoftwareRenderContext::pushMatrix() {
+        matrixStack.push_back(matrixStack.back());
+    }
+
+    void SoftwareRenderContext::popMatrix() {
+        if (matrixStack.size() > 1) {
+            matrixStack.pop_back();
+            mvpDirty = true;
+        }
+    }
+
+    void SoftwareRenderContext::loadIdentity() {
+        matrixStack.back() = Matrix4::identity();
+        mvpDirty = true;
+    }
+
+    void SoftwareRenderContext::translate(const Vector3& position) {
+        matrixStack.back() = matrixStack.back() * Matrix4::translation(position);
+        mvpDirty = true;
+    }
+
+    void SoftwareRenderContext::rotate(const Vector3& rotation) {
+        // Same order as the GL backend: Y, X, Z
+        matrixStack.back() = matrixStack.back() * Matrix4::rotation(rotation);
+        mvpDirty = true;
+    }
+
+    void SoftwareRenderContext::scale(const Vector3& scale) {
+        matrixStack.back() = matrixStack.back() * Matrix4::scale(scale);
+        mvpDirty = true;
+    }
+
+    void SoftwareRenderContext::multMatrix(const Matrix4& matrix) {
+        matrixStack.back() = matrixStack.back() * matrix;
+        mvpDirty = true;
+    }
+
+    void SoftwareRenderContext::setColor(float r, float g, float b, float a) {
+        currentColor = packRGBA(r, g, b, a);
+    }
+
+    void SoftwareRenderContext::color(float r, float g, float b, float a) {
+        currentColor = packRGBA(r, g, b, a);
+    }
+
+    void SoftwareRenderContext::drawTriangle(const Vector3& v1, const Vector3& v2, const Vector3& v3) {
+        submitTriangle(v1, v2, v3);
+    }
+
+    void SoftwareRenderContext::drawQuad(const Vector3& v1, const Vector3& v2, const Vector3& v3, const Vector3& v4) {
+        submitTriangle(v1, v2, v3);
+        submitTriangle(v1, v3, v4);
+    }
+
+    void SoftwareRenderContext::drawTriangles(const RenderVertex* vertices, size_t count) {
+        // Flat shading: each triangle takes the color of its first vertex
+        uint32_t savedColor = currentColor;
+        for (size_t i = 0; i + 2 < count; i += 3) {
+            currentColor = vertices[i].color;
+            submitTriangle(vertices[i].position, vertices[i + 1].position, vertices[i + 2].position);
+        }
+        currentColor = savedColor;
+    }
+
+    void SoftwareRenderContext::drawInstanced(const Mesh& mesh, const InstanceData* instances, size_t count) {
+        uint32_t savedColor = currentColor;
+        Matrix4 parent = matrixStack.back();
+        for (size_t i = 0; i < count; ++i) {
+            // One matrix product per instance; the mesh goes straight to clip space
+            matrixStack.back() = parent * instances[i].model;
+            mvpDirty = true;
+
+            for (size_t j = 0; j + 2 < mesh.getCornerCount(); j += 3) {
+                const RenderVertex& a = mesh.getCorner(j);
+                currentColor = modulateRGBA(a.color, instances[i].color);
+                submitTriangle(a.position, mesh.getCorner(j + 1).position, mesh.getCorner(j + 2).position);
+            }
+        }
+        matrixStack.back() = parent;
+        mvpDirty = true;
+        currentColor = savedColor;
+    }
+
+    void SoftwareRenderContext::beginTriangles() {
+        primitive = Primitive::Triangles;
+        pending.clear();
+    }
+
+    void SoftwareRenderContext::beginQuads() {
+        primitive = Primitive::Quads;
+        pending.clear();
+    }
+
+    void SoftwareRenderContext::vertex(const Vector3& v) {
+        pending.push_back(v);
+
+        // Emit as soon as a primitive is complete so per-face colors apply
+        if (primitive == Primitive::Triangles && pending.size() == 3) {
+            submitTriangle(pending[0], pending[1], pending[2]);
+            pending.clear();
+        } else if (primitive == Primitive::Quads && pending.size() == 4) {
+            submitTriangle(pending[0], pending[1], pending[2]);
+            submitTriangle(pending[0], pending[2], pending[3]);
+            pending.clear();
+        }
+    }
+
+    void SoftwareRenderContext::end() {
+        primitive = Primitive::None;
+        pending.clear();
+    }
+
+    void SoftwareRenderContext::setViewport(int x, int y, int width, int height) {
+        RenderContext::setViewport(x, y, width, height);
+        resizeTargets();
+    }
+
+    void SoftwareRenderContext::setPerspective(float fovDegrees, float aspectRatio, float nearDistance, float farDistance) {
+        RenderContext::setPerspective(fovDegrees, aspectRatio, nearDistance, farDistance);
+        rebuildProjection();
+    }
+
+    void SoftwareRenderContext::setCamera(const Vector3& position, const Vector3& target, const Vector3& up) {
+        RenderContext::setCamera(position, target, up);
+        rebuildView();
+        matrixStack.assign(1, view);
+    }
+
+    void SoftwareRenderContext::rebuildProjection() {
+        // Equivalent of glFrustum as set up by the GL backend
+        projection = Matrix4::perspective(fov, aspect, nearPlane, farPlane);
+        mvpDirty = true;
+    }
+
+    void SoftwareRenderContext::rebuildView() {
+        view = Matrix4::lookAt(cameraPosition, cameraTarget, cameraUp);
+        mvpDirty = true;
+    }
+
+    void SoftwareRenderContext::submitTriangle(const Vector3& v1, const Vector3& v2, const Vector3& v3) {
+        if (mvpDirty) {
+            modelViewProjection = projection * matrixStack.back();
+            mvpDirty = false;
+        }
+
+        // Transform to clip space
+        const float* m = modelViewProjection.m;
+        float clip[3][4];
+        const Vector3* in[3] = {&v1, &v2, &v3};
+        for (int i = 0; i < 3; ++i) {
+            const Vector3& v = *in[i];
+            for (int r = 0; r < 4; ++r) {
+                clip[i][r] = m[r] * v.x + m[4 + r] * v.y + m[8 + r] * v.z + m[12 + r];
+            }
+        }
+
+        // Clip against the near plane (z >= -w); a triangle becomes at most a quad
+        float poly[4][4];
+        int count = 0;
+        for (int i = 0; i < 3; ++i) {
+            const float* a = clip[i];
+            const float* b = clip[(i + 1) % 3];
+            float da = a[2] + a[3];
+            float db = b[2] + b[3];
+            if (da >= 0.0f) {
+                std::copy(a, a + 4, poly[count++]);
+            }
+            if ((da >= 0.0f) != (db >= 0.0f)) {
+                float t = da / (da - db);
+                for (int r = 0; r < 4; ++r) {
+                    poly[count][r] = a[r] + (b[r] - a[r]) * t;
+                }
+                count++;
+            }
+        }
+
+        for (int i = 1; i + 1 < count; ++i) {
+            setupTriangle(poly[0], poly[i], poly[i + 1]);
+        }
+    }
+
+    void SoftwareRenderContext::setupTriangle(const float* a, const float* b, const float* c) {
+        ScreenTriangle tri;
+        const float* in[3] = {a, b, c};
+        for (int i = 0; i < 3; ++i) {
+            float invW = 1.0f / in[i][3];
+            tri.x[i] = (in[i][0] * invW * 0.5f + 0.5f) * viewportWidth;
+            tri.y[i] = (0.5f - in[i][1] * invW * 0.5f) * viewportHeight;
+            tri.z[i] = in[i][2] * invW * 0.5f + 0.5f;
+        }
+
+        // Counter-clockwise (front-facing) triangles have negative area once y points down
+        float area = edge(tri.x[0], tri.y[0], tri.x[1], tri.y[1], tri.x[2], tri.y[2]);
+        if (std::fabs(area) < 1e-8f || (cullFace && area > 0.0f)) {
+            return;
+        }
+        if (area < 0.0f) {
+            std::swap(tri.x[1], tri.x[2]);
+            std::swap(tri.y[1], tri.y[2]);
+            std::swap(tri.z[1], tri.z[2]);
+        }
+
+        // Trivially reject triangles entirely off screen
+        if (std::max({tri.x[0], tri.x[1], tri.x[2]}) < 0.0f || std::min({tri.x[0], tri.x[1], tri.x[2]}) >= viewportWidth ||
+            std::max({tri.y[0], tri.y[1], tri.y[2]}) < 0.0f || std::min({tri.y[0], tri.y[1], tri.y[2]}) >= viewportHeight) {
+            return;
+        }
+
+        tri.color = currentColor;
+        triangles.push_back(tri);
+    }
+
+    bool SoftwareRenderContext::savePPM(const std::string& path) const {
+        FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file) {
+            return false;
+        }
+
+        std::fprintf(file, "P6\n%d %d\n255\n", viewportWidth, viewportHeight);
+        std::vector<unsigned char> row(static_cast<size_t>(viewportWidth) * 3);
+        for (int y = 0; y < viewportHeight; ++y) {
+            for (int x = 0; x < viewportWidth; ++x) {
+                uint32_t pixel = colorBuffer[static_cast<size_t>(y) * stride + x];
+                row[x * 3 + 0] = static_cast<unsigned char>(pixel & 0xFF);
+                row[x * 3 + 1] = static_cast<unsigned char>((pixel >> 8) & 0xFF);
+                row[x * 3 + 2] = static_cast<unsigned char>((pixel >> 16) & 0xFF);
+            }
+            std::fwrite(row.data(), 1, row.size(), file);
+        }
+
+        std::fclose(file);
+        return true;
+    }
+
+}
@@ -1,13 +1,15 @@
-#include "Window.hpp"
+#ifdef _WIN32
+
+#include "platform/Win32Window.hpp"
 
 namespace ParteeEngine
 {
-    Window::Window(const int width, const int height) : width(width), height(height)
+    Win32Window::Win32Window(const int width, const int height) : Window(width, height)
     {
         createWindow();
     };
 
-    Window::~Window() {
+    Win32Window::~Win32Window() {
         // Clean up OpenGL context
         if (hglrc) {
             wglMakeCurrent(NULL, NULL);
@@ -25,12 +27,10 @@ namespace ParteeEngine
         }
     }
 
-    int Window::getHeight() const { return height; }
-    int Window::getWidth() const { return width; }
-    HWND Window::getHWND() const { return hwnd; }
-    HDC Window::getHDC() const { return hdc; }
+    HWND Win32Window::getHWND() const { return hwnd; }
+    HDC Win32Window::getHDC() const { return hdc; }
 
-    void Window::show() {
+    void Win32Window::show() {
         ShowWindow(hwnd, SW_SHOW);
 
         MSG msg = {};
@@ -57,12 +57,12 @@ namespace ParteeEngine
         }
     }
 
-    void Window::setRenderCallback(RenderCallback callback)
+    void Win32Window::requestClose()
     {
-        renderCallback = callback;
+        PostMessage(hwnd, WM_CLOSE, 0, 0);
     }
 
-    void Window::createWindow() {
+    void Win32Window::createWindow() {
         const wchar_t CLASS_NAME[] = L"Partee Window Class";
 
         WNDCLASSW wc = {};
@@ -93,7 +93,7 @@ namespace ParteeEngine
         setupOpenGL();
     }
 
-    void Window::setupOpenGL() {
+    void Win32Window::setupOpenGL() {
         // Set up pixel format for OpenGL
         PIXELFORMATDESCRIPTOR pfd = {};
         pfd.nSize = sizeof(PIXELFORMATDESCRIPTOR);
@@ -138,19 +138,19 @@ namespace ParteeEngine
         glClearColor(0.0f, 0.1f, 0.2f, 1.0f);
     }
 
-    LRESULT CALLBACK Window::WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
+    LRESULT CALLBACK Win32Window::WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
     {
-        Window* pThis = nullptr;
+        Win32Window* pThis = nullptr;
 
         if (uMsg == WM_NCCREATE)
         {
             CREATESTRUCT* pCreate = (CREATESTRUCT*)lParam;
-            pThis = (Window*)pCreate->lpCreateParams;
+            pThis = (Win32Window*)pCreate->lpCreateParams;
             SetWindowLongPtr(hwnd, GWLP_USERDATA, (LONG_PTR)pThis);
         }
         else
         {
-            pThis = (Window*)GetWindowLongPtr(hwnd, GWLP_USERDATA);
+            pThis = (Win32Window*)GetWindowLongPtr(hwnd, GWLP_USERDATA);
         }
 
         if (pThis)
@@ -183,7 +183,9 @@ namespace ParteeEngine
         return DefWindowProc(hwnd, uMsg, wParam, lParam);
     }
 
-    void Window::swapBuffers() {
+    void Win32Window::swapBuffers() {
         SwapBuffers(hdc);
     }
 } // namespace ParteeEngine
+
+#endif // _WIN32